@@ -0,0 +1,128 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <utility>
+
+//Linear (bump) allocator, memory is carved out of large blocks and released all at once with Reset
+class ARENA
+{
+	private:
+		//Block structure
+		struct BLOCK
+		{
+			BLOCK *next;
+			size_t size;
+			alignas(alignof(max_align_t)) uint8_t data[1];
+		};
+		
+		//Block list and current position
+		BLOCK *blockList = nullptr;
+		BLOCK *block = nullptr;
+		size_t used = 0;
+		
+		//Size of newly allocated blocks
+		size_t blockSize;
+	
+	public:
+		//Constructor and destructor
+		ARENA(size_t setBlockSize) : blockSize(setBlockSize) { return; }
+		~ARENA()
+		{
+			//Free all of our blocks
+			while (blockList != nullptr)
+			{
+				BLOCK *next = blockList->next;
+				free(blockList);
+				blockList = next;
+			}
+		}
+		
+		//Allocation functions
+		inline void *Alloc(size_t size, size_t align = alignof(max_align_t))
+		{
+			//Try to fit in the current block
+			if (block != nullptr)
+			{
+				size_t start = upperAlign(used, align);
+				if (start + size <= block->size)
+				{
+					used = start + size;
+					return block->data + start;
+				}
+			}
+			
+			//Move onto the next block that fits (blocks are kept between resets), or link a new one after the current
+			BLOCK *next = (block != nullptr) ? block->next : blockList;
+			if (next == nullptr || next->size < size)
+			{
+				size_t newSize = (size > blockSize) ? size : blockSize;
+				BLOCK *newBlock = (BLOCK*)malloc(offsetof(BLOCK, data) + newSize);
+				if (newBlock == nullptr)
+					return nullptr;
+				newBlock->size = newSize;
+				newBlock->next = next;
+				
+				if (block != nullptr)
+					block->next = newBlock;
+				else
+					blockList = newBlock;
+				next = newBlock;
+			}
+			
+			//Allocate from the start of this block
+			block = next;
+			used = size;
+			return block->data;
+		}
+		
+		template <typename T> inline T *Alloc(size_t num)
+		{
+			return (T*)Alloc(sizeof(T) * num, alignof(T));
+		}
+		
+		inline void *Extend(void *ptr, size_t oldSize, size_t newSize, size_t align = alignof(max_align_t))
+		{
+			//Grow in place if this was the last allocation and it still fits in the block
+			if (ptr != nullptr && block != nullptr && (uint8_t*)ptr + oldSize == block->data + used && ((uint8_t*)ptr - block->data) + newSize <= block->size)
+			{
+				used = ((uint8_t*)ptr - block->data) + newSize;
+				return ptr;
+			}
+			
+			//Otherwise move to a new allocation
+			void *newPtr = Alloc(newSize, align);
+			if (newPtr != nullptr && ptr != nullptr)
+				memcpy(newPtr, ptr, oldSize);
+			return newPtr;
+		}
+		
+		//Release everything allocated, keeping our blocks around for reuse
+		inline void Reset()
+		{
+			block = nullptr;
+			used = 0;
+		}
+		
+		//Swap blocks with another arena (handing everything allocated from one arena over to the other)
+		inline void Swap(ARENA &other)
+		{
+			std::swap(blockList, other.blockList);
+			std::swap(block, other.block);
+			std::swap(used, other.used);
+			std::swap(blockSize, other.blockSize);
+		}
+		
+		//Get how many bytes our blocks take up
+		inline size_t Footprint()
+		{
+			size_t footprint = 0;
+			for (BLOCK *check = blockList; check != nullptr; check = check->next)
+				footprint += offsetof(BLOCK, data) + check->size;
+			return footprint;
+		}
+	
+	private:
+		static inline size_t upperAlign(size_t value, size_t align) { return (value + align - 1) & ~(align - 1); }
+};
@@ -0,0 +1,153 @@
+#pragma once
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+
+//Contiguous dynamic array, with the same interface as LINKEDLIST but constant-time indexing
+//Entries are moved around with memmove, so only trivially copyable types (pointers and plain structures) can be stored
+//Pointers and iterators into the array are invalidated by linking, so iterate by index if the array may grow during iteration
+template <typename T> class ARRAY
+{
+	static_assert(std::is_trivially_copyable<T>::value, "ARRAY entries must be trivially copyable");
+	
+	public:
+		T *entry = nullptr;
+		size_t arSize = 0;
+		size_t arCapacity = 0;
+	
+	public:
+		//Constructor and destructor
+		ARRAY() { return; }
+		~ARRAY() { free(entry); }
+		
+		ARRAY(const ARRAY&) = delete;
+		ARRAY &operator=(const ARRAY&) = delete;
+		
+		//Capacity
+		inline bool reserve(size_t capacity)
+		{
+			//Don't shrink
+			if (capacity <= arCapacity)
+				return false;
+			
+			//Reallocate our entries
+			T *newEntry = (T*)realloc(entry, capacity * sizeof(T));
+			if (newEntry == nullptr)
+				return true;
+			
+			entry = newEntry;
+			arCapacity = capacity;
+			return false;
+		}
+		
+		inline bool grow()
+		{
+			//Double our capacity when full
+			if (arSize < arCapacity)
+				return false;
+			return reserve((arCapacity != 0) ? (arCapacity * 2) : 0x10);
+		}
+		
+		//Linking functions
+		inline T *link_back(T push)
+		{
+			//Append to the end of the array
+			if (grow())
+				return nullptr;
+			entry[arSize] = push;
+			return &entry[arSize++];
+		}
+		
+		inline T *link_front(T push)
+		{
+			return insert(0, push);
+		}
+		
+		inline T *insert(size_t index, T push)
+		{
+			//Link to the back if inserting at the end
+			if (index >= arSize)
+				return link_back(push);
+			
+			//Move the following entries up and insert at the given index
+			if (grow())
+				return nullptr;
+			memmove(&entry[index + 1], &entry[index], (arSize - index) * sizeof(T));
+			entry[index] = push;
+			arSize++;
+			return &entry[index];
+		}
+		
+		//Position identification
+		inline size_t pos_of_val(T want)
+		{
+			for (size_t i = 0; i < arSize; i++)
+				if (entry[i] == want)
+					return i;
+			return -1;
+		}
+		
+		//Random access and size
+		inline T &at(size_t index) { return entry[index]; }
+		inline T &back() { return entry[arSize - 1]; }
+		inline size_t size() { return arSize; }
+		
+		//Erasers
+		inline void erase(size_t index)
+		{
+			erase(index, index + 1);
+		}
+		
+		inline void erase(size_t from, size_t to)
+		{
+			//Move the following entries down over the erased range
+			if (to > arSize)
+				to = arSize;
+			if (from >= to)
+				return;
+			memmove(&entry[from], &entry[to], (arSize - to) * sizeof(T));
+			arSize -= to - from;
+		}
+		
+		inline void pop_back()
+		{
+			if (arSize != 0)
+				arSize--;
+		}
+		
+		inline void resize(size_t size)
+		{
+			//Only used for shrinking (after compacting the array in-place)
+			if (size < arSize)
+				arSize = size;
+		}
+		
+		inline void clear()
+		{
+			//Keep our memory for when we're refilled
+			arSize = 0;
+		}
+		
+		inline void swap(ARRAY &other)
+		{
+			//Exchange our entries with another array's (without copying them)
+			T *swapEntry = entry; entry = other.entry; other.entry = swapEntry;
+			size_t swapSize = arSize; arSize = other.arSize; other.arSize = swapSize;
+			size_t swapCapacity = arCapacity; arCapacity = other.arCapacity; other.arCapacity = swapCapacity;
+		}
+		
+		//Iteration
+		inline T *begin() { return entry; }
+		inline T *end() { return entry + arSize; }
+		
+		//Access operator
+		T &operator[](size_t index) { return entry[index]; };
+};
+
+#define CLEAR_INSTANCE_ARRAY(array)	while (array.size())	\
+									{	\
+										auto instance = array.back();	\
+										array.pop_back();	\
+										delete instance;	\
+									}
@@ -0,0 +1,71 @@
+#include "AssetCache.h"
+
+//Process-wide asset caches
+ASSETCACHE<TEXTURE> gTextureCache;
+ASSETCACHE<MAPPINGS> gMappingsCache;
+
+//Asset ID paths
+const char *gTexturePath[TEXTUREID_MAX] = {
+	/*TEXTUREID_EHZGENERIC*/ "data/Object/EHZGeneric.bmp",
+	/*TEXTUREID_GENERIC*/ "data/Object/Generic.bmp",
+	/*TEXTUREID_GENERICFONT*/ "data/GenericFont.bmp",
+	/*TEXTUREID_GHZGENERIC*/ "data/Object/GHZGeneric.bmp",
+	/*TEXTUREID_HUD*/ "data/HUD.bmp",
+	/*TEXTUREID_MINECART*/ "data/Object/Minecart.bmp",
+	/*TEXTUREID_PLAYERGENERIC*/ "data/Object/PlayerGeneric.bmp",
+	/*TEXTUREID_SONIC1BADNIK*/ "data/Object/Sonic1Badnik.bmp",
+	/*TEXTUREID_TITLECARD*/ "data/TitleCard.bmp",
+};
+
+const char *gMappingsPath[MAPPINGSID_MAX] = {
+	/*MAPPINGSID_AQUABARRIER*/ "data/Object/AquaBarrier.map",
+	/*MAPPINGSID_BLUEBARRIER*/ "data/Object/BlueBarrier.map",
+	/*MAPPINGSID_BUZZBOMBER*/ "data/Object/BuzzBomber.map",
+	/*MAPPINGSID_CHOPPER*/ "data/Object/Chopper.map",
+	/*MAPPINGSID_CRABMEAT*/ "data/Object/Crabmeat.map",
+	/*MAPPINGSID_DOUBLESPINATTACK*/ "data/Object/DoubleSpinAttack.map",
+	/*MAPPINGSID_DROPDASHDUST*/ "data/Object/DropdashDust.map",
+	/*MAPPINGSID_EHZBRIDGE*/ "data/Object/EHZBridge.map",
+	/*MAPPINGSID_FLAMEBARRIER*/ "data/Object/FlameBarrier.map",
+	/*MAPPINGSID_GHZBRIDGE*/ "data/Object/GHZBridge.map",
+	/*MAPPINGSID_GHZEDGEWALL*/ "data/Object/GHZEdgeWall.map",
+	/*MAPPINGSID_GHZLEDGE*/ "data/Object/GHZLedge.map",
+	/*MAPPINGSID_GHZPLATFORM*/ "data/Object/GHZPlatform.map",
+	/*MAPPINGSID_GHZPURPLEROCK*/ "data/Object/GHZPurpleRock.map",
+	/*MAPPINGSID_GHZSMASHABLEWALL*/ "data/Object/GHZSmashableWall.map",
+	/*MAPPINGSID_GHZSPIKELOG*/ "data/Object/GHZSpikeLog.map",
+	/*MAPPINGSID_GHZSPIKES*/ "data/Object/GHZSpikes.map",
+	/*MAPPINGSID_GHZSWINGINGPLATFORM*/ "data/Object/GHZSwingingPlatform.map",
+	/*MAPPINGSID_GOALPOST*/ "data/Object/Goalpost.map",
+	/*MAPPINGSID_INVINCIBILITYSTARS*/ "data/Object/InvincibilityStars.map",
+	/*MAPPINGSID_LIGHTNINGBARRIER*/ "data/Object/LightningBarrier.map",
+	/*MAPPINGSID_MINECART*/ "data/Object/Minecart.map",
+	/*MAPPINGSID_MISSILE*/ "data/Object/Missile.map",
+	/*MAPPINGSID_MONITOR*/ "data/Object/Monitor.map",
+	/*MAPPINGSID_MONITORCONTENTS*/ "data/Object/MonitorContents.map",
+	/*MAPPINGSID_MOTOBUG*/ "data/Object/Motobug.map",
+	/*MAPPINGSID_NEWTRONBLUE*/ "data/Object/NewtronBlue.map",
+	/*MAPPINGSID_NEWTRONGREEN*/ "data/Object/NewtronGreen.map",
+	/*MAPPINGSID_REDSPRING*/ "data/Object/RedSpring.map",
+	/*MAPPINGSID_RING*/ "data/Object/Ring.map",
+	/*MAPPINGSID_SCORE*/ "data/Object/Score.map",
+	/*MAPPINGSID_SPINDASHDUST*/ "data/Object/SpindashDust.map",
+	/*MAPPINGSID_SUPERSTARS*/ "data/Object/SuperStars.map",
+	/*MAPPINGSID_YELLOWSPRING*/ "data/Object/YellowSpring.map",
+};
+
+//Asset sizes
+size_t GetAssetBytes(TEXTURE *texture)
+{
+	size_t bytes = sizeof(TEXTURE);
+	if (texture->texture != nullptr)
+		bytes += (size_t)texture->width * texture->height;
+	if (texture->fail == nullptr && texture->loadedPalette != nullptr)
+		bytes += sizeof(PALETTE) + texture->loadedPalette->colours * sizeof(COLOUR);
+	return bytes;
+}
+
+size_t GetAssetBytes(MAPPINGS *mappings)
+{
+	return sizeof(MAPPINGS) + mappings->size * (sizeof(RECT) + sizeof(POINT));
+}
@@ -0,0 +1,194 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <mutex>
+#include <unordered_map>
+
+#include "Render.h"
+#include "Mappings.h"
+#include "Log.h"
+
+//Asset cache constants
+#define ASSETCACHE_DEFAULT_BUDGET	0x800000	//Bytes of unreferenced assets kept loaded, past this the least recently used are freed
+
+//Asset IDs (for assets that code uses by name, so they can be looked up from a table instead of by path)
+enum TEXTUREID
+{
+	TEXTUREID_EHZGENERIC,
+	TEXTUREID_GENERIC,
+	TEXTUREID_GENERICFONT,
+	TEXTUREID_GHZGENERIC,
+	TEXTUREID_HUD,
+	TEXTUREID_MINECART,
+	TEXTUREID_PLAYERGENERIC,
+	TEXTUREID_SONIC1BADNIK,
+	TEXTUREID_TITLECARD,
+	TEXTUREID_MAX,
+};
+
+enum MAPPINGSID
+{
+	MAPPINGSID_AQUABARRIER,
+	MAPPINGSID_BLUEBARRIER,
+	MAPPINGSID_BUZZBOMBER,
+	MAPPINGSID_CHOPPER,
+	MAPPINGSID_CRABMEAT,
+	MAPPINGSID_DOUBLESPINATTACK,
+	MAPPINGSID_DROPDASHDUST,
+	MAPPINGSID_EHZBRIDGE,
+	MAPPINGSID_FLAMEBARRIER,
+	MAPPINGSID_GHZBRIDGE,
+	MAPPINGSID_GHZEDGEWALL,
+	MAPPINGSID_GHZLEDGE,
+	MAPPINGSID_GHZPLATFORM,
+	MAPPINGSID_GHZPURPLEROCK,
+	MAPPINGSID_GHZSMASHABLEWALL,
+	MAPPINGSID_GHZSPIKELOG,
+	MAPPINGSID_GHZSPIKES,
+	MAPPINGSID_GHZSWINGINGPLATFORM,
+	MAPPINGSID_GOALPOST,
+	MAPPINGSID_INVINCIBILITYSTARS,
+	MAPPINGSID_LIGHTNINGBARRIER,
+	MAPPINGSID_MINECART,
+	MAPPINGSID_MISSILE,
+	MAPPINGSID_MONITOR,
+	MAPPINGSID_MONITORCONTENTS,
+	MAPPINGSID_MOTOBUG,
+	MAPPINGSID_NEWTRONBLUE,
+	MAPPINGSID_NEWTRONGREEN,
+	MAPPINGSID_REDSPRING,
+	MAPPINGSID_RING,
+	MAPPINGSID_SCORE,
+	MAPPINGSID_SPINDASHDUST,
+	MAPPINGSID_SUPERSTARS,
+	MAPPINGSID_YELLOWSPRING,
+	MAPPINGSID_MAX,
+};
+
+extern const char *gTexturePath[TEXTUREID_MAX];
+extern const char *gMappingsPath[MAPPINGSID_MAX];
+
+//Asset sizes (what freeing each asset would give back, for the cache's budget)
+size_t GetAssetBytes(TEXTURE *texture);
+size_t GetAssetBytes(MAPPINGS *mappings);
+
+//Asset cache class (process-wide assets by path, each referenced by the levels using it, and kept loaded within a byte budget once unreferenced)
+template <typename T> class ASSETCACHE
+{
+	private:
+		//Cache entry
+		struct ENTRY
+		{
+			T *asset;
+			size_t references;
+			size_t bytes;
+			uint64_t lastUse;
+		};
+		
+		//Entries by path
+		std::unordered_map<std::string, ENTRY> entry;
+		
+		//Retention
+		size_t budget = ASSETCACHE_DEFAULT_BUDGET;
+		size_t unreferencedBytes = 0;
+		uint64_t useCounter = 0;
+		
+		//Assets are taken and given from load job threads
+		std::mutex mutex;
+	
+	public:
+		~ASSETCACHE()
+		{
+			//Free every asset
+			for (auto &cached : entry)
+				delete cached.second.asset;
+		}
+		
+		//Reference the asset loaded from the given path, returns nullptr if it isn't loaded
+		T *Acquire(const std::string &path)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			
+			auto cached = entry.find(path);
+			if (cached == entry.end())
+				return nullptr;
+			
+			if (cached->second.references++ == 0)
+				unreferencedBytes -= cached->second.bytes;
+			cached->second.lastUse = ++useCounter;
+			return cached->second.asset;
+		}
+		
+		//Cache a newly loaded asset with a reference, returns the cached asset (the given one is freed if another thread cached the same path first)
+		T *Add(T *asset)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			
+			auto cached = entry.find(asset->source);
+			if (cached != entry.end())
+			{
+				delete asset;
+				if (cached->second.references++ == 0)
+					unreferencedBytes -= cached->second.bytes;
+				cached->second.lastUse = ++useCounter;
+				return cached->second.asset;
+			}
+			
+			entry[asset->source] = {asset, 1, GetAssetBytes(asset), ++useCounter};
+			return asset;
+		}
+		
+		//Release a reference to an asset, unreferenced assets are kept loaded within our budget (unless they failed to load)
+		void Release(T *asset)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			
+			auto cached = entry.find(asset->source);
+			if (cached == entry.end() || cached->second.asset != asset || cached->second.references == 0)
+				return;
+			if (--cached->second.references != 0)
+				return;
+			
+			if (asset->fail != nullptr)
+			{
+				entry.erase(cached);
+				delete asset;
+				return;
+			}
+			
+			unreferencedBytes += cached->second.bytes;
+			cached->second.lastUse = ++useCounter;
+			Trim();
+		}
+		
+		//Set how many bytes of unreferenced assets are kept loaded
+		void SetBudget(size_t setBudget)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			budget = setBudget;
+			Trim();
+		}
+	
+	private:
+		void Trim()
+		{
+			//Free the least recently used unreferenced assets until we're within our budget
+			while (unreferencedBytes > budget)
+			{
+				auto oldest = entry.end();
+				for (auto cached = entry.begin(); cached != entry.end(); cached++)
+					if (cached->second.references == 0 && (oldest == entry.end() || cached->second.lastUse < oldest->second.lastUse))
+						oldest = cached;
+				
+				LOG(("Asset cache: Freeing %s\n", oldest->first.c_str()));
+				unreferencedBytes -= oldest->second.bytes;
+				delete oldest->second.asset;
+				entry.erase(oldest);
+			}
+		}
+};
+
+//Process-wide asset caches
+extern ASSETCACHE<TEXTURE> gTextureCache;
+extern ASSETCACHE<MAPPINGS> gMappingsCache;
@@ -1,6 +1,26 @@
 #include <string>
+#ifdef __linux__
+	#include <unistd.h>
+#endif
 
 bool Backend_GetPaths(std::string *basePath, std::string *prefPath)
 {
+	//Use the directory our executable is in (so we can be run headless from anywhere), otherwise our working directory
+	std::string path;
+	#ifdef __linux__
+		char exePath[0x1000];
+		ssize_t length = readlink("/proc/self/exe", exePath, sizeof(exePath) - 1);
+		if (length > 0)
+		{
+			path.assign(exePath, length);
+			path.erase(path.find_last_of('/') + 1);
+		}
+	#endif
+	
+	//Apply this path to our output paths
+	if (basePath != nullptr)
+		*basePath = path;
+	if (prefPath != nullptr)
+		*prefPath = path;
 	return false;
 }
@@ -0,0 +1,290 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <chrono>
+
+#ifdef __linux__
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <linux/perf_event.h>
+	#include <unistd.h>
+#endif
+
+#include "Benchmark.h"
+#include "Game.h"
+#include "Level.h"
+#include "LevelCollision.h"
+#include "Object.h"
+
+//Benchmark global
+BENCHMARK *gBenchmark = nullptr;
+
+//Benchmark counter and sensor method names
+static const char *counterName[BENCHMARK_COUNTER_MAX] = {
+	"L1d read misses",
+	"LL read misses",
+};
+
+static const char *sensorMethodName[BENCHMARK_SENSOR_MAX] = {
+	"one at a time",
+	"in pairs",
+	"batched",
+};
+
+static inline uint32_t NextRandom(uint32_t *seed)
+{
+	//Our own generator (the level's is part of its state, so we can't touch it)
+	*seed = *seed * 1103515245 + 12345;
+	return *seed >> 16;
+}
+
+//Benchmark class
+BENCHMARK::BENCHMARK(unsigned int setFrames) : frames(setFrames)
+{
+	//Open our hardware counters
+	for (int i = 0; i < BENCHMARK_COUNTER_MAX; i++)
+	{
+		counterFd[i] = -1;
+		counter[i] = 0;
+	}
+	OpenCounters();
+}
+
+BENCHMARK::~BENCHMARK()
+{
+	//Print our results and close our counters
+	if (frame != 0)
+		Report();
+	CloseCounters();
+}
+
+bool BENCHMARK::Advance()
+{
+	//Get our next input (held for a random length of time, always holding right so we play through the level, packed in the same bits as netplay's)
+	if (--hold <= 0)
+	{
+		input = (uint8_t)((NextRandom(&seed) & ~(1 << 5)) | (1 << 4));
+		hold = 4 + (NextRandom(&seed) % 40);
+	}
+	
+	CONTROLMASK held;
+	held.a = (input & (1 << 1)) != 0;
+	held.b = (input & (1 << 2)) != 0;
+	held.c = (input & (1 << 3)) != 0;
+	held.right = (input & (1 << 4)) != 0;
+	held.left = (input & (1 << 5)) != 0;
+	held.down = (input & (1 << 6)) != 0;
+	held.up = (input & (1 << 7)) != 0;
+	
+	CONTROLMASK &last = gController[0].held;
+	gController[0].press.a = held.a && !last.a;
+	gController[0].press.b = held.b && !last.b;
+	gController[0].press.c = held.c && !last.c;
+	gController[0].press.right = held.right && !last.right;
+	gController[0].press.left = held.left && !last.left;
+	gController[0].press.down = held.down && !last.down;
+	gController[0].press.up = held.up && !last.up;
+	gController[0].press.start = false;
+	gController[0].lastHeld = last;
+	gController[0].held = held;
+	
+	//Update the level, timing it and counting its cache misses
+	size_t objects = gLevel->objectList.size();
+	
+	StartCounters();
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	bool error = gLevel->Update();
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	StopCounters();
+	
+	if (error)
+		return true;
+	
+	updateMs += ms;
+	if (ms > longestUpdateMs)
+		longestUpdateMs = ms;
+	objectFrames += objects;
+	checksum = gLevel->Checksum();
+	frame++;
+	
+	//Time the collision sensors once we're done, while the level's still loaded
+	if (Done())
+		TimeSensors();
+	return false;
+}
+
+//Collision sensor benchmark
+void BENCHMARK::TimeSensors()
+{
+	if (gLevel->playerList.size() == 0)
+		return;
+	
+	//Place pairs of sensors around the lead player like their 2-point checks (seeded, so every run checks the same ones), in every direction and on every layer
+	static COLLISIONSENSOR sensor[BENCHMARK_SENSORS];
+	static COLLISIONSENSOR result[BENCHMARK_SENSOR_MAX][BENCHMARK_SENSORS];
+	
+	uint32_t sensorSeed = BENCHMARK_SEED;
+	PLAYER *lead = gLevel->playerList[0];
+	for (size_t i = 0; i < BENCHMARK_SENSORS; i += 2)
+	{
+		int16_t x = lead->x.pos - BENCHMARK_SENSOR_RANGE + (int16_t)(NextRandom(&sensorSeed) % (BENCHMARK_SENSOR_RANGE * 2));
+		int16_t y = lead->y.pos - BENCHMARK_SENSOR_RANGE + (int16_t)(NextRandom(&sensorSeed) % (BENCHMARK_SENSOR_RANGE * 2));
+		COLLISIONLAYER layer = (COLLISIONLAYER)(NextRandom(&sensorSeed) % COLLISIONLAYER_MAX);
+		COLLISIONDIRECTION direction = (COLLISIONDIRECTION)(NextRandom(&sensorSeed) % 4);
+		
+		bool vertical = direction <= COLLISIONDIRECTION_UP;
+		sensor[i + 0] = {(int16_t)(x + (vertical ? lead->xRadius : 0)), (int16_t)(y + (vertical ? 0 : lead->xRadius)), layer, direction, 0, 0};
+		sensor[i + 1] = {(int16_t)(x - (vertical ? lead->xRadius : 0)), (int16_t)(y - (vertical ? 0 : lead->xRadius)), layer, direction, 0, 0};
+	}
+	
+	//Check them every way, timing each
+	for (int method = BENCHMARK_SENSOR_MAX - 1; method >= 0; method--)
+	{
+		COLLISIONSENSOR *check = result[method];
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		
+		for (unsigned int round = 0; round < BENCHMARK_SENSOR_ROUNDS; round++)
+		{
+			memcpy(check, sensor, sizeof(sensor));
+			switch (method)
+			{
+				case BENCHMARK_SENSOR_SINGLE:
+					for (size_t i = 0; i < BENCHMARK_SENSORS; i++)
+					{
+						bool flipped = (check[i].direction & 1) != 0;
+						if (check[i].direction <= COLLISIONDIRECTION_UP)
+							check[i].distance = GetCollisionV(check[i].x, check[i].y, check[i].layer, flipped, &check[i].angle);
+						else
+							check[i].distance = GetCollisionH(check[i].x, check[i].y, check[i].layer, flipped, &check[i].angle);
+					}
+					break;
+				case BENCHMARK_SENSOR_PAIRS:
+					for (size_t i = 0; i < BENCHMARK_SENSORS; i += 2)
+						GetCollisionSensors(&check[i], 2);
+					break;
+				case BENCHMARK_SENSOR_BATCHED:
+					GetCollisionSensors(check, BENCHMARK_SENSORS);
+					break;
+			}
+		}
+		
+		sensorNs[method] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ((double)BENCHMARK_SENSORS * BENCHMARK_SENSOR_ROUNDS);
+	}
+	
+	//Check that every method found the same surfaces
+	for (int method = 1; method < BENCHMARK_SENSOR_MAX; method++)
+		for (size_t i = 0; i < BENCHMARK_SENSORS; i++)
+			if (result[method][i].distance != result[0][i].distance || result[method][i].angle != result[0][i].angle)
+				sensorsMatch = false;
+	sensorsTimed = true;
+}
+
+//Counter functions
+void BENCHMARK::OpenCounters()
+{
+	#ifdef __linux__
+		static const uint64_t config[BENCHMARK_COUNTER_MAX] = {
+			PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+			PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+		};
+		
+		for (int i = 0; i < BENCHMARK_COUNTER_MAX; i++)
+		{
+			//Open this counter for our thread, stopped until we start it around an update
+			struct perf_event_attr attr;
+			memset(&attr, 0, sizeof(attr));
+			attr.type = PERF_TYPE_HW_CACHE;
+			attr.size = sizeof(attr);
+			attr.config = config[i];
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			counterFd[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+		}
+	#endif
+}
+
+void BENCHMARK::StartCounters()
+{
+	#ifdef __linux__
+		for (int i = 0; i < BENCHMARK_COUNTER_MAX; i++)
+			if (counterFd[i] >= 0)
+				ioctl(counterFd[i], PERF_EVENT_IOC_ENABLE, 0);
+	#endif
+}
+
+void BENCHMARK::StopCounters()
+{
+	#ifdef __linux__
+		for (int i = 0; i < BENCHMARK_COUNTER_MAX; i++)
+			if (counterFd[i] >= 0)
+				ioctl(counterFd[i], PERF_EVENT_IOC_DISABLE, 0);
+	#endif
+}
+
+void BENCHMARK::CloseCounters()
+{
+	#ifdef __linux__
+		for (int i = 0; i < BENCHMARK_COUNTER_MAX; i++)
+		{
+			if (counterFd[i] >= 0)
+				close(counterFd[i]);
+			counterFd[i] = -1;
+		}
+	#endif
+}
+
+//Print our results
+void BENCHMARK::Report()
+{
+	//Read our counters' totals (they count everything between starting and stopping them)
+	#ifdef __linux__
+		for (int i = 0; i < BENCHMARK_COUNTER_MAX; i++)
+			if (counterFd[i] >= 0 && read(counterFd[i], &counter[i], sizeof(counter[i])) != sizeof(counter[i]))
+				counterFd[i] = -1;
+	#endif
+	
+	//Always printed (rather than logged), so release builds can be benchmarked
+	printf("Benchmark: %u frames, %.1f objects a frame, level checksum %08X\n", frame, (double)objectFrames / frame, (unsigned int)checksum);
+	printf("Benchmark: object record %u bytes hot, %u bytes cold\n", (unsigned int)sizeof(OBJECT), (unsigned int)sizeof(OBJECT_COLD));
+	printf("Benchmark: level update %.3f ms total, %.2f us a frame, %.3f ms longest\n", updateMs, updateMs * 1000.0 / frame, longestUpdateMs);
+	for (int i = 0; i < BENCHMARK_COUNTER_MAX; i++)
+	{
+		if (counterFd[i] >= 0)
+			printf("Benchmark: %s %llu total, %.1f a frame\n", counterName[i], (unsigned long long)counter[i], (double)counter[i] / frame);
+		else
+			printf("Benchmark: %s unavailable\n", counterName[i]);
+	}
+	
+	if (sensorsTimed)
+	{
+		for (int i = 0; i < BENCHMARK_SENSOR_MAX; i++)
+			printf("Benchmark: collision sensors %s %.2f ns a sensor\n", sensorMethodName[i], sensorNs[i]);
+		if (!sensorsMatch)
+			printf("Benchmark: collision sensor methods found different surfaces\n");
+	}
+}
+
+//Benchmark initialization
+bool InitializeBenchmark(int argc, char *argv[])
+{
+	//Get our frame count
+	unsigned int frames = 0;
+	for (int i = 1; i + 1 < argc; i++)
+		if (!strcmp(argv[i], "-bench"))
+			frames = (unsigned int)atoi(argv[++i]);
+	
+	if (frames == 0)
+		return false;
+	
+	//Start benchmarking
+	gBenchmark = new BENCHMARK(frames);
+	return false;
+}
+
+void QuitBenchmark()
+{
+	//End our benchmark (printing its results)
+	delete gBenchmark;
+	gBenchmark = nullptr;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Input.h"
+
+//Benchmark constants
+#define BENCHMARK_SEED	0x42454E43	//"BENC"
+
+//Collision sensor benchmark (sensors placed around the lead player once our frames are done, checked for a number of rounds each way)
+#define BENCHMARK_SENSORS		0x1000
+#define BENCHMARK_SENSOR_ROUNDS	0x100
+#define BENCHMARK_SENSOR_RANGE	0x100	//Pixels either side of the lead player
+
+enum BENCHMARK_SENSOR_METHOD
+{
+	BENCHMARK_SENSOR_SINGLE,	//GetCollisionV and GetCollisionH, one probe at a time
+	BENCHMARK_SENSOR_PAIRS,		//GetCollisionSensors, two at a time (like the player's 2-point checks)
+	BENCHMARK_SENSOR_BATCHED,	//GetCollisionSensors, all at once
+	BENCHMARK_SENSOR_MAX,
+};
+
+//Hardware counters read around each level update (where the platform has them)
+enum BENCHMARK_COUNTER
+{
+	BENCHMARK_COUNTER_L1D_MISSES,	//L1 data cache read misses
+	BENCHMARK_COUNTER_LL_MISSES,	//Last-level cache read misses
+	BENCHMARK_COUNTER_MAX,
+};
+
+//Headless level benchmark (plays the same random input every run, and times every level update, counting cache misses where it can)
+class BENCHMARK
+{
+	public:
+		//Frames to run (counted across levels, as levels end when the player dies)
+		unsigned int frames;
+	
+	private:
+		//Frames we've run
+		unsigned int frame = 0;
+		
+		//Random input
+		uint32_t seed = BENCHMARK_SEED;
+		uint8_t input = 0;
+		int32_t hold = 0;
+		
+		//Totals
+		double updateMs = 0.0;
+		double longestUpdateMs = 0.0;
+		size_t objectFrames = 0;
+		uint32_t checksum = 0;	//Of the level after our last frame (so runs can be checked to have simulated the same thing)
+		
+		//Hardware counters (-1 where unavailable)
+		int counterFd[BENCHMARK_COUNTER_MAX];
+		uint64_t counter[BENCHMARK_COUNTER_MAX];
+		
+		//Collision sensor results (nanoseconds a sensor, and if every method found the same surfaces)
+		double sensorNs[BENCHMARK_SENSOR_MAX] = {0.0};
+		bool sensorsTimed = false;
+		bool sensorsMatch = true;
+	
+	public:
+		BENCHMARK(unsigned int setFrames);
+		~BENCHMARK();
+		
+		//Update the level with our next input, returns true on failure
+		bool Advance();
+		
+		//If we've run all of our frames
+		inline bool Done() { return frame >= frames; }
+	
+	private:
+		//Counter functions
+		void OpenCounters();
+		void StartCounters();
+		void StopCounters();
+		void CloseCounters();
+		
+		//Time the collision sensor methods against each other
+		void TimeSensors();
+		
+		//Print our results
+		void Report();
+};
+
+//Benchmark global (null when not benchmarking)
+extern BENCHMARK *gBenchmark;
+
+//Parse the benchmark's command line options, creating it if we're benchmarking, returns true on failure
+bool InitializeBenchmark(int argc, char *argv[]);
+void QuitBenchmark();
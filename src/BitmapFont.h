@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string.h>
 #include "Render.h"
 
 class BITMAPFONT
@@ -14,10 +15,12 @@ class BITMAPFONT
 		BITMAPFONT(TEXTURE *useBitmap, unsigned int useX0, unsigned int useY0, unsigned int useCw, unsigned int useCh, unsigned int useSx, unsigned int useSy, unsigned int useCpl, unsigned int useTlc) : bitmap(useBitmap), x0(useX0), y0(useY0), cw(useCw), ch(useCh), sx(useSx), sy(useSy), cpl(useCpl), tlc(useTlc) { return; }
 		~BITMAPFONT() { return; }
 		
-		inline void DrawString(std::string string, size_t layer, int x, int y)
+		inline void DrawString(const std::string &string, size_t layer, int x, int y) { DrawString(string.c_str(), layer, x, y); }
+		
+		inline void DrawString(const char *string, size_t layer, int x, int y)
 		{
 			//Draw every character of the string according to its size
-			for(size_t i = 0; i < string.size(); i++)
+			for(size_t i = 0; string[i] != '\0'; i++)
 			{
 				//Get our rect according to this character (from the top left of the font area, using size, seperation, and character info)
 				RECT thisCharRect = {
@@ -0,0 +1,364 @@
+#include "Compression.h"
+
+//Output helper (reserves in large steps and writes without bounds checks, so the decoders' inner loops only check the input)
+static inline uint8_t *Reserve(ARRAY<uint8_t> *dest, size_t size)
+{
+	if (dest->arSize + size > dest->arCapacity)
+	{
+		size_t capacity = (dest->arCapacity != 0) ? dest->arCapacity : 0x1000;
+		while (capacity < dest->arSize + size)
+			capacity *= 2;
+		if (dest->reserve(capacity))
+			return nullptr;
+	}
+	return dest->entry + dest->arSize;
+}
+
+//Kosinski
+bool KosinskiDecompress(const uint8_t *src, size_t srcSize, ARRAY<uint8_t> *dest)
+{
+	const uint8_t *srcEnd = src + srcSize;
+	size_t start = dest->arSize;
+	
+	//Read our first descriptor (16 bits, read from the lowest bit up)
+	if (srcEnd - src < 2)
+		return true;
+	unsigned int descriptor = src[0] | (src[1] << 8);
+	unsigned int descriptorBits = 16;
+	src += 2;
+	
+	//Get the next descriptor bit, loading the next descriptor as soon as the last bit is used (before any data that follows)
+	#define KOSINSKI_BIT(bit)	\
+	{	\
+		bit = descriptor & 1;	\
+		descriptor >>= 1;	\
+		if (--descriptorBits == 0)	\
+		{	\
+			if (srcEnd - src < 2)	\
+				return true;	\
+			descriptor = src[0] | (src[1] << 8);	\
+			descriptorBits = 16;	\
+			src += 2;	\
+		}	\
+	}
+	
+	while (1)
+	{
+		unsigned int bit;
+		KOSINSKI_BIT(bit);
+		
+		//Literal byte
+		if (bit)
+		{
+			if (src >= srcEnd)
+				return true;
+			uint8_t *out = Reserve(dest, 1);
+			if (out == nullptr)
+				return true;
+			*out = *src++;
+			dest->arSize++;
+			continue;
+		}
+		
+		//Get our match's distance and length
+		size_t distance, count;
+		KOSINSKI_BIT(bit);
+		
+		if (bit)
+		{
+			//Separate match (13-bit distance, 3-bit or extended count)
+			if (srcEnd - src < 2)
+				return true;
+			unsigned int low = src[0], high = src[1];
+			src += 2;
+			
+			distance = 0x2000 - (((high & 0xF8) << 5) | low);
+			count = high & 0x7;
+			
+			if (count != 0)
+			{
+				count += 2;
+			}
+			else
+			{
+				if (src >= srcEnd)
+					return true;
+				count = *src++;
+				if (count == 0)
+					break;	//End of data
+				if (count == 1)
+					continue;	//Dummy match
+				count += 1;
+			}
+		}
+		else
+		{
+			//Inline match (2-bit count, 8-bit distance)
+			unsigned int high, low;
+			KOSINSKI_BIT(high);
+			KOSINSKI_BIT(low);
+			count = ((high << 1) | low) + 2;
+			
+			if (src >= srcEnd)
+				return true;
+			distance = 0x100 - *src++;
+		}
+		
+		//Copy our match (byte by byte, as it can overlap what it's writing)
+		if (distance > dest->arSize - start)
+			return true;
+		
+		uint8_t *out = Reserve(dest, count);
+		if (out == nullptr)
+			return true;
+		
+		const uint8_t *from = out - distance;
+		for (size_t i = 0; i < count; i++)
+			out[i] = from[i];
+		dest->arSize += count;
+	}
+	
+	#undef KOSINSKI_BIT
+	return false;
+}
+
+//Nemesis
+struct NEMESIS_CODE
+{
+	uint8_t length;	//0 for codes that aren't in the table
+	uint8_t nybble;
+	uint8_t run;
+};
+
+bool NemesisDecompress(const uint8_t *src, size_t srcSize, ARRAY<uint8_t> *dest)
+{
+	const uint8_t *srcEnd = src + srcSize;
+	
+	//Read our header (XOR mode flag and tile count)
+	if (srcEnd - src < 2)
+		return true;
+	bool xorMode = (src[0] & 0x80) != 0;
+	size_t tiles = ((src[0] & 0x7F) << 8) | src[1];
+	src += 2;
+	
+	//Read our code table, each code is stored left-aligned in a 256 entry table, so the next 8 bits of the stream directly index it
+	NEMESIS_CODE table[0x100] = {};
+	uint8_t nybble = 0;
+	
+	while (1)
+	{
+		if (src >= srcEnd)
+			return true;
+		uint8_t spec = *src++;
+		if (spec == 0xFF)
+			break;
+		
+		//A set high bit gives the nybble of the codes that follow
+		if (spec & 0x80)
+		{
+			nybble = spec & 0xF;
+			if (src >= srcEnd)
+				return true;
+			spec = *src++;
+		}
+		
+		if (src >= srcEnd)
+			return true;
+		uint8_t code = *src++;
+		unsigned int length = spec & 0xF;
+		if (length == 0 || length > 8)
+			return true;
+		
+		unsigned int first = (code << (8 - length)) & 0xFF;
+		for (unsigned int i = 0; i < (1u << (8 - length)); i++)
+			table[first | i] = {(uint8_t)length, nybble, (uint8_t)(((spec >> 4) & 0x7) + 1)};
+	}
+	
+	//Decode our tiles
+	size_t rows = tiles * 8;
+	uint8_t *out = Reserve(dest, rows * 4);
+	if (out == nullptr)
+		return true;
+	
+	uint32_t bitBuffer = 0;
+	unsigned int bitCount = 0;
+	uint32_t row = 0, previousRow = 0;
+	unsigned int rowNybbles = 0;
+	size_t rowsDone = 0;
+	
+	while (rowsDone < rows)
+	{
+		//Keep at least 16 bits in our buffer (past the end of our data is read as 0s, which are only used by malformed data)
+		while (bitCount <= 16)
+		{
+			bitBuffer |= (uint32_t)((src < srcEnd) ? *src++ : 0) << (24 - bitCount);
+			bitCount += 8;
+		}
+		
+		//Get our code, either from the table or inline (6 set bits, then a 3-bit run and 4-bit nybble)
+		unsigned int runNybble, run;
+		if ((bitBuffer >> 26) == 0x3F)
+		{
+			run = ((bitBuffer >> 23) & 0x7) + 1;
+			runNybble = (bitBuffer >> 19) & 0xF;
+			bitBuffer <<= 13;
+			bitCount -= 13;
+		}
+		else
+		{
+			const NEMESIS_CODE *code = &table[bitBuffer >> 24];
+			if (code->length == 0)
+				return true;
+			run = code->run;
+			runNybble = code->nybble;
+			bitBuffer <<= code->length;
+			bitCount -= code->length;
+		}
+		
+		//Write our run into our rows, 8 nybbles per row
+		for (unsigned int i = 0; i < run; i++)
+		{
+			row = (row << 4) | runNybble;
+			if (++rowNybbles == 8)
+			{
+				if (xorMode)
+					row = previousRow ^= row;
+				
+				out[0] = row >> 24;
+				out[1] = row >> 16;
+				out[2] = row >> 8;
+				out[3] = row;
+				out += 4;
+				
+				row = 0;
+				rowNybbles = 0;
+				if (++rowsDone == rows)
+					break;
+			}
+		}
+	}
+	
+	dest->arSize += rows * 4;
+	return false;
+}
+
+//Enigma
+bool EnigmaDecompress(const uint8_t *src, size_t srcSize, ARRAY<uint8_t> *dest, uint16_t artTile)
+{
+	const uint8_t *srcEnd = src + srcSize;
+	
+	//Read our header (inline value length, which flags are stored with inline values, and our incrementing and common values)
+	if (srcEnd - src < 6)
+		return true;
+	unsigned int inlineBits = src[0];
+	unsigned int flagMask = src[1];
+	uint16_t incrementing = ((src[2] << 8) | src[3]) + artTile;
+	uint16_t common = ((src[4] << 8) | src[5]) + artTile;
+	src += 6;
+	
+	if (inlineBits > 11)
+		return true;
+	
+	//Bit reader (most significant bit first)
+	uint32_t bitBuffer = 0;
+	unsigned int bitCount = 0;
+	
+	#define ENIGMA_BITS(value, bits)	\
+	{	\
+		while (bitCount < (bits))	\
+		{	\
+			if (src >= srcEnd)	\
+				return true;	\
+			bitBuffer = (bitBuffer << 8) | *src++;	\
+			bitCount += 8;	\
+		}	\
+		bitCount -= (bits);	\
+		value = (bitBuffer >> bitCount) & ((1u << (bits)) - 1);	\
+	}
+	
+	//Inline value reader (priority, palette, and flip flags that are set in our mask are read first, then the value itself)
+	static const uint16_t flagBits[5] = {0x8000, 0x4000, 0x2000, 0x1000, 0x0800};
+	
+	#define ENIGMA_INLINE(value)	\
+	{	\
+		unsigned int inlineBit;	\
+		value = artTile;	\
+		for (int flag = 0; flag < 5; flag++)	\
+		{	\
+			if (flagMask & (0x10 >> flag))	\
+			{	\
+				ENIGMA_BITS(inlineBit, 1);	\
+				if (inlineBit)	\
+					value |= flagBits[flag];	\
+			}	\
+		}	\
+		ENIGMA_BITS(inlineBit, inlineBits);	\
+		value += inlineBit;	\
+	}
+	
+	while (1)
+	{
+		//Get our packet type and count
+		unsigned int type, count;
+		ENIGMA_BITS(type, 1);
+		if (type == 0)
+		{
+			ENIGMA_BITS(type, 1);
+		}
+		else
+		{
+			ENIGMA_BITS(type, 2);
+			type |= 4;
+		}
+		ENIGMA_BITS(count, 4);
+		count++;
+		
+		//End of data
+		if (type == 7 && count == 0x10)
+			break;
+		
+		uint8_t *out = Reserve(dest, count * 2);
+		if (out == nullptr)
+			return true;
+		
+		//Write our words
+		uint16_t value = 0;
+		if (type >= 4 && type <= 6)
+			ENIGMA_INLINE(value);
+		
+		for (unsigned int i = 0; i < count; i++)
+		{
+			switch (type)
+			{
+				case 0:	//Incrementing value
+					value = incrementing++;
+					break;
+				case 1:	//Common value
+					value = common;
+					break;
+				case 4:	//Repeated inline value
+					break;
+				case 5:	//Incrementing inline value
+					if (i != 0)
+						value++;
+					break;
+				case 6:	//Decrementing inline value
+					if (i != 0)
+						value--;
+					break;
+				case 7:	//Separate inline values
+					ENIGMA_INLINE(value);
+					break;
+			}
+			
+			out[i * 2 + 0] = value >> 8;
+			out[i * 2 + 1] = value & 0xFF;
+		}
+		
+		dest->arSize += count * 2;
+	}
+	
+	#undef ENIGMA_INLINE
+	#undef ENIGMA_BITS
+	return false;
+}
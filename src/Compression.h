@@ -0,0 +1,16 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Array.h"
+
+//Decompressors for the original games' compression formats
+//Each appends the decompressed data to the given array (in the original big-endian byte order), and returns true on failure (truncated or malformed data)
+//Kosinski - LZSS used for most level data (chunk mappings, layouts, collision indices)
+bool KosinskiDecompress(const uint8_t *src, size_t srcSize, ARRAY<uint8_t> *dest);
+
+//Nemesis - Huffman-coded run-length nybbles, used for 4bpp tile art
+bool NemesisDecompress(const uint8_t *src, size_t srcSize, ARRAY<uint8_t> *dest);
+
+//Enigma - Word-based compression used for plane mappings (artTile is added to every output word, as when decompressing to VRAM)
+bool EnigmaDecompress(const uint8_t *src, size_t srcSize, ARRAY<uint8_t> *dest, uint16_t artTile = 0);
@@ -0,0 +1,796 @@
+//Compression benchmark - checks the game's decompressors against simple reference decoders, and times both
+//Usage: compressbench [compressed files (.kos, .nem, or .eni)...]
+//With no files, generated data is compressed by the encoders below (which use every packet type the decompressors handle), round-tripped, and timed
+//The reference decoders follow the original games' routines (a bit at a time, and a search of the code table for every Nemesis code), so they're slow, but easy to check
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+#include "../Compression.h"
+
+//Benchmark settings
+#define BENCH_MIN_MS	200	//Each decoder is run over its data until at least this long has passed
+
+//Random numbers (our own generator, so the generated data is the same every run)
+static uint32_t randomSeed = 0x12345678;
+
+static inline uint32_t Random(uint32_t range)
+{
+	randomSeed = randomSeed * 1103515245 + 12345;
+	return (randomSeed >> 8) % range;
+}
+
+//Bit readers for the reference decoders
+struct BITREADER_LSB //Kosinski's descriptors (16-bit little-endian, read from the lowest bit up, and reloaded as soon as they run out)
+{
+	const std::vector<uint8_t> &in;
+	size_t pos = 0;
+	unsigned int descriptor = 0, bits = 0;
+	
+	BITREADER_LSB(const std::vector<uint8_t> &setIn) : in(setIn) { return; }
+	
+	bool Byte(unsigned int *out)
+	{
+		if (pos >= in.size())
+			return false;
+		*out = in[pos++];
+		return true;
+	}
+	
+	bool Load()
+	{
+		unsigned int low, high;
+		if (!Byte(&low) || !Byte(&high))
+			return false;
+		descriptor = low | (high << 8);
+		bits = 16;
+		return true;
+	}
+	
+	bool Bit(unsigned int *out)
+	{
+		*out = descriptor & 1;
+		descriptor >>= 1;
+		return (--bits != 0) || Load();
+	}
+};
+
+struct BITREADER_MSB //Nemesis and Enigma's bitstreams (most significant bit first)
+{
+	const std::vector<uint8_t> &in;
+	size_t pos;
+	unsigned int bit = 0;
+	
+	BITREADER_MSB(const std::vector<uint8_t> &setIn, size_t setPos) : in(setIn), pos(setPos) { return; }
+	
+	bool Bits(unsigned int count, unsigned int *out)
+	{
+		*out = 0;
+		for (unsigned int i = 0; i < count; i++)
+		{
+			if (pos >= in.size())
+				return false;
+			*out = (*out << 1) | ((in[pos] >> (7 - bit)) & 1);
+			if (++bit == 8)
+			{
+				bit = 0;
+				pos++;
+			}
+		}
+		return true;
+	}
+};
+
+//Bit writers for the encoders
+struct BITWRITER_MSB
+{
+	std::vector<uint8_t> &out;
+	unsigned int bit = 0;
+	
+	BITWRITER_MSB(std::vector<uint8_t> &setOut) : out(setOut) { return; }
+	
+	void Bits(unsigned int count, unsigned int value)
+	{
+		for (unsigned int i = count; i-- > 0;)
+		{
+			if (bit == 0)
+				out.push_back(0);
+			out.back() |= ((value >> i) & 1) << (7 - bit);
+			bit = (bit + 1) & 7;
+		}
+	}
+};
+
+//Kosinski
+static bool ReferenceKosinski(const std::vector<uint8_t> &in, std::vector<uint8_t> &out)
+{
+	BITREADER_LSB reader(in);
+	if (!reader.Load())
+		return false;
+	
+	while (1)
+	{
+		unsigned int bit, byte;
+		if (!reader.Bit(&bit))
+			return false;
+		
+		//Literal byte
+		if (bit)
+		{
+			if (!reader.Byte(&byte))
+				return false;
+			out.push_back((uint8_t)byte);
+			continue;
+		}
+		
+		//Match
+		size_t distance, count;
+		if (!reader.Bit(&bit))
+			return false;
+		
+		if (bit)
+		{
+			unsigned int low, high;
+			if (!reader.Byte(&low) || !reader.Byte(&high))
+				return false;
+			distance = 0x2000 - (((high & 0xF8) << 5) | low);
+			if ((count = high & 0x7) != 0)
+			{
+				count += 2;
+			}
+			else
+			{
+				if (!reader.Byte(&byte))
+					return false;
+				if (byte == 0)
+					return true;
+				if (byte == 1)
+					continue;
+				count = byte + 1;
+			}
+		}
+		else
+		{
+			unsigned int high, low;
+			if (!reader.Bit(&high) || !reader.Bit(&low) || !reader.Byte(&byte))
+				return false;
+			count = ((high << 1) | low) + 2;
+			distance = 0x100 - byte;
+		}
+		
+		if (distance > out.size())
+			return false;
+		for (size_t i = 0; i < count; i++)
+			out.push_back(out[out.size() - distance]);
+	}
+}
+
+static void EncodeKosinski(const std::vector<uint8_t> &in, std::vector<uint8_t> &out)
+{
+	//Descriptor writing (a new descriptor's space is reserved as soon as the last one fills, as the decoder loads it then)
+	size_t descriptorPos = 0;
+	unsigned int descriptor = 0, bits = 0;
+	out.assign(2, 0);
+	
+	auto Bit = [&](unsigned int bit)
+	{
+		descriptor |= bit << bits;
+		if (++bits == 16)
+		{
+			out[descriptorPos + 0] = descriptor & 0xFF;
+			out[descriptorPos + 1] = descriptor >> 8;
+			descriptorPos = out.size();
+			out.push_back(0);
+			out.push_back(0);
+			descriptor = 0;
+			bits = 0;
+		}
+	};
+	
+	//Find matches through chains of earlier positions with the same first two bytes
+	std::vector<int> head(0x10000, -1), prev(in.size(), -1);
+	
+	for (size_t i = 0; i < in.size();)
+	{
+		size_t bestCount = 0, bestDistance = 0;
+		if (i + 1 < in.size())
+		{
+			unsigned int hash = (in[i] << 8) | in[i + 1];
+			int steps = 0;
+			for (int at = head[hash]; at >= 0 && i - at <= 0x2000 && steps < 64; at = prev[at], steps++)
+			{
+				size_t count = 0;
+				while (count < 0x100 && i + count < in.size() && in[at + count] == in[i + count])
+					count++;
+				if (count > bestCount)
+				{
+					bestCount = count;
+					bestDistance = i - at;
+				}
+			}
+		}
+		
+		//Write an inline match, a separate match, or a literal byte
+		size_t advance = 1;
+		if (bestCount >= 2 && bestCount <= 5 && bestDistance <= 0x100)
+		{
+			Bit(0);
+			Bit(0);
+			Bit((unsigned int)(bestCount - 2) >> 1);
+			Bit((unsigned int)(bestCount - 2) & 1);
+			out.push_back((uint8_t)(0x100 - bestDistance));
+			advance = bestCount;
+		}
+		else if (bestCount >= 3)
+		{
+			unsigned int value = (unsigned int)(0x2000 - bestDistance);
+			Bit(0);
+			Bit(1);
+			out.push_back(value & 0xFF);
+			if (bestCount <= 9)
+			{
+				out.push_back(((value >> 5) & 0xF8) | (unsigned int)(bestCount - 2));
+			}
+			else
+			{
+				out.push_back((value >> 5) & 0xF8);
+				out.push_back((uint8_t)(bestCount - 1));
+			}
+			advance = bestCount;
+		}
+		else
+		{
+			Bit(1);
+			out.push_back(in[i]);
+		}
+		
+		//Add the positions we've passed to our chains
+		for (size_t j = 0; j < advance; j++, i++)
+		{
+			if (i + 1 < in.size())
+			{
+				unsigned int hash = (in[i] << 8) | in[i + 1];
+				prev[i] = head[hash];
+				head[hash] = (int)i;
+			}
+		}
+	}
+	
+	//End of data (a separate match with an extended count of 0), then write our last descriptor
+	Bit(0);
+	Bit(1);
+	out.push_back(0x00);
+	out.push_back(0xF0);
+	out.push_back(0x00);
+	out[descriptorPos + 0] = descriptor & 0xFF;
+	out[descriptorPos + 1] = descriptor >> 8;
+}
+
+//Nemesis
+struct NEMESIS_REFERENCE_CODE
+{
+	unsigned int length, code, nybble, run;
+};
+
+static bool ReferenceNemesis(const std::vector<uint8_t> &in, std::vector<uint8_t> &out)
+{
+	//Read our header and code table
+	if (in.size() < 2)
+		return false;
+	bool xorMode = (in[0] & 0x80) != 0;
+	size_t rows = (((in[0] & 0x7F) << 8) | in[1]) * 8;
+	size_t pos = 2;
+	
+	std::vector<NEMESIS_REFERENCE_CODE> codes;
+	unsigned int nybble = 0;
+	while (1)
+	{
+		if (pos >= in.size())
+			return false;
+		unsigned int spec = in[pos++];
+		if (spec == 0xFF)
+			break;
+		if (spec & 0x80)
+		{
+			nybble = spec & 0xF;
+			if (pos >= in.size())
+				return false;
+			spec = in[pos++];
+		}
+		if (pos >= in.size())
+			return false;
+		codes.push_back({spec & 0xF, in[pos++], nybble, ((spec >> 4) & 0x7) + 1});
+	}
+	
+	//Decode our rows a code at a time, searching the table as each bit is read
+	BITREADER_MSB reader(in, pos);
+	uint32_t row = 0, previousRow = 0;
+	unsigned int rowNybbles = 0;
+	size_t rowsDone = 0;
+	
+	while (rowsDone < rows)
+	{
+		unsigned int code = 0, length = 0, run = 0, runNybble = 0, bit;
+		while (run == 0)
+		{
+			//Reading past the end of our data reads 0s, like the original
+			if (!reader.Bits(1, &bit))
+				bit = 0;
+			code = (code << 1) | bit;
+			length++;
+			
+			if (length == 6 && code == 0x3F)
+			{
+				unsigned int inlineRun, inlineNybble;
+				if (!reader.Bits(3, &inlineRun) || !reader.Bits(4, &inlineNybble))
+					return false;
+				run = inlineRun + 1;
+				runNybble = inlineNybble;
+				break;
+			}
+			
+			for (const NEMESIS_REFERENCE_CODE &entry : codes)
+			{
+				if (entry.length == length && entry.code == code)
+				{
+					run = entry.run;
+					runNybble = entry.nybble;
+					break;
+				}
+			}
+			if (run == 0 && length >= 8)
+				return false;
+		}
+		
+		for (unsigned int i = 0; i < run && rowsDone < rows; i++)
+		{
+			row = (row << 4) | runNybble;
+			if (++rowNybbles == 8)
+			{
+				if (xorMode)
+					row = previousRow ^= row;
+				for (int b = 0; b < 4; b++)
+					out.push_back((uint8_t)(row >> (24 - b * 8)));
+				row = 0;
+				rowNybbles = 0;
+				rowsDone++;
+			}
+		}
+	}
+	return true;
+}
+
+static void EncodeNemesis(const std::vector<uint8_t> &in, bool xorMode, std::vector<uint8_t> &out)
+{
+	//Header (the data is a whole number of 32-byte tiles)
+	size_t tiles = in.size() / 32;
+	out.clear();
+	out.push_back((uint8_t)((xorMode ? 0x80 : 0x00) | (tiles >> 8)));
+	out.push_back((uint8_t)tiles);
+	
+	//Every nybble and run gets a 7-bit code of its nybble and run, except the two that would start with 6 set bits (those are written inline)
+	for (unsigned int nybble = 0; nybble < 0x10; nybble++)
+	{
+		out.push_back((uint8_t)(0x80 | nybble));
+		for (unsigned int run = 1; run <= 8; run++)
+		{
+			unsigned int code = nybble * 8 + (run - 1);
+			if (code < 0x7E)
+			{
+				out.push_back((uint8_t)(((run - 1) << 4) | 7));
+				out.push_back((uint8_t)code);
+			}
+		}
+	}
+	out.push_back(0xFF);
+	
+	//Get our nybbles (XORed against the row before in XOR mode), and write them in runs
+	std::vector<uint8_t> nybbles;
+	uint32_t previousRow = 0;
+	for (size_t i = 0; i + 4 <= tiles * 32; i += 4)
+	{
+		uint32_t row = ((uint32_t)in[i] << 24) | (in[i + 1] << 16) | (in[i + 2] << 8) | in[i + 3];
+		uint32_t encoded = xorMode ? (row ^ previousRow) : row;
+		previousRow = row;
+		for (int n = 7; n >= 0; n--)
+			nybbles.push_back((encoded >> (n * 4)) & 0xF);
+	}
+	
+	BITWRITER_MSB writer(out);
+	for (size_t i = 0; i < nybbles.size();)
+	{
+		unsigned int run = 1;
+		while (run < 8 && i + run < nybbles.size() && nybbles[i + run] == nybbles[i])
+			run++;
+		
+		unsigned int code = nybbles[i] * 8 + (run - 1);
+		if (code < 0x7E)
+		{
+			writer.Bits(7, code);
+		}
+		else
+		{
+			writer.Bits(6, 0x3F);
+			writer.Bits(3, run - 1);
+			writer.Bits(4, nybbles[i]);
+		}
+		i += run;
+	}
+}
+
+//Enigma
+static bool ReferenceEnigma(const std::vector<uint8_t> &in, std::vector<uint8_t> &out)
+{
+	//Read our header
+	if (in.size() < 6)
+		return false;
+	unsigned int inlineBits = in[0];
+	unsigned int flagMask = in[1];
+	uint16_t incrementing = (in[2] << 8) | in[3];
+	uint16_t common = (in[4] << 8) | in[5];
+	if (inlineBits > 11)
+		return false;
+	
+	BITREADER_MSB reader(in, 6);
+	auto Inline = [&](uint16_t *value)
+	{
+		static const uint16_t flagBits[5] = {0x8000, 0x4000, 0x2000, 0x1000, 0x0800};
+		unsigned int bit;
+		*value = 0;
+		for (int flag = 0; flag < 5; flag++)
+		{
+			if (flagMask & (0x10 >> flag))
+			{
+				if (!reader.Bits(1, &bit))
+					return false;
+				if (bit)
+					*value |= flagBits[flag];
+			}
+		}
+		if (!reader.Bits(inlineBits, &bit))
+			return false;
+		*value += bit;
+		return true;
+	};
+	auto Put = [&](uint16_t value)
+	{
+		out.push_back(value >> 8);
+		out.push_back(value & 0xFF);
+	};
+	
+	while (1)
+	{
+		//Packet type (0 and 1 are 2 bits, 4 to 7 are 3 bits) and count
+		unsigned int type, count;
+		if (!reader.Bits(1, &type))
+			return false;
+		if (type == 0)
+		{
+			if (!reader.Bits(1, &type))
+				return false;
+		}
+		else
+		{
+			if (!reader.Bits(2, &type))
+				return false;
+			type |= 4;
+		}
+		if (!reader.Bits(4, &count))
+			return false;
+		count++;
+		
+		if (type == 7 && count == 0x10)
+			return true;
+		
+		uint16_t value = 0;
+		if (type >= 4 && type <= 6 && !Inline(&value))
+			return false;
+		
+		for (unsigned int i = 0; i < count; i++)
+		{
+			if (type == 0)
+				value = incrementing++;
+			else if (type == 1)
+				value = common;
+			else if (type == 5 && i != 0)
+				value++;
+			else if (type == 6 && i != 0)
+				value--;
+			else if (type == 7 && !Inline(&value))
+				return false;
+			Put(value);
+		}
+	}
+}
+
+static void EncodeEnigma(const std::vector<uint16_t> &in, uint16_t incrementing, uint16_t common, std::vector<uint8_t> &out)
+{
+	//Header (inline values are written with every flag, and all 11 of their other bits)
+	out.clear();
+	out.push_back(11);
+	out.push_back(0x1F);
+	out.push_back(incrementing >> 8);
+	out.push_back(incrementing & 0xFF);
+	out.push_back(common >> 8);
+	out.push_back(common & 0xFF);
+	
+	BITWRITER_MSB writer(out);
+	auto Run = [&](size_t i, int step) //Length of the run of values from i that each differ from the last by step (up to 16)
+	{
+		size_t count = 1;
+		while (count < 0x10 && i + count < in.size() && in[i + count] == (uint16_t)(in[i + count - 1] + step))
+			count++;
+		return count;
+	};
+	
+	for (size_t i = 0; i < in.size();)
+	{
+		size_t count;
+		if (in[i] == incrementing)
+		{
+			//Incrementing value
+			count = Run(i, 1);
+			writer.Bits(2, 0);
+			writer.Bits(4, (unsigned int)count - 1);
+			incrementing += (uint16_t)count;
+		}
+		else if (in[i] == common)
+		{
+			//Common value
+			count = 1;
+			while (count < 0x10 && i + count < in.size() && in[i + count] == common)
+				count++;
+			writer.Bits(2, 1);
+			writer.Bits(4, (unsigned int)count - 1);
+		}
+		else
+		{
+			//Repeated, incrementing, or decrementing inline value, or separate inline values
+			size_t repeat = Run(i, 0), up = Run(i, 1), down = Run(i, -1);
+			unsigned int type;
+			if (repeat >= 2 && repeat >= up && repeat >= down)
+				type = 4, count = repeat;
+			else if (up >= 2 && up >= down)
+				type = 5, count = up;
+			else if (down >= 2)
+				type = 6, count = down;
+			else
+				type = 7, count = 1;
+			
+			if (type == 7)
+			{
+				while (count < 0xF && i + count < in.size() && in[i + count] != incrementing && in[i + count] != common && Run(i + count, 0) < 2 && Run(i + count, 1) < 2 && Run(i + count, -1) < 2)
+					count++;
+			}
+			
+			writer.Bits(3, type);
+			writer.Bits(4, (unsigned int)count - 1);
+			for (size_t v = 0; v < ((type == 7) ? count : 1); v++)
+				writer.Bits(16, in[i + v]);
+		}
+		i += count;
+	}
+	
+	//End of data
+	writer.Bits(3, 7);
+	writer.Bits(4, 0xF);
+}
+
+//Generated data (like what the formats are used for, with runs and repeats for the encoders to find)
+static std::vector<uint8_t> GenerateLevelData(size_t size)
+{
+	std::vector<uint8_t> data;
+	while (data.size() < size)
+	{
+		switch (Random(4))
+		{
+			case 0: //Random bytes
+				for (uint32_t i = Random(8) + 1; i > 0; i--)
+					data.push_back((uint8_t)Random(0x100));
+				break;
+			case 1: //Run of a byte
+				data.insert(data.end(), Random(0x40) + 2, (uint8_t)Random(0x100));
+				break;
+			default: //Repeat of earlier data
+				if (data.size() > 0)
+				{
+					size_t distance = Random((uint32_t)std::min(data.size(), (size_t)0x2000)) + 1;
+					for (uint32_t i = Random(0x100) + 2; i > 0; i--)
+						data.push_back(data[data.size() - distance]);
+				}
+				break;
+		}
+	}
+	data.resize(size);
+	return data;
+}
+
+static std::vector<uint8_t> GenerateTiles(size_t tiles)
+{
+	std::vector<uint8_t> data;
+	for (size_t i = 0; i < tiles * 8; i++)
+	{
+		//Rows mostly repeat the row above, or are made of a few runs of colours
+		if (data.size() >= 4 && Random(3) == 0)
+		{
+			data.insert(data.end(), data.end() - 4, data.end());
+			continue;
+		}
+		
+		uint32_t row = 0;
+		for (int nybble = 0; nybble < 8;)
+		{
+			uint32_t colour = Random(0x10);
+			for (int run = Random(4) + 1; run > 0 && nybble < 8; run--, nybble++)
+				row = (row << 4) | colour;
+		}
+		for (int b = 0; b < 4; b++)
+			data.push_back((uint8_t)(row >> (24 - b * 8)));
+	}
+	return data;
+}
+
+static std::vector<uint16_t> GeneratePlaneMap(size_t words, uint16_t incrementing, uint16_t common)
+{
+	std::vector<uint16_t> data;
+	while (data.size() < words)
+	{
+		uint16_t value = (uint16_t)Random(0x10000);
+		switch (Random(6))
+		{
+			case 0: //Incrementing value
+				for (uint32_t i = Random(0x20) + 1; i > 0; i--)
+					data.push_back(incrementing++);
+				break;
+			case 1: //Common value
+				data.insert(data.end(), Random(0x20) + 1, common);
+				break;
+			case 2: //Repeated value
+				data.insert(data.end(), Random(0x20) + 2, value);
+				break;
+			case 3: //Incrementing or decrementing values
+			{
+				int step = Random(2) ? 1 : -1;
+				for (uint32_t i = Random(0x20) + 2; i > 0; i--, value += step)
+					data.push_back(value);
+				break;
+			}
+			default: //Separate values
+				for (uint32_t i = Random(0x20) + 1; i > 0; i--)
+					data.push_back((uint16_t)Random(0x10000));
+				break;
+		}
+	}
+	data.resize(words);
+	return data;
+}
+
+//Benchmark
+typedef std::function<bool(const std::vector<uint8_t>&, std::vector<uint8_t>&)> DECODER;
+
+static double Time(const std::vector<uint8_t> &in, const DECODER &decoder)
+{
+	//Run the given decoder over our data until enough time has passed, returns megabytes of output a second
+	std::vector<uint8_t> out;
+	size_t bytes = 0;
+	auto start = std::chrono::steady_clock::now();
+	double ms;
+	do
+	{
+		out.clear();
+		decoder(in, out);
+		bytes += out.size();
+		ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	} while (ms < BENCH_MIN_MS);
+	return (bytes / (1024.0 * 1024.0)) / (ms / 1000.0);
+}
+
+static bool Bench(const char *name, const std::vector<uint8_t> &in, const std::vector<uint8_t> *expected, const DECODER &fast, const DECODER &reference)
+{
+	//Check both decoders give the same output (and the original data, if we know it), then time them
+	std::vector<uint8_t> fastOut, referenceOut;
+	if (!fast(in, fastOut))
+	{
+		printf("%s: FAILED (the decompressor rejected the data)\n", name);
+		return true;
+	}
+	if (!reference(in, referenceOut))
+	{
+		printf("%s: FAILED (the reference decoder rejected the data)\n", name);
+		return true;
+	}
+	if (fastOut != referenceOut || (expected != nullptr && fastOut != *expected))
+	{
+		printf("%s: FAILED (the decompressor's output doesn't match)\n", name);
+		return true;
+	}
+	
+	double fastSpeed = Time(in, fast), referenceSpeed = Time(in, reference);
+	printf("%s: %zu -> %zu bytes, %.1f MB/s (reference %.1f MB/s, %.2fx)\n", name, in.size(), fastOut.size(), fastSpeed, referenceSpeed, fastSpeed / referenceSpeed);
+	return false;
+}
+
+//Our decompressors, into vectors
+static bool FastDecoder(bool (*decompress)(const uint8_t*, size_t, ARRAY<uint8_t>*), const std::vector<uint8_t> &in, std::vector<uint8_t> &out)
+{
+	ARRAY<uint8_t> dest;
+	if (decompress(in.data(), in.size(), &dest))
+		return false;
+	out.assign(dest.entry, dest.entry + dest.arSize);
+	return true;
+}
+
+static bool FastEnigma(const uint8_t *src, size_t srcSize, ARRAY<uint8_t> *dest) { return EnigmaDecompress(src, srcSize, dest); }
+
+static const DECODER fastKosinski = [](const std::vector<uint8_t> &in, std::vector<uint8_t> &out) { return FastDecoder(&KosinskiDecompress, in, out); };
+static const DECODER fastNemesis = [](const std::vector<uint8_t> &in, std::vector<uint8_t> &out) { return FastDecoder(&NemesisDecompress, in, out); };
+static const DECODER fastEnigma = [](const std::vector<uint8_t> &in, std::vector<uint8_t> &out) { return FastDecoder(&FastEnigma, in, out); };
+
+int main(int argc, char *argv[])
+{
+	bool failed = false;
+	
+	if (argc > 1)
+	{
+		//Check and time the given files (by their extension)
+		for (int i = 1; i < argc; i++)
+		{
+			FILE *fp = fopen(argv[i], "rb");
+			if (fp == nullptr)
+			{
+				printf("%s: FAILED (couldn't open it)\n", argv[i]);
+				failed = true;
+				continue;
+			}
+			std::vector<uint8_t> in;
+			uint8_t buffer[0x1000];
+			size_t read;
+			while ((read = fread(buffer, 1, sizeof(buffer), fp)) != 0)
+				in.insert(in.end(), buffer, buffer + read);
+			fclose(fp);
+			
+			std::string path = argv[i];
+			std::string extension = (path.size() >= 4) ? path.substr(path.size() - 4) : "";
+			if (extension == ".kos")
+				failed |= Bench(argv[i], in, nullptr, fastKosinski, &ReferenceKosinski);
+			else if (extension == ".nem")
+				failed |= Bench(argv[i], in, nullptr, fastNemesis, &ReferenceNemesis);
+			else if (extension == ".eni")
+				failed |= Bench(argv[i], in, nullptr, fastEnigma, &ReferenceEnigma);
+			else
+				printf("%s: skipped (not a .kos, .nem, or .eni file)\n", argv[i]);
+		}
+	}
+	else
+	{
+		//Round-trip generated data through our encoders
+		std::vector<uint8_t> compressed;
+		
+		std::vector<uint8_t> levelData = GenerateLevelData(0x40000);
+		EncodeKosinski(levelData, compressed);
+		failed |= Bench("Kosinski", compressed, &levelData, fastKosinski, &ReferenceKosinski);
+		
+		std::vector<uint8_t> tiles = GenerateTiles(0x800);
+		EncodeNemesis(tiles, false, compressed);
+		failed |= Bench("Nemesis", compressed, &tiles, fastNemesis, &ReferenceNemesis);
+		EncodeNemesis(tiles, true, compressed);
+		failed |= Bench("Nemesis (XOR)", compressed, &tiles, fastNemesis, &ReferenceNemesis);
+		
+		std::vector<uint16_t> planeMap = GeneratePlaneMap(0x4000, 0x0400, 0x2000);
+		std::vector<uint8_t> planeBytes;
+		for (uint16_t word : planeMap)
+		{
+			planeBytes.push_back(word >> 8);
+			planeBytes.push_back(word & 0xFF);
+		}
+		EncodeEnigma(planeMap, 0x0400, 0x2000, compressed);
+		failed |= Bench("Enigma", compressed, &planeBytes, fastEnigma, &ReferenceEnigma);
+	}
+	
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,261 @@
+//Asset cooker - packs a data directory into a single asset pack for the game to memory-map
+//Usage: cooker <base path> [output pack]
+//Every file under <base path>/data is packed under its path relative to the base path (as the game opens it), and bitmaps are pre-decoded to 8-bit top-down bitmaps
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+
+#include "../Filesystem.h"
+
+//Cooked asset
+struct COOKED_ASSET
+{
+	std::string name;
+	std::vector<uint8_t> data;
+};
+
+//Byte order helpers
+static inline uint16_t GetLE16(const std::vector<uint8_t> &data, size_t offset) { return data[offset] | (data[offset + 1] << 8); }
+static inline uint32_t GetLE32(const std::vector<uint8_t> &data, size_t offset) { return GetLE16(data, offset) | ((uint32_t)GetLE16(data, offset + 2) << 16); }
+
+static inline void PutLE16(std::vector<uint8_t> &data, uint16_t val) { data.push_back(val & 0xFF); data.push_back(val >> 8); }
+static inline void PutLE32(std::vector<uint8_t> &data, uint32_t val) { PutLE16(data, val & 0xFFFF); PutLE16(data, val >> 16); }
+
+static inline void PutBE32(uint8_t *data, uint32_t val)
+{
+	for (int i = 0; i < 4; i++)
+		data[i] = (uint8_t)(val >> (8 * (3 - i)));
+}
+
+//Bitmap cooking (indexed and uncompressed bitmaps are decoded to 8-bit top-down lines, padded to a width of 4 like the game does when loading)
+static bool CookBitmap(const std::vector<uint8_t> &in, std::vector<uint8_t> &out)
+{
+	//Check our header (anything we can't decode is packed as-is, and fails in the game like the loose file would)
+	if (in.size() < 54 || in[0] != 'B' || in[1] != 'M' || GetLE32(in, 14) < 40)
+		return false;
+	
+	uint32_t pixelDataPointer = GetLE32(in, 10);
+	uint32_t infHeaderSize = GetLE32(in, 14);
+	int32_t width = (int32_t)GetLE32(in, 18);
+	int32_t height = (int32_t)GetLE32(in, 22);
+	uint16_t bpp = GetLE16(in, 28);
+	uint32_t compression = GetLE32(in, 30);
+	uint32_t colours = GetLE32(in, 46);
+	
+	if (width <= 0 || height == 0 || compression != 0 || colours == 0 || colours > 0x100 || (bpp != 1 && bpp != 4 && bpp != 8))
+		return false;
+	
+	bool topDown = height < 0;
+	if (topDown)
+		height = -height;
+	
+	size_t paletteOffset = 14 + infHeaderSize;
+	size_t stride = (((size_t)width * bpp + 31) / 32) * 4;
+	if (paletteOffset + colours * 4 > in.size() || pixelDataPointer + stride * height > in.size())
+		return false;
+	
+	//Decode our pixels
+	int32_t paddedWidth = (width + 3) & ~3;
+	std::vector<uint8_t> pixels((size_t)paddedWidth * height, 0);
+	
+	for (int32_t y = 0; y < height; y++)
+	{
+		const uint8_t *line = &in[pixelDataPointer + stride * y];
+		uint8_t *dest = &pixels[(size_t)(topDown ? y : (height - 1 - y)) * paddedWidth];
+		
+		for (int32_t x = 0; x < width; x++)
+		{
+			switch (bpp)
+			{
+				case 1:
+					dest[x] = (line[x >> 3] >> (7 - (x & 7))) & 0x1;
+					break;
+				case 4:
+					dest[x] = (line[x >> 1] >> ((x & 1) ? 0 : 4)) & 0xF;
+					break;
+				case 8:
+					dest[x] = line[x];
+					break;
+			}
+		}
+	}
+	
+	//Write our cooked bitmap (header, info header, palette, then top-down pixels)
+	uint32_t cookedPixelPointer = 14 + 40 + colours * 4;
+	out.clear();
+	out.push_back('B');
+	out.push_back('M');
+	PutLE32(out, cookedPixelPointer + (uint32_t)pixels.size());	//File size
+	PutLE32(out, 0);											//Reserved
+	PutLE32(out, cookedPixelPointer);
+	
+	PutLE32(out, 40);					//Info header size
+	PutLE32(out, (uint32_t)paddedWidth);
+	PutLE32(out, (uint32_t)-height);	//Negative height for top-down
+	PutLE16(out, 1);					//Planes
+	PutLE16(out, 8);					//Bits per pixel
+	PutLE32(out, 0);					//Uncompressed
+	PutLE32(out, (uint32_t)pixels.size());
+	PutLE32(out, 0);
+	PutLE32(out, 0);
+	PutLE32(out, colours);
+	PutLE32(out, 0);
+	
+	out.insert(out.end(), in.begin() + paletteOffset, in.begin() + paletteOffset + colours * 4);
+	out.insert(out.end(), pixels.begin(), pixels.end());
+	return true;
+}
+
+//Pack writing
+static bool WritePack(const char *path, std::vector<COOKED_ASSET> &assets)
+{
+	//Get our hash table size (at most half full, so probes stay short)
+	uint32_t slots = 1;
+	while (slots < assets.size() * 2)
+		slots <<= 1;
+	
+	//Lay out our names, then our data (aligned to 16 bytes)
+	size_t tableSize = FS_PACK_HEADER_SIZE + (size_t)slots * FS_PACK_SLOT_SIZE;
+	std::vector<uint8_t> pack(tableSize, 0);
+	std::vector<uint32_t> nameOffset, dataOffset;
+	
+	for (auto &asset : assets)
+	{
+		nameOffset.push_back((uint32_t)pack.size());
+		pack.insert(pack.end(), asset.name.begin(), asset.name.end());
+	}
+	
+	for (auto &asset : assets)
+	{
+		pack.resize((pack.size() + 0xF) & ~(size_t)0xF, 0);
+		dataOffset.push_back((uint32_t)pack.size());
+		pack.insert(pack.end(), asset.data.begin(), asset.data.end());
+	}
+	
+	if (pack.size() > UINT32_MAX)
+	{
+		printf("Pack is too large (over 4GB)\n");
+		return true;
+	}
+	
+	//Write our header and table of contents
+	memcpy(&pack[0], FS_PACK_MAGIC, 4);
+	PutBE32(&pack[4], FS_PACK_VERSION);
+	PutBE32(&pack[8], slots);
+	
+	for (size_t i = 0; i < assets.size(); i++)
+	{
+		uint32_t hash = FS_PACK::Hash(assets[i].name.c_str(), assets[i].name.length());
+		for (uint32_t v = 0;; v++)
+		{
+			uint8_t *slot = &pack[FS_PACK_HEADER_SIZE + ((hash + v) & (slots - 1)) * FS_PACK_SLOT_SIZE];
+			if (slot[8] | slot[9] | slot[10] | slot[11])
+				continue;
+			
+			PutBE32(slot + 0, hash);
+			PutBE32(slot + 4, nameOffset[i]);
+			PutBE32(slot + 8, (uint32_t)assets[i].name.length());
+			PutBE32(slot + 12, dataOffset[i]);
+			PutBE32(slot + 16, (uint32_t)assets[i].data.size());
+			break;
+		}
+	}
+	
+	//Write our pack to the output file
+	FILE *fp = fopen(path, "wb");
+	if (fp == nullptr)
+	{
+		printf("Failed to open %s for writing\n", path);
+		return true;
+	}
+	
+	bool error = fwrite(pack.data(), 1, pack.size(), fp) != pack.size();
+	fclose(fp);
+	if (error)
+		printf("Failed to write %s\n", path);
+	return error;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		printf("Usage: %s <base path> [output pack]\n", argv[0]);
+		return -1;
+	}
+	
+	std::filesystem::path basePath = argv[1];
+	std::string outputPath = (argc >= 3) ? argv[2] : (basePath / FS_PACK_NAME).string();
+	
+	//Get every file in our data directory (sorted, so packs are reproducible)
+	std::vector<std::filesystem::path> files;
+	std::error_code error;
+	for (auto &entry : std::filesystem::recursive_directory_iterator(basePath / "data", error))
+		if (entry.is_regular_file())
+			files.push_back(entry.path());
+	
+	if (error)
+	{
+		printf("Failed to read %s: %s\n", (basePath / "data").string().c_str(), error.message().c_str());
+		return -1;
+	}
+	std::sort(files.begin(), files.end());
+	
+	//Cook our assets
+	std::vector<COOKED_ASSET> assets;
+	size_t cookedBitmaps = 0;
+	
+	for (auto &file : files)
+	{
+		COOKED_ASSET asset;
+		asset.name = file.lexically_relative(basePath).generic_string();
+		
+		//Read the file
+		FILE *fp = fopen(file.string().c_str(), "rb");
+		if (fp == nullptr)
+		{
+			printf("Failed to open %s\n", file.string().c_str());
+			return -1;
+		}
+		
+		fseek(fp, 0, SEEK_END);
+		asset.data.resize((size_t)ftell(fp));
+		fseek(fp, 0, SEEK_SET);
+		bool readError = fread(asset.data.data(), 1, asset.data.size(), fp) != asset.data.size();
+		fclose(fp);
+		
+		if (readError)
+		{
+			printf("Failed to read %s\n", file.string().c_str());
+			return -1;
+		}
+		
+		//Pre-decode bitmaps
+		if (file.extension() == ".bmp")
+		{
+			std::vector<uint8_t> cooked;
+			if (CookBitmap(asset.data, cooked))
+			{
+				asset.data.swap(cooked);
+				cookedBitmaps++;
+			}
+			else
+			{
+				printf("NOTE: Packing %s as-is (not an indexed uncompressed bitmap)\n", asset.name.c_str());
+			}
+		}
+		
+		assets.push_back(std::move(asset));
+	}
+	
+	//Write our pack
+	if (WritePack(outputPath.c_str(), assets))
+		return -1;
+	
+	printf("Packed %zu assets (%zu bitmaps decoded) into %s\n", assets.size(), cookedBitmaps, outputPath.c_str());
+	return 0;
+}
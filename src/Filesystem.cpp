@@ -1,6 +1,16 @@
 #include <string>
+#ifdef WINDOWS
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
 #include "Backend/Filesystem.h"
 #include "Filesystem.h"
+#include "Compression.h"
 #include "GameConstants.h"
 #include "Error.h"
 #include "Log.h"
@@ -8,12 +18,222 @@
 std::string gBasePath;
 std::string gPrefPath;
 
+FS_PACK *gPack = nullptr;
+
+//Memory-mapped file class
+void FS_MAPPING::OpenMapping(const char *name)
+{
+	#ifdef WINDOWS
+		//Convert name to UTF-16
+		size_t nameBufferSize = MultiByteToWideChar(CP_UTF8, 0, name, -1, nullptr, 0);
+		wchar_t *nameWcharBuffer = new wchar_t[nameBufferSize];
+		MultiByteToWideChar(CP_UTF8, 0, name, -1, nameWcharBuffer, nameBufferSize);
+		
+		//Open the file with our newly converted path
+		HANDLE file = CreateFileW(nameWcharBuffer, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		delete[] nameWcharBuffer;
+		
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			fail = "Failed to open file";
+			return;
+		}
+		fileHandle = file;
+		
+		//Get our size (an empty file can't be mapped, but is valid)
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize))
+		{
+			fail = "Failed to get file size";
+			return;
+		}
+		if ((size = (size_t)fileSize.QuadPart) == 0)
+			return;
+		
+		//Map the file
+		if ((mappingHandle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) == nullptr || (data = (const uint8_t*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0)) == nullptr)
+			fail = "Failed to map file";
+	#else
+		//Open the file
+		if ((fd = open(name, O_RDONLY)) < 0)
+		{
+			fail = "Failed to open file";
+			return;
+		}
+		
+		//Get our size (an empty file can't be mapped, but is valid)
+		struct stat fileStat;
+		if (fstat(fd, &fileStat) != 0)
+		{
+			fail = "Failed to get file size";
+			return;
+		}
+		if ((size = (size_t)fileStat.st_size) == 0)
+			return;
+		
+		//Map the file
+		void *mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+		if (mapped == MAP_FAILED)
+		{
+			fail = "Failed to map file";
+			return;
+		}
+		data = (const uint8_t*)mapped;
+	#endif
+}
+
+FS_MAPPING::~FS_MAPPING()
+{
+	//Unmap and close our file
+	#ifdef WINDOWS
+		if (data != nullptr)
+			UnmapViewOfFile(data);
+		if (mappingHandle != nullptr)
+			CloseHandle(mappingHandle);
+		if (fileHandle != nullptr)
+			CloseHandle(fileHandle);
+	#else
+		if (data != nullptr)
+			munmap((void*)data, size);
+		if (fd >= 0)
+			close(fd);
+	#endif
+}
+
+//Asset pack class
+static inline uint32_t ReadPackBE32(const uint8_t *data)
+{
+	return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+}
+
+FS_PACK::FS_PACK(std::string name) : mapping(name)
+{
+	if (mapping.fail != nullptr)
+	{
+		fail = mapping.fail;
+		return;
+	}
+	
+	//Check our header
+	if (mapping.size < FS_PACK_HEADER_SIZE || memcmp(mapping.data, FS_PACK_MAGIC, 4) != 0)
+	{
+		fail = "Not an asset pack (invalid header)";
+		return;
+	}
+	if (ReadPackBE32(mapping.data + 4) != FS_PACK_VERSION)
+	{
+		fail = "Asset pack is from a different version of the cooker";
+		return;
+	}
+	
+	//Get our hash table (the size must be a power of 2 for lookups to wrap)
+	uint32_t packSlots = ReadPackBE32(mapping.data + 8);
+	if (packSlots == 0 || (packSlots & (packSlots - 1)) != 0 || (mapping.size - FS_PACK_HEADER_SIZE) / FS_PACK_SLOT_SIZE < packSlots)
+	{
+		fail = "Asset pack has an invalid table of contents";
+		return;
+	}
+	slots = packSlots;
+}
+
+bool FS_PACK::Find(const char *name, const uint8_t **data, size_t *size)
+{
+	if (slots == 0)
+		return false;
+	
+	//Get our path relative to the base path
+	if (strncmp(name, gBasePath.c_str(), gBasePath.length()) == 0)
+		name += gBasePath.length();
+	size_t length = strlen(name);
+	uint32_t hash = Hash(name, length);
+	
+	//Find our slot, probing from where our hash lands until we reach an empty slot
+	for (uint32_t i = 0; i < slots; i++)
+	{
+		const uint8_t *slot = mapping.data + FS_PACK_HEADER_SIZE + ((hash + i) & (slots - 1)) * FS_PACK_SLOT_SIZE;
+		uint32_t nameLength = ReadPackBE32(slot + 8);
+		if (nameLength == 0)
+			return false;
+		if (ReadPackBE32(slot + 0) != hash || nameLength != length)
+			continue;
+		
+		//Check our name (and that it and our data are within the pack)
+		uint32_t nameOffset = ReadPackBE32(slot + 4);
+		uint32_t dataOffset = ReadPackBE32(slot + 12);
+		uint32_t dataSize = ReadPackBE32(slot + 16);
+		if (nameOffset > mapping.size || nameLength > mapping.size - nameOffset || dataOffset > mapping.size || dataSize > mapping.size - dataOffset)
+			return false;
+		if (memcmp(mapping.data + nameOffset, name, length) != 0)
+			continue;
+		
+		*data = mapping.data + dataOffset;
+		*size = dataSize;
+		return true;
+	}
+	return false;
+}
+
+//Compressed files
+bool FS_FILE::OpenCompressed(const char *name)
+{
+	static const struct
+	{
+		const char *extension;
+		bool (*decompress)(const uint8_t *src, size_t srcSize, ARRAY<uint8_t> *dest);
+	} formats[] = {
+		{".kos", &KosinskiDecompress},
+		{".nem", &NemesisDecompress},
+		{".eni", [](const uint8_t *src, size_t srcSize, ARRAY<uint8_t> *dest) { return EnigmaDecompress(src, srcSize, dest); }},
+	};
+	
+	for (auto &format : formats)
+	{
+		//Get our compressed data from the pack, or map it
+		std::string compressedName = std::string(name) + format.extension;
+		const uint8_t *compressedData;
+		size_t compressedSize;
+		FS_MAPPING *compressedMapping = nullptr;
+		
+		if (gPack == nullptr || !gPack->Find(compressedName.c_str(), &compressedData, &compressedSize))
+		{
+			compressedMapping = new FS_MAPPING(compressedName);
+			if (compressedMapping->fail != nullptr)
+			{
+				delete compressedMapping;
+				continue;
+			}
+			compressedData = compressedMapping->data;
+			compressedSize = compressedMapping->size;
+		}
+		
+		//Decompress it, and read from our decompressed data
+		if (format.decompress(compressedData, compressedSize, &decompressed))
+			fail = "Failed to decompress file";
+		delete compressedMapping;
+		
+		buffer = decompressed.entry;
+		bufferSize = decompressed.size();
+		return true;
+	}
+	return false;
+}
+
 //Sub-system functions
 bool InitializePath()
 {
 	LOG(("Initializing paths... "));
 	if (Backend_GetPaths(&gBasePath, &gPrefPath))
 		return Error("Failed to initialize paths");
+	
+	//Use our asset pack if there is one, otherwise assets are read from loose files
+	gPack = new FS_PACK(gBasePath + FS_PACK_NAME);
+	if (gPack->fail != nullptr)
+	{
+		LOG(("NOTE: Using loose asset files - %s... ", gPack->fail));
+		delete gPack;
+		gPack = nullptr;
+	}
+	
 	LOG(("Success!\n"));
 	return false;
 }
@@ -21,6 +241,10 @@ bool InitializePath()
 void QuitPath()
 {
 	LOG(("Ending paths... "));
-	//...
+	
+	//Unmount our asset pack
+	delete gPack;
+	gPack = nullptr;
+	
 	LOG(("Success!\n"));
 }
@@ -2,12 +2,71 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 #include <string>
 
+#include "Array.h"
+
 //Path globals
 extern std::string gBasePath;
 extern std::string gPrefPath;
 
+//Memory-mapped file class (read-only, the file is paged in by the OS as it's accessed)
+class FS_MAPPING
+{
+	public:
+		const char *fail = nullptr;
+		const uint8_t *data = nullptr;
+		size_t size = 0;
+	private:
+		#ifdef WINDOWS
+			void *fileHandle = nullptr;
+			void *mappingHandle = nullptr;
+		#else
+			int fd = -1;
+		#endif
+	public:
+		//Constructor and destructor - Map and unmap file
+		FS_MAPPING(const char *name) { OpenMapping(name); }
+		FS_MAPPING(std::string name) { OpenMapping(name.c_str()); }
+		~FS_MAPPING();
+	
+	private:
+		void OpenMapping(const char *name);
+};
+
+//Asset pack class (a single memory-mapped file of cooked assets, looked up by their path relative to the base path)
+#define FS_PACK_NAME		"data.pack"
+#define FS_PACK_MAGIC		"CSPK"
+#define FS_PACK_VERSION		1
+#define FS_PACK_HEADER_SIZE	0x10
+#define FS_PACK_SLOT_SIZE	0x14	//Hash, name offset, name length, data offset, and data size (all big-endian 32-bit)
+
+class FS_PACK
+{
+	public:
+		const char *fail = nullptr;
+	private:
+		FS_MAPPING mapping;
+		uint32_t slots = 0;	//Hash table slots (a power of 2, empty slots have a name length of 0)
+	public:
+		FS_PACK(std::string name);
+		
+		//Get the data of the asset at the given path, which is either relative to or within the base path (returns false if not in the pack)
+		bool Find(const char *name, const uint8_t **data, size_t *size);
+		
+		static inline uint32_t Hash(const char *name, size_t length)
+		{
+			//FNV-1a
+			uint32_t hash = 0x811C9DC5;
+			for (size_t i = 0; i < length; i++)
+				hash = (hash ^ (uint8_t)name[i]) * 0x01000193;
+			return hash;
+		}
+};
+
+extern FS_PACK *gPack;
+
 //File class
 #ifdef WINDOWS //Include Windows stuff, required for opening the files with UTF-16 paths
 	#include <wchar.h>
@@ -19,6 +78,15 @@ class FS_FILE
 	public:
 		const char *fail = nullptr;
 		FILE *fp = nullptr;
+		
+		//Files opened for reading only are read from our asset pack or memory-mapped, then read from memory rather than through the C library a value at a time
+		FS_MAPPING *mapping = nullptr;
+		const uint8_t *buffer = nullptr;
+		size_t bufferSize = 0;
+		size_t bufferPos = 0;
+		
+		//Decompressed data, if the file was only found compressed (see OpenCompressed)
+		ARRAY<uint8_t> decompressed;
 	public:
 		//Constructor - Open file
 		FS_FILE(const char *name, const char *mode) { OpenFile(name, mode); }
@@ -28,12 +96,33 @@ class FS_FILE
 		~FS_FILE()
 		{
 			//Close our opened file
-			fclose(fp);
+			if (fp != nullptr)
+				fclose(fp);
+			delete mapping;
 		}
 		
 		//File open function
 		inline void OpenFile(const char *name, const char *mode)
 		{
+			//Read files that are only being read from our asset pack if they're in it, otherwise map them
+			if (mode[0] == 'r' && strchr(mode, '+') == nullptr)
+			{
+				if (gPack != nullptr && gPack->Find(name, &buffer, &bufferSize))
+					return;
+				
+				mapping = new FS_MAPPING(name);
+				if (mapping->fail != nullptr)
+				{
+					if (!OpenCompressed(name))
+						fail = mapping->fail;
+					return;
+				}
+				
+				buffer = mapping->data;
+				bufferSize = mapping->size;
+				return;
+			}
+			
 			//Open the given file
 			#ifdef WINDOWS
 				//Convert name to UTF-16
@@ -60,60 +149,139 @@ class FS_FILE
 				fail = "Failed to open file";
 		}
 		
+		//Compressed file open function (reads and decompresses name + ".kos", ".nem", or ".eni" if one exists, returns false if there isn't one)
+		bool OpenCompressed(const char *name);
+		
 		//Read functions
 		//Any size
-		inline size_t Read(void *ptr, size_t size, size_t maxnum)	{ return fread(ptr, size, maxnum, fp); }
+		inline size_t Read(void *ptr, size_t size, size_t maxnum)
+		{
+			if (fp != nullptr)
+				return fread(ptr, size, maxnum, fp);
+			
+			//Copy as many whole values as are left
+			if (size == 0)
+				return 0;
+			size_t num = (bufferSize - bufferPos) / size;
+			if (num > maxnum)
+				num = maxnum;
+			if (num != 0)
+				memcpy(ptr, buffer + bufferPos, num * size);
+			bufferPos += num * size;
+			return num;
+		}
+		
+		//Span of the given size, read in place (nullptr if the file isn't in memory or too short, in which case nothing is read)
+		inline const uint8_t *ReadSpan(size_t size)
+		{
+			if (fp != nullptr || size > bufferSize - bufferPos)
+				return nullptr;
+			const uint8_t *span = buffer + bufferPos;
+			bufferPos += size;
+			return span;
+		}
 		
 		//One byte
 		inline uint8_t	ReadU8()
 		{
-			return fgetc(fp);
+			if (fp != nullptr)
+				return fgetc(fp);
+			return (bufferPos < bufferSize) ? buffer[bufferPos++] : 0xFF;
 		}
 		
 		//Multi-byte big endian
 		inline uint16_t	ReadBE16()
 		{
-			uint8_t bytes[2];
+			uint8_t bytes[2] = {0};
 			Read(bytes, 1, 2);
 			return ((uint16_t)bytes[0] << 8) | bytes[1];
 		}
 		
 		inline uint32_t	ReadBE32()
 		{
-			uint8_t bytes[4];
+			uint8_t bytes[4] = {0};
 			Read(bytes, 1, 4);
 			return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) | ((uint16_t)bytes[2] << 8) | bytes[3];
 		}
 		
 		inline uint64_t	ReadBE64()
 		{
-			uint8_t bytes[8];
+			uint8_t bytes[8] = {0};
 			Read(bytes, 1, 8);
-			return ((uint64_t)bytes[0] << 56) | ((uint64_t)bytes[1] << 48) | ((uint64_t)bytes[2] << 40) | ((uint64_t)bytes[3] << 32) | ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) | ((uint16_t)bytes[2] << 8) | bytes[3];
+			return ((uint64_t)bytes[0] << 56) | ((uint64_t)bytes[1] << 48) | ((uint64_t)bytes[2] << 40) | ((uint64_t)bytes[3] << 32) | ((uint32_t)bytes[4] << 24) | ((uint32_t)bytes[5] << 16) | ((uint16_t)bytes[6] << 8) | bytes[7];
 		}
 		
 		//Multi-byte little endian
 		inline uint16_t	ReadLE16()
 		{
-			uint8_t bytes[2];
+			uint8_t bytes[2] = {0};
 			Read(bytes, 1, 2);
 			return ((uint16_t)bytes[1] << 8) | bytes[0];
 		}
 		
 		inline uint32_t	ReadLE32()
 		{
-			uint8_t bytes[4];
+			uint8_t bytes[4] = {0};
 			Read(bytes, 1, 4);
 			return ((uint32_t)bytes[3] << 24) | ((uint32_t)bytes[2] << 16) | ((uint16_t)bytes[1] << 8) | bytes[0];
 		}
 		
 		inline uint64_t	ReadLE64()
 		{
-			uint8_t bytes[8];
+			uint8_t bytes[8] = {0};
 			Read(bytes, 1, 8);
 			return ((uint64_t)bytes[7] << 56) | ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[5] << 40) | ((uint64_t)bytes[4] << 32) | ((uint32_t)bytes[3] << 24) | ((uint32_t)bytes[2] << 16) | ((uint16_t)bytes[1] << 8) | bytes[0];
 		}
 		
+		//Multi-byte arrays (read in one go, then converted to the host's byte order in a single pass, returns the number of values read)
+		inline size_t ReadBE16Array(uint16_t *ptr, size_t maxnum)
+		{
+			size_t num = Read(ptr, 2, maxnum);
+			#ifndef ENDIAN_BIG
+				SwapArray16(ptr, num);
+			#endif
+			return num;
+		}
+		
+		inline size_t ReadBE32Array(uint32_t *ptr, size_t maxnum)
+		{
+			size_t num = Read(ptr, 4, maxnum);
+			#ifndef ENDIAN_BIG
+				SwapArray32(ptr, num);
+			#endif
+			return num;
+		}
+		
+		inline size_t ReadLE16Array(uint16_t *ptr, size_t maxnum)
+		{
+			size_t num = Read(ptr, 2, maxnum);
+			#ifdef ENDIAN_BIG
+				SwapArray16(ptr, num);
+			#endif
+			return num;
+		}
+		
+		inline size_t ReadLE32Array(uint32_t *ptr, size_t maxnum)
+		{
+			size_t num = Read(ptr, 4, maxnum);
+			#ifdef ENDIAN_BIG
+				SwapArray32(ptr, num);
+			#endif
+			return num;
+		}
+		
+		static inline void SwapArray16(uint16_t *ptr, size_t num)
+		{
+			for (size_t i = 0; i < num; i++)
+				ptr[i] = (uint16_t)((ptr[i] << 8) | (ptr[i] >> 8));
+		}
+		
+		static inline void SwapArray32(uint32_t *ptr, size_t num)
+		{
+			for (size_t i = 0; i < num; i++)
+				ptr[i] = (ptr[i] << 24) | ((ptr[i] << 8) & 0x00FF0000) | ((ptr[i] >> 8) & 0x0000FF00) | (ptr[i] >> 24);
+		}
+		
 		//Write functions
 		//Any size
 		inline size_t Write(const void *ptr, size_t size, size_t maxnum)	{ return fwrite(ptr, size, maxnum, fp); }
@@ -163,11 +331,28 @@ class FS_FILE
 		}
 		
 		//Seek and tell functions
-		inline int Seek(long int offset, int origin)	{ return fseek(fp, offset, origin); }
-		inline size_t Tell()							{ return ftell(fp); }
+		inline int Seek(long int offset, int origin)
+		{
+			if (fp != nullptr)
+				return fseek(fp, offset, origin);
+			
+			//Get our new position, failing if out of range
+			long int base = (origin == SEEK_SET) ? 0 : ((origin == SEEK_CUR) ? (long int)bufferPos : (long int)bufferSize);
+			if (base + offset < 0 || base + offset > (long int)bufferSize)
+				return -1;
+			bufferPos = (size_t)(base + offset);
+			return 0;
+		}
+		
+		inline size_t Tell() { return (fp == nullptr) ? bufferPos : ftell(fp); }
 		
 		//Size function
-		inline size_t GetSize()	{ size_t origP = Tell(); Seek(0, SEEK_END); size_t size = Tell(); Seek(origP, SEEK_SET); return size; }
+		inline size_t GetSize()
+		{
+			if (fp == nullptr)
+				return bufferSize;
+			size_t origP = Tell(); Seek(0, SEEK_END); size_t size = Tell(); Seek(origP, SEEK_SET); return size;
+		}
 };
 
 //Sub-system functions
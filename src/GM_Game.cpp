@@ -7,8 +7,12 @@
 #include "Render.h"
 #include "Fade.h"
 #include "Level.h"
+#include "Rewind.h"
+#include "Netplay.h"
+#include "Benchmark.h"
 
 LEVEL *gLevel;
+LEVELPREFETCH *gLevelPrefetch;
 
 int gGameLoadLevel = 0;
 int gGameLoadCharacter = 0;
@@ -18,6 +22,8 @@ static const char *sonicAndTails[] =	{"data/Sonic/Sonic", "data/Tails/Tails", nu
 static const char *tailsOnly[] =		{"data/Knuckles/Knuckles", nullptr};
 static const char *knucklesOnly[] =		{"data/Knuckles/Knuckles", nullptr};
 
+static const char *netplayPlayers[] =	{"data/Sonic/Sonic", "data/Sonic/Sonic", nullptr};	//The host is player 1, and who joins is player 2
+
 static const char **characterSetList[] = {
 	sonicOnly,
 	sonicAndTails,
@@ -25,16 +31,48 @@ static const char **characterSetList[] = {
 	knucklesOnly,
 };
 
+static const char **GetCharacterSet()
+{
+	//Netplay always has its two players, otherwise use the selected characters
+	return (gNetplay != nullptr) ? netplayPlayers : characterSetList[gGameLoadCharacter];
+}
+
+static void DropLevelPrefetch()
+{
+	//Stop and free our next level's prefetch
+	if (gLevelPrefetch != nullptr)
+	{
+		delete gLevelPrefetch;
+		gLevelPrefetch = nullptr;
+	}
+}
+
 bool GM_Game(bool *bError)
 {
 	//Load level with characters given
-	gLevel = new LEVEL(gGameLoadLevel, characterSetList[gGameLoadCharacter]);
+	gLevel = new LEVEL(gGameLoadLevel, GetCharacterSet());
+	if (gLevel->quit)
+	{
+		delete gLevel;
+		DropLevelPrefetch();
+		return true;
+	}
 	if (gLevel->fail != nullptr)
+	{
+		DropLevelPrefetch();
 		return (*bError = true);
+	}
 	
 	//Fade level from black
 	gLevel->SetFade(true, false);
 	
+	//Our rewind history (not when playing online, where our level has to stay in step with our peer's, or benchmarking)
+	REWIND *rewind = (gNetplay == nullptr && gBenchmark == nullptr) ? new REWIND() : nullptr;
+	
+	//Wait for our netplay peer to be in this level too
+	if (gNetplay != nullptr)
+		*bError = gNetplay->Start();
+	
 	//Our loop
 	bool bExit = false;
 	
@@ -43,29 +81,51 @@ bool GM_Game(bool *bError)
 		//Handle events
 		bExit = HandleEvents();
 		
-		//Update level
-		if ((*bError = gLevel->Update()) == true)
-			break;
+		//Update the level through netplay if we're online (which may re-simulate past frames first, or wait for our peer instead)
+		if (gNetplay != nullptr)
+		{
+			if ((*bError = gNetplay->Advance()) == true)
+				break;
+			if (gNetplay->SoakDone())
+				bExit = true;
+		}
+		//Update the level with the benchmark's input, timing it
+		else if (gBenchmark != nullptr)
+		{
+			if ((*bError = gBenchmark->Advance()) == true)
+				break;
+			if (gBenchmark->Done())
+				bExit = true;
+		}
+		//Rewind while the rewind key is held, otherwise update the level and capture it into our rewind history
+		else if (!gLevel->fading && IsKeyHeld(REWIND_KEY) && rewind->CanStepBack())
+		{
+			if ((*bError = rewind->StepBack()) == true)
+				break;
+		}
+		else
+		{
+			//Update level
+			if ((*bError = gLevel->Update()) == true)
+				break;
+			rewind->Capture(); //Failing only disables rewinding
+		}
 		
-		//Handle level fading
+		//Prefetch the next level once we're near the end of this one
+		if (gLevelPrefetch == nullptr && gLevel->IsNearEnd())
+			gLevelPrefetch = new LEVELPREFETCH((gLevel->levelId + 1) % LEVELID_MAX, GetCharacterSet());
+		
+		//Handle level fading (online, fading is part of each simulated frame, and we leave once the frame our fade out finished on is confirmed, so both sides leave together)
 		bool breakThisState = false;
 		
-		if (gLevel->fading)
-		{
-			if (gLevel->isFadingIn)
-			{
-				gLevel->fading = !gLevel->UpdateFade();
-			}
-			else
-			{
-				//Fade out and enter next game state
-				if (gLevel->UpdateFade())
-				{
-					gGameMode = gLevel->specialFade ? GAMEMODE_SPECIALSTAGE : (gGameMode == GAMEMODE_DEMO ? GAMEMODE_SPLASH : GAMEMODE_GAME);
-					breakThisState = true;
-				}
-			}
-		}
+		if (gNetplay != nullptr)
+			breakThisState = gNetplay->LevelDone();
+		else if (gLevel->fading)
+			breakThisState = gLevel->StepFade();
+		
+		//Enter next game state once we've faded out
+		if (breakThisState)
+			gGameMode = gLevel->specialFade ? GAMEMODE_SPECIALSTAGE : (gGameMode == GAMEMODE_DEMO ? GAMEMODE_SPLASH : GAMEMODE_GAME);
 		
 		//Draw level to the screen
 		gLevel->Draw();
@@ -79,7 +139,12 @@ bool GM_Game(bool *bError)
 			break;
 	}
 	
-	//Unload level and exit
+	//Unload level and exit (dropping our prefetch if we're not going to another level)
+	if (gNetplay != nullptr)
+		gNetplay->End();
+	delete rewind;
 	delete gLevel;
+	if (bExit || *bError || gGameMode != GAMEMODE_GAME)
+		DropLevelPrefetch();
 	return bExit;
 }
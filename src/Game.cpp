@@ -2,6 +2,8 @@
 #include "Log.h"
 #include "Error.h"
 #include "GM.h"
+#include "Netplay.h"
+#include "Benchmark.h"
 
 //Debug bool
 bool gDebugEnabled = false;
@@ -105,6 +107,10 @@ bool EnterGameLoop()
 	gNextRingReward = RINGS_REWARD;
 	gLives = INITIAL_LIVES;
 	
+	//Netplay and the benchmark go straight into the game
+	if (gNetplay != nullptr || gBenchmark != nullptr)
+		gGameMode = GAMEMODE_GAME;
+	
 	//Run game code
 	bool bExit = false;
 	bool bError = false;
@@ -27,6 +27,7 @@ extern unsigned int gLives;
 //Gamemode and level state
 extern GAMEMODE gGameMode;
 extern LEVEL *gLevel;
+extern LEVELPREFETCH *gLevelPrefetch;
 
 extern int gGameLoadLevel;
 extern int gGameLoadCharacter;
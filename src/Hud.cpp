@@ -1,4 +1,6 @@
 #include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
 
 #include "Hud.h"
 #include "Level.h"
@@ -28,7 +30,7 @@
 HUD::HUD()
 {
 	//Load HUD texture
-	texture = gLevel->GetObjectTexture("data/HUD.bmp");
+	texture = gLevel->GetObjectTexture(TEXTUREID_HUD);
 	if (texture->fail != nullptr)
 	{
 		Error(fail = texture->fail);
@@ -36,7 +38,7 @@ HUD::HUD()
 	}
 	
 	//Load font
-	TEXTURE *fontTexture = gLevel->GetObjectTexture("data/GenericFont.bmp");
+	TEXTURE *fontTexture = gLevel->GetObjectTexture(TEXTUREID_GENERICFONT);
 	font = new BITMAPFONT(fontTexture, 0, 49, 8, 11, 0, 0, 0x20, 0x20);
 }
 
@@ -53,8 +55,29 @@ void HUD::DrawLabel(int xPos, int yPos, int srcX, int srcY)
 	gSoftwareBuffer->DrawTexture(texture, texture->loadedPalette, &src, LEVEL_RENDERLAYER_HUD, xPos, yPos, false, false);
 }
 
+//Format a string into the level's frame arena (only valid until the next frame)
+static const char *FrameString(const char *format, ...)
+{
+	//Get the length of our formatted string
+	va_list args;
+	va_start(args, format);
+	int length = vsnprintf(nullptr, 0, format, args);
+	va_end(args);
+	if (length < 0)
+		return "";
+	
+	//Allocate and format
+	char *string = gLevel->frameArena.Alloc<char>(length + 1);
+	if (string == nullptr)
+		return "";
+	
+	va_start(args, format);
+	vsnprintf(string, length + 1, format, args);
+	va_end(args);
+	return string;
+}
+
 //Core draw function
-#define PAD_NUMBER_STRING(padString, len) (std::string(len - padString.length(), '0').append(padString))
 
 void HUD::Draw()
 {
@@ -78,26 +101,26 @@ void HUD::Draw()
 	DrawLabel(LIVES_LEFT,	LIVES_Y,	3, 0);
 	
 	//Draw score value
-	std::string score = std::to_string(gScore);
-	font->DrawString(score, LEVEL_RENDERLAYER_HUD, SCORE_RIGHT - (8 * score.length()), SCORE_Y);
+	const char *score = FrameString("%u", gScore);
+	font->DrawString(score, LEVEL_RENDERLAYER_HUD, SCORE_RIGHT - (8 * strlen(score)), SCORE_Y);
 	
 	//Draw time value
-	std::string mins = std::to_string((gTime / 60) / 60);
-	std::string secs = std::to_string((gTime / 60) % 60);
+	unsigned int mins = (gTime / 60) / 60;
+	unsigned int secs = (gTime / 60) % 60;
 	
 	#ifdef SONICCD_LONG_TIME
-		std::string mils = std::to_string((gTime * 100 / 60) % 100);
-		std::string time = mins + "'" + PAD_NUMBER_STRING(secs, 2) + "\"" + PAD_NUMBER_STRING(mils, 2); //M'ss"mm
+		unsigned int mils = (gTime * 100 / 60) % 100;
+		const char *time = FrameString("%u'%02u\"%02u", mins, secs, mils); //M'ss"mm
 	#else
-		std::string time = mins + ":" + PAD_NUMBER_STRING(secs, 2); //M:ss
+		const char *time = FrameString("%u:%02u", mins, secs); //M:ss
 	#endif
 	
-	font->DrawString(time, LEVEL_RENDERLAYER_HUD, TIME_RIGHT - (8 * time.length()), TIME_Y);
+	font->DrawString(time, LEVEL_RENDERLAYER_HUD, TIME_RIGHT - (8 * strlen(time)), TIME_Y);
 	
 	//Draw rings value
-	std::string rings = std::to_string(gRings);
-	font->DrawString(rings, LEVEL_RENDERLAYER_HUD, RINGS_RIGHT - (8 * rings.length()), RINGS_Y);
+	const char *rings = FrameString("%u", gRings);
+	font->DrawString(rings, LEVEL_RENDERLAYER_HUD, RINGS_RIGHT - (8 * strlen(rings)), RINGS_Y);
 	
 	//Draw lives value
-	font->DrawString(std::to_string(gLives), LEVEL_RENDERLAYER_HUD, LIVES_NUM_LEFT, LIVES_Y + 2);
+	font->DrawString(FrameString("%u", gLives), LEVEL_RENDERLAYER_HUD, LIVES_NUM_LEFT, LIVES_Y + 2);
 }
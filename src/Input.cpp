@@ -160,6 +160,12 @@ void UpdateInput()
 		gController[i].Update(i);
 }
 
+bool IsKeyHeld(INPUTBINDKEY key)
+{
+	//Check a key directly (for keys outside of the controller bindings, such as rewinding)
+	return Backend_IsKeyDown(key);
+}
+
 //Subsystem initialization and quitting
 bool InitializeInput()
 {
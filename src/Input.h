@@ -383,6 +383,7 @@ extern CONTROLLER gController[CONTROLLERS];
 //Subsystem functions
 void ClearControllerInput();
 void UpdateInput();
+bool IsKeyHeld(INPUTBINDKEY key);
 
 bool InitializeInput();
 void QuitInput();
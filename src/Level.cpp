@@ -1,5 +1,8 @@
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "Filesystem.h"
 #include "Audio.h"
@@ -9,16 +12,40 @@
 #include "Fade.h"
 #include "Error.h"
 #include "Log.h"
+#include "Event.h"
+#include "LoadJobs.h"
+#include "AssetCache.h"
+#include "SaveState.h"
 
 //Object function lists
 #include "Objects.h"
 
+#define SONIC1_OBJECTID_RINGS	0x25	//Sonic 1 places rings as objects, these are passed to the ring manager instead
+
+//Batched object update options (see gBatchObjects and gCheckObjectBatching)
+bool gBatchObjects = false;
+bool gCheckObjectBatching = false;
+
+//Object functions that can be updated in batches (they must only touch their own state, shared state in an order-independent way like adding to the ring count,
+//and their parent only if its batch comes first, and must spawn through LinkObject)
+//Anything that reads or moves players (solids like monitors and platforms, and badniks that look for players) depends on the objects updated before it, so isn't here
+OBJECTFUNCTION objFuncBatched[OBJECT_BATCHES] = {
+	&ObjRing,
+	&ObjSonic1Scenery,
+	&ObjMotobug,
+	&ObjChopper,
+	&ObjCrabmeat,
+	&ObjCrabmeatProjectile,
+	&ObjBuzzBomberMissile,
+	&ObjNewtronMissile,
+};
+
 OBJECTFUNCTION objFuncSonic1[] = {
 	nullptr, nullptr, nullptr, &ObjPathSwitcher, nullptr, nullptr, nullptr, nullptr,
 	nullptr, nullptr, nullptr, nullptr, nullptr, &ObjGoalpost, nullptr, nullptr,
 	nullptr, &ObjBridge, nullptr, nullptr, nullptr, &ObjGHZSwingingPlatform, nullptr, &ObjGHZSpikeLog,
 	&ObjGHZPlatform, nullptr, &ObjGHZLedge, nullptr, &ObjSonic1Scenery, nullptr, nullptr, &ObjCrabmeat,
-	nullptr, nullptr, &ObjBuzzBomber, nullptr, nullptr, &ObjRingSpawner, &ObjMonitor, nullptr,
+	nullptr, nullptr, &ObjBuzzBomber, nullptr, nullptr, nullptr, &ObjMonitor, nullptr,
 	nullptr, nullptr, nullptr, &ObjChopper, nullptr, nullptr, nullptr, nullptr,
 	nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, &ObjGHZSpikes, nullptr,
 	nullptr, nullptr, nullptr, &ObjGHZPurpleRock, &ObjGHZSmashableWall, nullptr, nullptr, nullptr,
@@ -73,6 +100,10 @@ std::string preloadTexture[] = {
 	"data/Object/Generic.bmp",
 	//Player objects / effects
 	"data/Object/PlayerGeneric.bmp",
+	//Title card and HUD
+	"data/TitleCard.bmp",
+	"data/GenericFont.bmp",
+	"data/HUD.bmp",
 	"",
 };
 
@@ -198,7 +229,7 @@ bool LEVEL::LoadMappings(LEVELTABLE *tableEntry)
 			
 			//Allocate the chunk mappings in memory
 			chunks = (mappingFile.GetSize() / 2 / (8 * 8));
-			chunkMapping = new CHUNKMAPPING[chunks];
+			chunkMapping = LevelAlloc<CHUNKMAPPING>(chunks);
 			
 			if (chunkMapping == nullptr)
 			{
@@ -207,11 +238,14 @@ bool LEVEL::LoadMappings(LEVELTABLE *tableEntry)
 			}
 			
 			//Read the mapping data
+			uint16_t *mappingData = new uint16_t[chunks * (8 * 8)];
+			mappingFile.ReadBE16Array(mappingData, chunks * (8 * 8));
+			
 			for (size_t i = 0; i < chunks; i++)
 			{
 				for (int v = 0; v < (8 * 8); v++)
 				{
-					uint16_t tmap = mappingFile.ReadBE16();
+					uint16_t tmap = mappingData[i * (8 * 8) + v];
 					chunkMapping[i].tile[v].altLRB	= (tmap & 0x8000) != 0;
 					chunkMapping[i].tile[v].altTop	= (tmap & 0x4000) != 0;
 					chunkMapping[i].tile[v].norLRB	= (tmap & 0x2000) != 0;
@@ -219,9 +253,10 @@ bool LEVEL::LoadMappings(LEVELTABLE *tableEntry)
 					chunkMapping[i].tile[v].yFlip	= (tmap & 0x0800) != 0;
 					chunkMapping[i].tile[v].xFlip	= (tmap & 0x0400) != 0;
 					chunkMapping[i].tile[v].tile	= (tmap & 0x3FF);
-					chunkMapping[i].tile[v].srcChunk = i;
 				}
 			}
+			
+			delete[] mappingData;
 			break;
 		}
 		
@@ -251,75 +286,161 @@ bool LEVEL::LoadLayout(LEVELTABLE *tableEntry)
 	{
 		case LEVELFORMAT_CHUNK128_SONIC2:
 		case LEVELFORMAT_CHUNK128:
-			//Get our level dimensions (upscaled to tiles)
+		{
+			//Get our level dimensions
 			if (tableEntry->format == LEVELFORMAT_CHUNK128)
 			{
-				layout.width = layoutFile.ReadBE16() * 8;
-				layout.height = layoutFile.ReadBE16() * 8;
+				layout.chunkWidth = layoutFile.ReadBE16();
+				layout.chunkHeight = layoutFile.ReadBE16();
 			}
 			else
 			{
-				layout.width = 0x80 * 8;
-				layout.height = 0x10 * 8;
+				layout.chunkWidth = 0x80;
+				layout.chunkHeight = 0x10;
+			}
+			
+			layout.width = layout.chunkWidth * 8;
+			layout.height = layout.chunkHeight * 8;
+			
+			if (layout.width == 0 || layout.height == 0)
+			{
+				Error(fail = "Layout has invalid dimensions");
+				return true;
+			}
+			if (layout.width * 16 > LAYOUT_MAX_PIXELS || layout.height * 16 > LAYOUT_MAX_PIXELS)
+			{
+				Error(fail = "Layout is too large (world positions are 16-bit)");
+				return true;
 			}
 			
 			//Allocate our layout
-			layout.foreground = new TILE[layout.width * layout.height];
-			if (layout.foreground == nullptr)
+			uint16_t *layoutChunk = LevelAlloc<uint16_t>(layout.chunkWidth * layout.chunkHeight);
+			if (layoutChunk == nullptr)
 			{
 				Error(fail = "Failed to allocate layout in memory");
 				return true;
 			}
+			layout.chunk = layoutChunk;
 			
-			//Read our layout file and convert to tiles
-			for (size_t cy = 0; cy < layout.height; cy += 8)
+			//Read our layout file
+			for (size_t cy = 0; cy < layout.chunkHeight; cy++)
 			{
-				//Read foreground line
-				for (size_t cx = 0; cx < layout.width; cx += 8)
+				//Read foreground and background line (background not used)
+				const uint8_t *line = layoutFile.ReadSpan(layout.chunkWidth * 2);
+				if (line == nullptr)
 				{
-					//Read our chunk index
-					uint8_t chunk = layoutFile.ReadU8();
-					
-					//Get our tiles
-					for (int tv = 0; tv < 8 * 8; tv++)
-						layout.foreground[(cy + (tv / 8)) * layout.width + (cx + (tv % 8))] = chunkMapping[chunk].tile[tv];
+					Error(fail = "Layout file is too small for its dimensions");
+					return true;
 				}
 				
-				//Skip background line (not used)
-				layoutFile.Seek(layout.width / 8, SEEK_CUR);
+				//Get our foreground chunks (chunks that don't exist are left empty)
+				for (size_t cx = 0; cx < layout.chunkWidth; cx++)
+					layoutChunk[cy * layout.chunkWidth + cx] = (line[cx] < chunks) ? line[cx] : 0;
 			}
 			break;
+		}
 		case LEVELFORMAT_TILE:
-			//Get our level dimensions
+		{
+			//Get our level dimensions (rounded up to chunks)
 			layout.width = layoutFile.ReadBE32();
 			layout.height = layoutFile.ReadBE32();
+			layout.chunkWidth = (layout.width + 7) / 8;
+			layout.chunkHeight = (layout.height + 7) / 8;
 			
-			//Allocate our layout
-			layout.foreground = new TILE[layout.width * layout.height];
-			if (layout.foreground == nullptr)
+			if (layout.width == 0 || layout.height == 0)
+			{
+				Error(fail = "Layout has invalid dimensions");
+				return true;
+			}
+			if (layout.width * 16 > LAYOUT_MAX_PIXELS || layout.height * 16 > LAYOUT_MAX_PIXELS)
+			{
+				Error(fail = "Layout is too large (world positions are 16-bit)");
+				return true;
+			}
+			if (layoutFile.GetSize() - layoutFile.Tell() < layout.width * layout.height * 2)
+			{
+				Error(fail = "Layout file is too small for its dimensions");
+				return true;
+			}
+			
+			//Allocate our layout and chunk mappings (at most one unique chunk per chunk in the layout)
+			uint16_t *layoutChunk = LevelAlloc<uint16_t>(layout.chunkWidth * layout.chunkHeight);
+			chunkMapping = LevelAlloc<CHUNKMAPPING>(layout.chunkWidth * layout.chunkHeight);
+			if (layoutChunk == nullptr || chunkMapping == nullptr)
 			{
 				Error(fail = "Failed to allocate layout in memory");
 				return true;
 			}
+			layout.chunk = layoutChunk;
+			chunks = 0;
 			
 			//Read our layout file
-			for (size_t tv = 0; tv < layout.width * layout.height; tv++)
+			uint16_t *tileData = new uint16_t[layout.chunkWidth * 8 * layout.chunkHeight * 8]();
+			for (size_t ty = 0; ty < layout.height; ty++)
+			{
+				if (layoutFile.ReadBE16Array(&tileData[ty * layout.chunkWidth * 8], layout.width) != layout.width)
+				{
+					delete[] tileData;
+					Error(fail = "Layout file is too small for its dimensions");
+					return true;
+				}
+			}
+			
+			//Split our tiles into chunks, with identical chunks shared
+			
+			std::unordered_map<std::string, uint16_t> chunkIndex;
+			for (size_t cy = 0; cy < layout.chunkHeight; cy++)
 			{
-				uint16_t tmap = layoutFile.ReadBE16();
-				layout.foreground[tv].altLRB	= (tmap & 0x8000) != 0;
-				layout.foreground[tv].altTop	= (tmap & 0x4000) != 0;
-				layout.foreground[tv].norLRB	= (tmap & 0x2000) != 0;
-				layout.foreground[tv].norTop	= (tmap & 0x1000) != 0;
-				layout.foreground[tv].yFlip		= (tmap & 0x0800) != 0;
-				layout.foreground[tv].xFlip		= (tmap & 0x0400) != 0;
-				layout.foreground[tv].tile		= (tmap & 0x3FF);
+				for (size_t cx = 0; cx < layout.chunkWidth; cx++)
+				{
+					//Get this chunk's tiles
+					uint16_t chunkData[8 * 8];
+					for (int tv = 0; tv < 8 * 8; tv++)
+						chunkData[tv] = tileData[(cy * 8 + (tv / 8)) * layout.chunkWidth * 8 + (cx * 8 + (tv % 8))];
+					
+					//Use the existing chunk if identical, otherwise create a new one
+					std::string key((const char*)chunkData, sizeof(chunkData));
+					auto existing = chunkIndex.find(key);
+					if (existing != chunkIndex.end())
+					{
+						layoutChunk[cy * layout.chunkWidth + cx] = existing->second;
+						continue;
+					}
+					
+					if (chunks >= 0x10000)
+					{
+						delete[] tileData;
+						Error(fail = "Layout has too many unique chunks");
+						return true;
+					}
+					
+					for (int tv = 0; tv < 8 * 8; tv++)
+					{
+						uint16_t tmap = chunkData[tv];
+						chunkMapping[chunks].tile[tv].altLRB	= (tmap & 0x8000) != 0;
+						chunkMapping[chunks].tile[tv].altTop	= (tmap & 0x4000) != 0;
+						chunkMapping[chunks].tile[tv].norLRB	= (tmap & 0x2000) != 0;
+						chunkMapping[chunks].tile[tv].norTop	= (tmap & 0x1000) != 0;
+						chunkMapping[chunks].tile[tv].yFlip		= (tmap & 0x0800) != 0;
+						chunkMapping[chunks].tile[tv].xFlip		= (tmap & 0x0400) != 0;
+						chunkMapping[chunks].tile[tv].tile		= (tmap & 0x3FF);
+					}
+					
+					chunkIndex[key] = (uint16_t)chunks;
+					layoutChunk[cy * layout.chunkWidth + cx] = (uint16_t)chunks++;
+				}
 			}
+			
+			delete[] tileData;
 			break;
+		}
 		default:
 			Error(fail = "Unimplemented level format");
 			return true;
 	}
 	
+	layout.chunkMapping = chunkMapping;
+	
 	//Initialize boundaries
 	leftBoundary = tableEntry->leftBoundary;
 	rightBoundary = tableEntry->rightBoundary + gRenderSpec.width / 2;
@@ -354,7 +475,13 @@ bool LEVEL::LoadCollisionTiles(LEVELTABLE *tableEntry)
 	
 	//Read our tile collision map data
 	tiles = norMapFile.GetSize();
-	tileMapping = new TILEMAPPING[tiles];
+	tileMapping = LevelAlloc<TILEMAPPING>(tiles);
+	
+	if (tileMapping == nullptr)
+	{
+		Error(fail = "Failed to allocate tile collision map in memory");
+		return true;
+	}
 	
 	if (altMapFile.GetSize() != tiles)
 	{
@@ -362,10 +489,13 @@ bool LEVEL::LoadCollisionTiles(LEVELTABLE *tableEntry)
 		return true;
 	}
 	
+	const uint8_t *norMapData = norMapFile.ReadSpan(tiles);
+	const uint8_t *altMapData = altMapFile.ReadSpan(tiles);
+	
 	for (size_t i = 0; i < tiles; i++)
 	{
-		tileMapping[i].normalColTile = norMapFile.ReadU8();
-		tileMapping[i].alternateColTile = altMapFile.ReadU8();
+		tileMapping[i].normalColTile = norMapData[i];
+		tileMapping[i].alternateColTile = altMapData[i];
 	}
 	
 	//Open our collision tile files
@@ -387,12 +517,12 @@ bool LEVEL::LoadCollisionTiles(LEVELTABLE *tableEntry)
 	//Allocate our collision tile data in memory
 	if ((colNormalFile.GetSize() != colRotatedFile.GetSize()) || (colAngleFile.GetSize() != (colNormalFile.GetSize() / 0x10)))
 	{
-		Error(fail = "Collision tile data file sizes don't match each-other (Are the files compressed?)");
+		Error(fail = "Collision tile data file sizes don't match each-other");
 		return true;
 	}
 	
 	collisionTiles = colNormalFile.GetSize() / 0x10;
-	collisionTile = new COLLISIONTILE[collisionTiles];
+	collisionTile = LevelAlloc<COLLISIONTILE>(collisionTiles);
 	
 	if (collisionTile == nullptr)
 	{
@@ -401,24 +531,35 @@ bool LEVEL::LoadCollisionTiles(LEVELTABLE *tableEntry)
 	}
 	
 	//Read our collision tile data
+	const uint8_t *colNormalData = colNormalFile.ReadSpan(collisionTiles * 0x10);
+	const uint8_t *colRotatedData = colRotatedFile.ReadSpan(collisionTiles * 0x10);
+	const uint8_t *colAngleData = colAngleFile.ReadSpan(collisionTiles);
+	
 	for (size_t i = 0; i < collisionTiles; i++)
 	{
-		for (int v = 0; v < 0x10; v++)
-		{
-			collisionTile[i].normal[v] = colNormalFile.ReadU8();
-			collisionTile[i].rotated[v] = colRotatedFile.ReadU8();
-		}
-		collisionTile[i].angle = colAngleFile.ReadU8();
+		memcpy(collisionTile[i].normal, &colNormalData[i * 0x10], 0x10);
+		memcpy(collisionTile[i].rotated, &colRotatedData[i * 0x10], 0x10);
+		collisionTile[i].angle = colAngleData[i];
 	}
 	
 	LOG(("Success!\n"));
-	return false;
+	
+	//Precompute the collision of every layout tile
+	return BuildCollisionField(this, &collisionField);
 }
 
 bool LEVEL::LoadObjects(LEVELTABLE *tableEntry)
 {
 	LOG(("Loading objects... "));
 	
+	//Create our ring manager
+	ringManager = LevelNew<RINGMANAGER>();
+	if (ringManager->fail != nullptr)
+	{
+		fail = ringManager->fail;
+		return true;
+	}
+	
 	//Open our object file
 	FS_FILE objectFile(gBasePath + tableEntry->levelReferencePath + ".obj", "rb");
 	if (objectFile.fail != nullptr)
@@ -434,16 +575,18 @@ bool LEVEL::LoadObjects(LEVELTABLE *tableEntry)
 		case OBJECTFORMAT_SONIC2:
 		{
 			int objects = objectFile.GetSize() / 6;
+			const uint8_t *objectData = objectFile.ReadSpan(objects * 6);
 			
 			for (int i = 0; i < objects; i++)
 			{
 				//Read data from the file
-				int16_t xPos = objectFile.ReadBE16();
-				int16_t word2 = objectFile.ReadBE16();
+				const uint8_t *entry = &objectData[i * 6];
+				int16_t xPos = (entry[0] << 8) | entry[1];
+				int16_t word2 = (entry[2] << 8) | entry[3];
 				int16_t yPos = word2 & 0x0FFF;
 				
-				uint8_t id = objectFile.ReadU8();
-				uint8_t subtype = objectFile.ReadU8();
+				uint8_t id = entry[4];
+				uint8_t subtype = entry[5];
 				
 				//Read flags from word2
 				bool releaseDestroyed;
@@ -473,8 +616,19 @@ bool LEVEL::LoadObjects(LEVELTABLE *tableEntry)
 					xFlip = (word2 & 0x2000) != 0;
 				}
 				
+				//Pass Sonic 1 ring objects to the ring manager
+				if (tableEntry->objectFormat == OBJECTFORMAT_SONIC1 && id == SONIC1_OBJECTID_RINGS)
+				{
+					if (ringManager->AddSonic1Group(xPos, yPos, subtype))
+					{
+						fail = ringManager->fail;
+						return true;
+					}
+					continue;
+				}
+				
 				//Create and link object load from data
-				OBJECT_LOAD *objectLoad = new OBJECT_LOAD;
+				OBJECT_LOAD *objectLoad = LevelNew<OBJECT_LOAD>();
 				objectLoad->function = tableEntry->objectFunctionList[id];
 				objectLoad->status = {xFlip, yFlip, releaseDestroyed, false, false};
 				objectLoad->xLong = xPos << 16;
@@ -490,55 +644,39 @@ bool LEVEL::LoadObjects(LEVELTABLE *tableEntry)
 		}
 	}
 	
-	/*
-	//Open external ring file
-	char *ringPath = AllocPath(gBasePath, tableEntry->levelReferencePath, ".ring");
-	BACKEND_FILE *ringFile = OpenFile(ringPath, "rb");
-	delete[] ringPath;
-	
-	if (ringFile == nullptr)
-	{
-		Error(fail = GetFileError());
-		return true;
-	}
-	
-	//Read external ring data
-	int rings = GetFileSize(ringFile) / 4;
-	
-	for (int i = 0; i < rings; i++)
+	//Open external ring file (a level without one just has no external rings)
+	FS_FILE ringFile(gBasePath + tableEntry->levelReferencePath + ".ring", "rb");
+	if (ringFile.fail == nullptr)
 	{
-		int16_t xPos = ReadFile_BE16(ringFile);
-		int16_t word2 = ReadFile_BE16(ringFile);
-		int16_t yPos = word2 & 0x0FFF;
+		//Read external ring data
+		size_t rings = ringFile.GetSize() / 4;
+		uint16_t *ringData = new uint16_t[rings * 2];
+		rings = ringFile.ReadBE16Array(ringData, rings * 2) / 2;
 		
-		int type = (word2 & 0xF000) >> 12;
-		
-		for (int v = 0; v <= (type & 0x7); v++)
+		for (size_t i = 0; i < rings; i++)
 		{
-			//Create and link object load from data
-			OBJECT_LOAD *objectLoad = new OBJECT_LOAD;
-			objectLoad->function = &ObjRing;
-			objectLoad->status = {false, false, false, false, false};
-			objectLoad->xLong = xPos << 16;
-			objectLoad->yLong = yPos << 16;
-			objectLoad->subtype = 0;
-			
-			objectLoad->loaded = nullptr;
-			objectLoad->loadRange = false;
-			objectLoad->specificBit = false;
-			
-			objectLoadList.link_back(objectLoad);
-			
-			//Offset next position
-			if (type & 0x8)
-				yPos += 0x18;
-			else
-				xPos += 0x18;
+			if (ringManager->AddSonic2Group((int16_t)ringData[i * 2 + 0], ringData[i * 2 + 1]))
+			{
+				delete[] ringData;
+				fail = ringManager->fail;
+				return true;
+			}
 		}
+		
+		delete[] ringData;
+	}
+	else
+	{
+		LOG(("No ring file, "));
+	}
+	
+	//Sort our rings for the ring manager
+	if (ringManager->Finalize())
+	{
+		fail = ringManager->fail;
+		return true;
 	}
 	
-	CloseFile(ringFile);
-	*/
 	LOG(("Success!\n"));
 	return false;
 }
@@ -553,7 +691,9 @@ bool LEVEL::LoadArt(LEVELTABLE *tableEntry)
 		case ARTFORMAT_BMP:
 		{
 			//Load our foreground tilemap
-			tileTexture = new TEXTURE(tableEntry->artReferencePath + ".tileset.bmp");
+			std::string tilesetPath = tableEntry->artReferencePath + ".tileset.bmp";
+			if ((tileTexture = gTextureCache.Acquire(tilesetPath)) == nullptr)
+				tileTexture = gTextureCache.Add(new TEXTURE(tilesetPath));
 			if (tileTexture->fail != nullptr)
 			{
 				Error(fail = tileTexture->fail);
@@ -569,7 +709,7 @@ bool LEVEL::LoadArt(LEVELTABLE *tableEntry)
 	}
 	
 	//Load background art
-	background = new BACKGROUND(tableEntry->artReferencePath + ".background.bmp", tableEntry->backFunction);
+	background = LevelNew<BACKGROUND>(tableEntry->artReferencePath + ".background.bmp", tableEntry->backFunction);
 	if (background->fail != nullptr)
 	{
 		Error(fail = background->fail);
@@ -583,37 +723,221 @@ bool LEVEL::LoadArt(LEVELTABLE *tableEntry)
 	return false;
 }
 
+//Layout functions
+void LAYOUT::Free()
+{
+	//Forget our chunk data (it's freed with the level's arena)
+	chunk = nullptr;
+}
+
 //Unload data function
 void LEVEL::UnloadAll()
 {
-	//Free memory
-	delete[] layout.foreground;
-	delete[] chunkMapping;
-	delete[] tileMapping;
-	delete[] collisionTile;
+	//Forget our level data (it's freed with our arena)
+	layout.Free();
+	chunkMapping = nullptr;
+	tileMapping = nullptr;
+	collisionTile = nullptr;
+	collisionField = COLLISIONFIELD();
 	
 	//Unload textures
 	if (tileTexture != nullptr)
-		delete tileTexture;
-	if (background != nullptr)
-		delete background;
+		gTextureCache.Release(tileTexture);
+	tileTexture = nullptr;
+	LevelDelete(background);
 	
 	//Unload players, objects, and camera
-	CLEAR_INSTANCE_LINKEDLIST(playerList);
-	CLEAR_INSTANCE_LINKEDLIST(objectList);
-	CLEAR_INSTANCE_LINKEDLIST(coreObjectList);
-	CLEAR_INSTANCE_LINKEDLIST(objectLoadList);
+	for (PLAYER *player : playerList)
+		LevelDelete(player);
+	playerList.clear();
+	CLEAR_INSTANCE_ARRAY(objectList);
+	CLEAR_INSTANCE_ARRAY(coreObjectList);
+	childrenLinked = false;
+	objectSpawns.clear();
+	delete batchCheckState;
+	batchCheckState = nullptr;
+	objectLoadList.clear();
+	objectLoadSpare.clear();
+	spawnQueue.clear();
+	
+	LevelDelete(camera);
+	LevelDelete(titleCard);
+	LevelDelete(hud);
+	LevelDelete(ringManager);
+	LevelDelete(particleSystem);
+	
+	//Release object textures and mappings to the asset caches (which keep them loaded for the next level, within their budget)
+	for (TEXTURE *texture : objTextureCache)
+		if (texture != nullptr)
+			gTextureCache.Release(texture);
+	for (MAPPINGS *mappings : objMappingsCache)
+		if (mappings != nullptr)
+			gMappingsCache.Release(mappings);
+	
+	objTextureCache.clear();
+	objMappingsCache.clear();
+	objTextureIndex.clear();
+	objMappingsIndex.clear();
+	
+	for (int i = 0; i < TEXTUREID_MAX; i++)
+		objTextureById[i] = nullptr;
+	for (int i = 0; i < MAPPINGSID_MAX; i++)
+		objMappingsById[i] = nullptr;
+	
+	//Free everything allocated from our arena at once
+	levelArena.Reset();
+}
+
+//Load job functions
+void LEVEL::QueueLoadJobs(LOADJOBS *loadJobs, LEVELTABLE *tableEntry, const char *players[])
+{
+	//Load our level data (the layout needs our chunk mappings, and the collision field needs the layout)
+	size_t mappingsJob = loadJobs->Add([this, tableEntry]{ return LoadMappings(tableEntry) ? fail : nullptr; });
+	size_t layoutJob = loadJobs->Add([this, tableEntry]{ return LoadLayout(tableEntry) ? fail : nullptr; }, {mappingsJob});
+	loadJobs->Add([this, tableEntry]{ return LoadCollisionTiles(tableEntry) ? fail : nullptr; }, {layoutJob});
+	loadJobs->Add([this, tableEntry]{ return LoadObjects(tableEntry) ? fail : nullptr; });
+	loadJobs->Add([this, tableEntry]{ return LoadArt(tableEntry) ? fail : nullptr; });
 	
-	if (camera != nullptr)
-		delete camera;
-	if (titleCard != nullptr)
-		delete titleCard;
-	if (hud != nullptr)
-		delete hud;
-	
-	//Unload object textures and mappings
-	CLEAR_INSTANCE_LINKEDLIST(objTextureCache);
-	CLEAR_INSTANCE_LINKEDLIST(objMappingsCache);
+	//Preload generic assets, the stage's assets, and our players' art (taken from the asset caches if they're still loaded, otherwise decoded in parallel into their own slots, so our lists keep a fixed order)
+	std::unordered_set<std::string> preloaded;
+	
+	auto PreloadTexture = [&](const std::string &path)
+	{
+		if (!preloaded.insert(path).second)
+			return;
+		size_t slot = objTextureCache.size();
+		objTextureCache.link_back(gTextureCache.Acquire(path));
+		if (objTextureCache[slot] == nullptr)
+			loadJobs->Add([this, slot, path]{ return (objTextureCache[slot] = gTextureCache.Add(new TEXTURE(path)))->fail; });
+	};
+	
+	auto PreloadMappings = [&](const std::string &path)
+	{
+		if (!preloaded.insert(path).second)
+			return;
+		size_t slot = objMappingsCache.size();
+		objMappingsCache.link_back(gMappingsCache.Acquire(path));
+		if (objMappingsCache[slot] == nullptr)
+			loadJobs->Add([this, slot, path]{ return (objMappingsCache[slot] = gMappingsCache.Add(new MAPPINGS(path)))->fail; });
+	};
+	
+	for (int i = 0; preloadTexture[i] != ""; i++)
+		PreloadTexture(preloadTexture[i]);
+	for (int i = 0; preloadMappings[i] != ""; i++)
+		PreloadMappings(preloadMappings[i]);
+	
+	for (int i = 0; tableEntry->preloadTexture[i] != ""; i++)
+		PreloadTexture(tableEntry->preloadTexture[i]);
+	for (int i = 0; tableEntry->preloadMappings[i] != ""; i++)
+		PreloadMappings(tableEntry->preloadMappings[i]);
+	
+	for (const char **player = players; *player != nullptr; player++)
+	{
+		PreloadTexture(std::string(*player) + ".bmp");
+		PreloadMappings(std::string(*player) + ".map");
+	}
+}
+
+void LEVEL::Adopt(LEVEL *staged)
+{
+	//Take the staged level's loaded data (and the arena it's allocated from), leaving it with nothing to unload
+	levelArena.Swap(staged->levelArena);
+	
+	std::swap(tileTexture, staged->tileTexture);
+	std::swap(background, staged->background);
+	paletteFunction = staged->paletteFunction;
+	
+	std::swap(chunks, staged->chunks);
+	std::swap(tiles, staged->tiles);
+	std::swap(chunkMapping, staged->chunkMapping);
+	std::swap(tileMapping, staged->tileMapping);
+	std::swap(layout, staged->layout);
+	
+	std::swap(collisionTiles, staged->collisionTiles);
+	std::swap(collisionTile, staged->collisionTile);
+	std::swap(collisionField, staged->collisionField);
+	
+	leftBoundary = leftBoundaryTarget = staged->leftBoundary;
+	rightBoundary = rightBoundaryTarget = staged->rightBoundary;
+	topBoundary = topBoundaryTarget = staged->topBoundary;
+	bottomBoundary = bottomBoundaryTarget = staged->bottomBoundary;
+	
+	std::swap(ringManager, staged->ringManager);
+	for (OBJECT_LOAD *objectLoad : staged->objectLoadList)
+		objectLoadList.link_back(objectLoad);
+	staged->objectLoadList.clear();
+	
+	//Take its preloaded assets
+	for (TEXTURE *texture : staged->objTextureCache)
+		objTextureCache.link_back(texture);
+	staged->objTextureCache.clear();
+	
+	for (MAPPINGS *mappings : staged->objMappingsCache)
+		objMappingsCache.link_back(mappings);
+	staged->objMappingsCache.clear();
+}
+
+//Level prefetch class
+LEVELPREFETCH::LEVELPREFETCH(int id, const char *setPlayers[]) : levelId((LEVELID)id), players(setPlayers)
+{
+	LOG(("Prefetching level ID %d in the background\n", id));
+	
+	//Start loading our staging level's data
+	staged = new LEVEL();
+	staged->levelId = levelId;
+	staged->zone = gLevelTable[levelId].zone;
+	thread = std::thread(&LEVELPREFETCH::ThreadMain, this);
+}
+
+LEVELPREFETCH::~LEVELPREFETCH()
+{
+	//Stop loading (after the job that's running) and free whatever we've loaded
+	cancel = true;
+	thread.join();
+	if (staged != nullptr)
+		delete staged;
+}
+
+void LEVELPREFETCH::ThreadMain()
+{
+	//Queue our staging level's loads and run them
+	staged->QueueLoadJobs(&loadJobs, &gLevelTable[levelId], players);
+	
+	if (loadJobs.Run([this]{ return cancel.load(); }))
+		staged->fail = (loadJobs.fail != nullptr) ? loadJobs.fail : "Prefetch cancelled";
+	done = true;
+}
+
+LEVEL *LEVELPREFETCH::Take(const char *takePlayers[], std::function<bool()> frame)
+{
+	//Our staging level is no use for different players
+	if (takePlayers != players)
+		return nullptr;
+	
+	//If we're still loading, we're now what the game's waiting on, so finish at full priority (keeping what we've loaded rather than starting over)
+	if (!done)
+	{
+		LOG(("Level prefetch is still loading, waiting for it\n"));
+		loadJobs.RaisePriority();
+		
+		while (!done)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(LOADJOBS_FRAME_WAIT));
+			if (!done && frame())
+			{
+				cancel = true;
+				return nullptr;
+			}
+		}
+	}
+	
+	//Only give our staging level if it loaded successfully
+	if (staged->fail != nullptr)
+		return nullptr;
+	
+	LEVEL *level = staged;
+	staged = nullptr;
+	return level;
 }
 
 //Level class
@@ -623,72 +947,102 @@ LEVEL::LEVEL(int id, const char *players[])
 	
 	//Set us as the global level
 	gLevel = this;
+	batchObjects = gBatchObjects;
 	
 	//Get data from this table entry
 	LEVELTABLE *tableEntry = &gLevelTable[levelId = (LEVELID)id];
 	zone = tableEntry->zone;
 	
-	//Load data
-	if (LoadMappings(tableEntry) || LoadLayout(tableEntry) || LoadCollisionTiles(tableEntry) || LoadObjects(tableEntry) || LoadArt(tableEntry))
-	{
-		//Unload any loaded data
-		UnloadAll();
-		return;
-	}
+	//Handle events and present black frames (what we fade in from) while we wait for our data to load
+	COLOUR loadingColour(0, 0, 0);
+	const char *frameFail = nullptr;
 	
-	//Preload generic assets
-	for (int i = 0; preloadTexture[i] != ""; i++)
+	auto LoadingFrame = [&]
 	{
-		TEXTURE *tex = GetObjectTexture(preloadTexture[i]);
-		if (tex->fail != nullptr)
+		if (HandleEvents())
+			return (quit = true);
+		if (gSoftwareBuffer->RenderToScreen(&loadingColour))
 		{
-			fail = tex->fail;
-			UnloadAll();
-			return;
+			frameFail = "Failed to present a frame while loading";
+			return true;
 		}
-	}
-			
-	for (int i = 0; preloadMappings[i] != ""; i++)
+		return false;
+	};
+	
+	//Adopt our data from the level prefetch if it was loaded in the background (waiting for it to finish if it hasn't), otherwise load it now
+	LEVEL *staged = nullptr;
+	if (gLevelPrefetch != nullptr && gLevelPrefetch->levelId == levelId)
 	{
-		MAPPINGS *map = GetObjectMappings(preloadMappings[i]);
-		if (map->fail != nullptr)
+		staged = gLevelPrefetch->Take(players, LoadingFrame);
+		delete gLevelPrefetch;
+		gLevelPrefetch = nullptr;
+		
+		if (quit || frameFail != nullptr)
 		{
-			fail = map->fail;
+			fail = (frameFail != nullptr) ? frameFail : "Quit while loading";
 			UnloadAll();
 			return;
 		}
 	}
 	
-	//Preload stage's assets
-	for (int i = 0; tableEntry->preloadTexture[i] != ""; i++)
+	if (staged != nullptr)
 	{
-		TEXTURE *tex = GetObjectTexture(tableEntry->preloadTexture[i]);
-		if (tex->fail != nullptr)
-		{
-			fail = tex->fail;
-			UnloadAll();
-			return;
-		}
+		LOG(("Adopting prefetched level data\n"));
+		Adopt(staged);
+		delete staged;
 	}
-			
-	for (int i = 0; tableEntry->preloadMappings[i] != ""; i++)
+	else
 	{
-		MAPPINGS *map = GetObjectMappings(tableEntry->preloadMappings[i]);
-		if (map->fail != nullptr)
+		//Load our level data and preload our assets on our load job threads
+		LOADJOBS loadJobs;
+		QueueLoadJobs(&loadJobs, tableEntry, players);
+		
+		//Run our jobs, presenting loading frames until they're done
+		if (loadJobs.Run(LoadingFrame))
 		{
-			fail = map->fail;
+			//Unload any loaded data
+			if (loadJobs.fail != nullptr)
+				fail = loadJobs.fail;
+			else if (frameFail != nullptr)
+				fail = frameFail;
+			else
+				fail = "Quit while loading";
 			UnloadAll();
 			return;
 		}
 	}
 	
+	//Index our preloaded assets
+	if (IndexObjectAssets())
+	{
+		UnloadAll();
+		return;
+	}
+	
+	//Get our ring graphics (now that our assets are preloaded)
+	if (ringManager->LoadGraphics())
+	{
+		fail = ringManager->fail;
+		UnloadAll();
+		return;
+	}
+	
+	//Create our particle system
+	particleSystem = LevelNew<PARTICLESYSTEM>();
+	if (particleSystem->fail != nullptr)
+	{
+		fail = particleSystem->fail;
+		UnloadAll();
+		return;
+	}
+	
 	//Create our players
 	PLAYER *follow = nullptr;
 	
 	for (int i = 0; *players != nullptr; i++, players++)
 	{
 		//Create our player
-		PLAYER *newPlayer = new PLAYER(*players, follow, i);
+		PLAYER *newPlayer = LevelNew<PLAYER>(*players, follow, i);
 		if (newPlayer->fail != nullptr)
 		{
 			fail = newPlayer->fail;
@@ -703,10 +1057,10 @@ LEVEL::LEVEL(int id, const char *players[])
 	}
 	
 	//Create our camera
-	camera = new CAMERA(playerList[0]);
+	camera = LevelNew<CAMERA>(playerList[0]);
 	
 	//Title-card
-	titleCard = new TITLECARD(tableEntry->name, tableEntry->subtitle);
+	titleCard = LevelNew<TITLECARD>(tableEntry->name, tableEntry->subtitle);
 	if (titleCard->fail != nullptr)
 	{
 		fail = titleCard->fail;
@@ -715,7 +1069,7 @@ LEVEL::LEVEL(int id, const char *players[])
 	}
 	
 	//HUD
-	hud = new HUD();
+	hud = LevelNew<HUD>();
 	if (hud->fail != nullptr)
 	{
 		fail = hud->fail;
@@ -729,14 +1083,16 @@ LEVEL::LEVEL(int id, const char *players[])
 	//Initialize scores
 	InitializeScores();
 	
-	//Load objects near the player
-	CheckObjectLoad();
+	//Load objects and rings near the player
+	if (CheckObjectLoad())
+		return;
+	ringManager->UpdateWindow();
 	
 	//Update stage for initialization
 	ClearControllerInput();
 	UpdateStage();
 	
-	LOG(("Success!\n"));
+	LOG(("Success! Level arena footprint: %d bytes\n", (int)levelArena.Footprint()));
 }
 
 LEVEL::~LEVEL()
@@ -746,6 +1102,12 @@ LEVEL::~LEVEL()
 	LOG(("Success!\n"));
 }
 
+//Prefetch check (the screen is near the end of the level, the next level can be loaded in the background)
+bool LEVEL::IsNearEnd()
+{
+	return camera != nullptr && (camera->xPos + gRenderSpec.width) >= (rightBoundaryTarget - LEVEL_PREFETCH_DISTANCE);
+}
+
 //Fading functions
 void LEVEL::SetFade(bool fadeIn, bool isSpecial)
 {
@@ -784,6 +1146,17 @@ bool LEVEL::UpdateFade()
 	return finished;
 }
 
+bool LEVEL::StepFade()
+{
+	//Fade in until we're done, or fade out, returns true once we've faded out
+	if (isFadingIn)
+	{
+		fading = !UpdateFade();
+		return false;
+	}
+	return UpdateFade();
+}
+
 //Dynamic events
 void LEVEL::DynamicEvents()
 {
@@ -794,16 +1167,16 @@ void LEVEL::DynamicEvents()
 			//Handle S-Tube force rolling
 			for (size_t i = 0; i < playerList.size(); i++)
 			{
-				//Get this player and the tile we're on
+				//Get this player and the chunk we're on
 				PLAYER *player = playerList[i];
-				if (player->x.pos < 0 || player->x.pos >= (int16_t)(gLevel->layout.width * 16) || player->y.pos < 0 || player->y.pos >= (int16_t)(gLevel->layout.height * 16))
+				if (player->x.pos < 0 || player->x.pos >= (int32_t)(gLevel->layout.width * 16) || player->y.pos < 0 || player->y.pos >= (int32_t)(gLevel->layout.height * 16))
 					continue;
-				TILE *tile = &gLevel->layout.foreground[(player->y.pos / 16) * gLevel->layout.width + (player->x.pos / 16)];;
+				size_t chunk = layout.GetChunk(player->x.pos / 16, player->y.pos / 16);
 				
 				//If this is an S-tube chunk tile, roll
 				bool doRoll = false;
 				
-				switch (tile->srcChunk)
+				switch (chunk)
 				{
 					case 0x75: case 0x76: case 0x77: case 0x78:
 					case 0x79: case 0x7A: case 0x7B: case 0x7C:
@@ -873,7 +1246,7 @@ void LEVEL::DynamicEvents()
 	
 	//Move up/down to the boundary
 	int16_t move = 2;
-
+	
 	if (bottomBoundaryTarget < bottomBoundary)
 	{
 		//Move up to the boundary smoothly
@@ -927,46 +1300,90 @@ void LEVEL::DynamicEvents()
 }
 
 //Texture cache and mappings cache
-TEXTURE *LEVEL::GetObjectTexture(std::string path)
+TEXTURE *LEVEL::GetObjectTexture(const std::string &path)
 {
-	for (size_t i = 0; i < objTextureCache.size(); i++)
-	{
-		if (objTextureCache[i]->source == path)
-			return objTextureCache[i];
-	}
-	
-	TEXTURE *newTexture = new TEXTURE(path);
-	objTextureCache.link_back(newTexture);
-	return newTexture;
+	//Use our reference if we have one, otherwise reference it from the asset cache (loading it if it isn't loaded)
+	auto indexed = objTextureIndex.find(path);
+	if (indexed != objTextureIndex.end())
+		return indexed->second;
+	
+	TEXTURE *texture = gTextureCache.Acquire(path);
+	if (texture == nullptr)
+		texture = gTextureCache.Add(new TEXTURE(path));
+	
+	objTextureCache.link_back(texture);
+	objTextureIndex[path] = texture;
+	return texture;
+}
+
+MAPPINGS *LEVEL::GetObjectMappings(const std::string &path)
+{
+	//Use our reference if we have one, otherwise reference it from the asset cache (loading it if it isn't loaded)
+	auto indexed = objMappingsIndex.find(path);
+	if (indexed != objMappingsIndex.end())
+		return indexed->second;
+	
+	MAPPINGS *mappings = gMappingsCache.Acquire(path);
+	if (mappings == nullptr)
+		mappings = gMappingsCache.Add(new MAPPINGS(path));
+	
+	objMappingsCache.link_back(mappings);
+	objMappingsIndex[path] = mappings;
+	return mappings;
 }
 
-MAPPINGS *LEVEL::GetObjectMappings(std::string path)
+bool LEVEL::IndexObjectAssets()
 {
-	for (size_t i = 0; i < objMappingsCache.size(); i++)
+	//Index our preloaded assets by path (those taken from the asset caches haven't been checked for failure yet)
+	for (TEXTURE *texture : objTextureCache)
 	{
-		if (objMappingsCache[i]->source == path)
-			return objMappingsCache[i];
+		if (texture->fail != nullptr)
+		{
+			fail = texture->fail;
+			return true;
+		}
+		objTextureIndex[texture->source] = texture;
 	}
 	
-	MAPPINGS *newMappings = new MAPPINGS(path);
-	objMappingsCache.link_back(newMappings);
-	return newMappings;
+	for (MAPPINGS *mappings : objMappingsCache)
+	{
+		if (mappings->fail != nullptr)
+		{
+			fail = mappings->fail;
+			return true;
+		}
+		objMappingsIndex[mappings->source] = mappings;
+	}
+	return false;
 }
 
 //Object load functions
 OBJECT_LOAD *LEVEL::GetObjectLoad(OBJECT *object)
 {
 	//Return the object load that holds our object or nullptr
-	for (size_t i = 0; i < objectLoadList.size(); i++)
-		if (objectLoadList[i]->loaded == object)
-			return objectLoadList[i];
+	for (OBJECT_LOAD *objectLoad : objectLoadList)
+		if (objectLoad->loaded == object)
+			return objectLoad;
 	return nullptr;
 }
 
+OBJECT_LOAD *LEVEL::NewObjectLoad()
+{
+	//Reuse a released object load if we have one, otherwise allocate a new one from our arena
+	if (objectLoadSpare.size() != 0)
+	{
+		OBJECT_LOAD *objectLoad = objectLoadSpare.back();
+		objectLoadSpare.pop_back();
+		*objectLoad = OBJECT_LOAD();
+		return objectLoad;
+	}
+	return LevelNew<OBJECT_LOAD>();
+}
+
 void LEVEL::LinkObjectLoad(OBJECT *object)
 {
 	//Define our object load struct and link it
-	OBJECT_LOAD *objectLoad = new OBJECT_LOAD;
+	OBJECT_LOAD *objectLoad = NewObjectLoad();
 	objectLoad->function = object->function;
 	objectLoad->status = object->status;
 	objectLoad->xLong = object->xLong;
@@ -987,7 +1404,7 @@ void LEVEL::ReleaseObjectLoad(OBJECT *object)
 	{
 		if (objectLoadList[i]->loaded == object)
 		{
-			delete objectLoadList[i];
+			objectLoadSpare.link_back(objectLoadList[i]);
 			objectLoadList.erase(i--);
 		}
 	}
@@ -996,39 +1413,143 @@ void LEVEL::ReleaseObjectLoad(OBJECT *object)
 void LEVEL::UnrefObjectLoad(OBJECT *object)
 {
 	//Remove references to object
-	for (size_t i = 0; i < objectLoadList.size(); i++)
+	for (OBJECT_LOAD *objectLoad : objectLoadList)
 	{
-		if (objectLoadList[i]->loaded == object)
-			objectLoadList[i]->loaded = nullptr;
+		if (objectLoad->loaded == object)
+			objectLoad->loaded = nullptr;
 	}
 }
 
-void LEVEL::CheckObjectLoad()
+bool LEVEL::IsObjectLoadInView(OBJECT_LOAD *objectLoad)
+{
+	//Check if the given object load is on-screen (everything else in the load window waits in the spawn queue)
+	return objectLoad->x.pos >= camera->xPos && objectLoad->x.pos < camera->xPos + (int)gRenderSpec.width &&
+		objectLoad->y.pos >= camera->yPos && objectLoad->y.pos < camera->yPos + (int)gRenderSpec.height;
+}
+
+bool LEVEL::SpawnObjectLoad(OBJECT_LOAD *objectLoad)
+{
+	//Create the object and link it
+	OBJECT *newObject = new OBJECT(objectLoad->function);
+	if (newObject == nullptr)
+	{
+		fail = "Failed to allocate object in memory";
+		return true;
+	}
+	
+	newObject->status = objectLoad->status;
+	newObject->xLong = objectLoad->xLong;
+	newObject->yLong = objectLoad->yLong;
+	newObject->subtype = objectLoad->subtype;
+	objectLoad->loaded = newObject;
+	objectLoad->queued = false;
+	
+	objectList.link_back(newObject);
+	return false;
+}
+
+bool LEVEL::CheckObjectLoad()
 {
 	//Check all object loads if they should be loaded
-	for (size_t i = 0; i < objectLoadList.size(); i++)
+	for (OBJECT_LOAD *objectLoad : objectLoadList)
 	{
 		//Check if this object load is in load range
-		uint16_t xOff = (objectLoadList[i]->x.pos & 0xFF80) - ((camera->xPos - 0x80) & 0xFF80);
+		uint16_t xOff = (objectLoad->x.pos & 0xFF80) - ((camera->xPos - 0x80) & 0xFF80);
 		bool isLoadRange = xOff <= upperRound(0x80 + gRenderSpec.width + 0x80, 0x80);
 		
 		//Check if we're just now in range, and load object if so
-		if (isLoadRange == true && objectLoadList[i]->loadRange == false && objectLoadList[i]->loaded == nullptr)
+		if (isLoadRange == true && objectLoad->loadRange == false && objectLoad->loaded == nullptr && objectLoad->queued == false)
 		{
-			//Load the object if in-range
-			OBJECT *newObject = new OBJECT(objectLoadList[i]->function);
-			newObject->status = objectLoadList[i]->status;
-			newObject->xLong = objectLoadList[i]->xLong;
-			newObject->yLong = objectLoadList[i]->yLong;
-			newObject->subtype = objectLoadList[i]->subtype;
-			objectLoadList[i]->loaded = newObject;
-			
-			gLevel->objectList.link_back(newObject);
+			//Spawn now if on-screen, otherwise queue to be spawned within our budget
+			if (IsObjectLoadInView(objectLoad))
+			{
+				if (SpawnObjectLoad(objectLoad))
+					return true;
+			}
+			else
+			{
+				objectLoad->queued = true;
+				spawnQueue.link_back(objectLoad);
+			}
 		}
 		
 		//Update the object load's state
-		objectLoadList[i]->loadRange = isLoadRange;
+		objectLoad->loadRange = isLoadRange;
+	}
+	
+	//Spawn queued objects that have come on-screen, and drop those that have left load range
+	size_t keep = 0;
+	for (size_t i = 0; i < spawnQueue.size(); i++)
+	{
+		OBJECT_LOAD *objectLoad = spawnQueue[i];
+		if (objectLoad->loadRange == false)
+			objectLoad->queued = false;
+		else if (IsObjectLoadInView(objectLoad))
+		{
+			if (SpawnObjectLoad(objectLoad))
+				return true;
+		}
+		else
+			spawnQueue[keep++] = objectLoad;
 	}
+	spawnQueue.resize(keep);
+	
+	//Spawn the rest, closest to the screen first, within our budget
+	if (spawnQueue.size() != 0)
+	{
+		int centreX = camera->xPos + gRenderSpec.width / 2;
+		int centreY = camera->yPos + gRenderSpec.height / 2;
+		std::stable_sort(spawnQueue.begin(), spawnQueue.end(), [centreX, centreY](OBJECT_LOAD *a, OBJECT_LOAD *b)
+		{
+			return mabs(a->x.pos - centreX) + mabs(a->y.pos - centreY) < mabs(b->x.pos - centreX) + mabs(b->y.pos - centreY);
+		});
+		
+		size_t spawn = mmin(spawnQueue.size(), (size_t)LEVEL_SPAWN_BUDGET);
+		for (size_t i = 0; i < spawn; i++)
+			if (SpawnObjectLoad(spawnQueue[i]))
+				return true;
+		spawnQueue.erase(0, spawn);
+	}
+	return false;
+}
+
+//Object hierarchy function
+void LEVEL::PlaceLinkedChildren(size_t *index)
+{
+	//Place children linked since we were last called into the object list, after their parent's subtree so it's still in parent-then-children order
+	if (childrenLinked == false)
+		return;
+	childrenLinked = false;
+	
+	//Rebuild the list in one pass, writing each top-level object followed by its subtree (index follows the object it pointed to)
+	OBJECT *indexObject = (index != nullptr) ? objectList[*index] : nullptr;
+	objectListPlaced.clear();
+	objectListPlaced.reserve(objectList.size() + 0x10);
+	
+	for (OBJECT *root : objectList)
+	{
+		if (root->Cold()->hierarchyParent != nullptr)
+			continue;
+		
+		for (OBJECT *object = root; object != nullptr;)
+		{
+			if (object == indexObject)
+				*index = objectListPlaced.size();
+			objectListPlaced.link_back(object);
+			
+			//Go to our first child, or the next sibling of ourselves or our closest ancestor that has one
+			if (object->Cold()->firstChild != nullptr)
+			{
+				object = object->Cold()->firstChild;
+				continue;
+			}
+			while (object != root && object->Cold()->nextSibling == nullptr)
+				object = object->Cold()->hierarchyParent;
+			object = (object != root) ? object->Cold()->nextSibling : nullptr;
+		}
+	}
+	
+	objectList.swap(objectListPlaced);
 }
 
 //Object layer function
@@ -1120,52 +1641,202 @@ void LEVEL::OscillatoryUpdate()
 	}
 }
 
+//Batched object update
+bool LEVEL::BatchObject(OBJECT *object)
+{
+	//Objects load their assets on their first update, and parents have their descendants skipped if they're deleted, so these are always updated in list order
+	OBJECT_COLD *cold = object->Cold();
+	if (object->function != cold->prevFunction || cold->descendants != 0)
+		return false;
+	
+	//Add this object to its type's batch, if it's of a type that can be batched
+	for (size_t i = 0; i < OBJECT_BATCHES; i++)
+	{
+		if (object->function == objFuncBatched[i])
+		{
+			objectBatch[i].link_back({object, updateCount++});
+			return true;
+		}
+	}
+	return false;
+}
+
+bool LEVEL::UpdateObjectBatches()
+{
+	//Update all objects of each type together (in list order within each batch)
+	//These run on this thread, as the object pool, spawning, sounds, and the score aren't thread-safe, and objects would need their side effects deferred to run elsewhere
+	for (size_t i = 0; i < OBJECT_BATCHES; i++)
+	{
+		for (OBJECT_ORDERED &batched : objectBatch[i])
+		{
+			updateOrder = batched.order;
+			if (batched.object->Update())
+			{
+				fail = batched.object->Cold()->fail;
+				return true;
+			}
+		}
+		objectBatch[i].clear();
+	}
+	return false;
+}
+
+void LEVEL::LinkObject(OBJECT *object)
+{
+	//During a batched update, hold spawned objects until every object has been updated, so they can be linked in the order their spawners would have been updated in
+	if (deferSpawns)
+		objectSpawns.link_back({object, updateOrder});
+	else
+		objectList.link_back(object);
+}
+
+void LEVEL::LinkObjectSpawns()
+{
+	//Link the objects spawned during a batched update, by their spawner's order (keeping each spawner's own order)
+	std::stable_sort(objectSpawns.begin(), objectSpawns.end(), [](const OBJECT_ORDERED &a, const OBJECT_ORDERED &b)
+	{
+		return a.order < b.order;
+	});
+	
+	for (OBJECT_ORDERED &spawn : objectSpawns)
+		objectList.link_back(spawn.object);
+	objectSpawns.clear();
+}
+
+//Checksum function
+static inline uint32_t HashValue(uint32_t hash, uint32_t value)
+{
+	//FNV-1a, a byte at a time
+	for (int i = 0; i < 4; i++)
+	{
+		hash ^= (value >> (i * 8)) & 0xFF;
+		hash *= 16777619;
+	}
+	return hash;
+}
+
+uint32_t LEVEL::Checksum()
+{
+	//Hash the state that matters to gameplay (the full savestate has padding and assets' addresses in it, which differ between machines)
+	uint32_t hash = 2166136261;
+	hash = HashValue(hash, gScore);
+	hash = HashValue(hash, gRings);
+	hash = HashValue(hash, gTime);
+	hash = HashValue(hash, gLives);
+	hash = HashValue(hash, GetRandomSeed());
+	hash = HashValue(hash, (uint32_t)frameCounter);
+	
+	for (PLAYER *player : playerList)
+	{
+		hash = HashValue(hash, ((uint16_t)player->x.pos << 16) | (uint16_t)player->y.pos);
+		hash = HashValue(hash, ((uint16_t)player->xVel << 16) | (uint16_t)player->yVel);
+		hash = HashValue(hash, ((uint16_t)player->inertia << 16) | ((uint32_t)player->routine << 8) | player->angle);
+	}
+	
+	hash = HashValue(hash, (uint32_t)coreObjectList.size());
+	hash = HashValue(hash, (uint32_t)objectList.size());
+	for (OBJECT *object : objectList)
+	{
+		hash = HashValue(hash, ((uint16_t)object->x.pos << 16) | (uint16_t)object->y.pos);
+		hash = HashValue(hash, ((uint16_t)object->xVel << 16) | (uint16_t)object->yVel);
+		hash = HashValue(hash, ((uint32_t)object->routine << 8) | object->routineSecondary);
+	}
+	return hash;
+}
+
 //Level update and draw
+bool LEVEL::UpdateObjects(size_t *index, bool batch)
+{
+	//Update objects in list order from the given index, deferring order-insensitive objects to their type's batch if batching
+	for (; *index < objectList.size(); (*index)++)
+	{
+		OBJECT *object = objectList[*index];
+		if (batch && BatchObject(object))
+			continue;
+		
+		updateOrder = updateCount++;
+		if (object->Update())
+		{
+			fail = object->Cold()->fail;
+			return true;
+		}
+		
+		//Place any children we linked, then don't update the descendants of objects that are going to be deleted (they're the entries after us)
+		PlaceLinkedChildren(index);
+		if (object->deleteFlag)
+			*index += object->Cold()->descendants;
+	}
+	return false;
+}
+
 bool LEVEL::UpdateStage()
 {
 	if (updateStage)
 	{
-		//Update players and objects
+		//Release last update's draw instances
+		objectDrawArena.Reset();
+		coreDrawArena.Reset();
+		
+		//Update players
 		for (size_t i = 0; i < playerList.size(); i++)
 			playerList[i]->Update();
-	
-		for (size_t i = 0; i < objectList.size(); i++)
+		
+		//Update objects, either in list order, or with order-insensitive objects in batches after everything else (then the objects spawned meanwhile)
+		drawInstanceArena = &objectDrawArena;
+		updateCount = 0;
+		size_t index = 0;
+		
+		if (batchObjects)
 		{
-			if (objectList[i]->Update())
-			{
-				fail = objectList[i]->fail;
+			deferSpawns = true;
+			bool batchFail = UpdateObjects(&index, true) || UpdateObjectBatches();
+			deferSpawns = false;
+			LinkObjectSpawns();
+			if (batchFail)
 				return true;
-			}
 		}
 		
+		if (UpdateObjects(&index, false))
+			return true;
+		
+		drawInstanceArena = &coreDrawArena;
 		for (size_t i = 0; i < coreObjectList.size(); i++)
 		{
 			if (coreObjectList[i]->Update())
 			{
-				fail = coreObjectList[i]->fail;
+				fail = coreObjectList[i]->Cold()->fail;
 				return true;
 			}
 		}
+		
+		//Update rings and particles
+		ringManager->Update();
+		particleSystem->Update();
 	}
 	else
 	{
+		//Release last update's draw instances for core objects only (the stage's objects keep drawing their last state)
+		coreDrawArena.Reset();
+		
 		//If not to update the stage, only update players and core objects
 		for (size_t i = 0; i < playerList.size(); i++)
 			playerList[i]->Update();
 		
+		drawInstanceArena = &coreDrawArena;
 		for (size_t i = 0; i < coreObjectList.size(); i++)
 		{
 			if (coreObjectList[i]->Update())
 			{
-				fail = coreObjectList[i]->fail;
+				fail = coreObjectList[i]->Cold()->fail;
 				return true;
 			}
 		}
 	}
 	
-	//Check for object deletion
-	CHECK_LINKEDLIST_OBJECTDELETE(objectList)
-	CHECK_LINKEDLIST_OBJECTDELETE(coreObjectList)
+	//Check for object deletion (with every child in place after its parent, so deletion reaches every descendant)
+	PlaceLinkedChildren(nullptr);
+	CHECK_ARRAY_OBJECTDELETE(objectList)
+	CHECK_ARRAY_OBJECTDELETE(coreObjectList)
 	
 	//Update camera
 	if (camera != nullptr)
@@ -1173,8 +1844,144 @@ bool LEVEL::UpdateStage()
 	return false;
 }
 
+bool LEVEL::CheckUpdateStage()
+{
+	//Update the stage in list order, then restore it and update it batched, and fail if the two updates didn't end up the same
+	if (batchCheckState == nullptr)
+		batchCheckState = new SAVESTATE;
+	if (batchCheckState->Save())
+	{
+		Error(fail = batchCheckState->fail);
+		return true;
+	}
+	
+	batchObjects = false;
+	if (UpdateStage())
+		return true;
+	uint32_t listChecksum = Checksum();
+	
+	if (batchCheckState->Load())
+	{
+		Error(fail = batchCheckState->fail);
+		return true;
+	}
+	
+	batchObjects = true;
+	bool batchFail = UpdateStage();
+	batchObjects = gBatchObjects;
+	if (batchFail)
+		return true;
+	
+	if (Checksum() != listChecksum)
+	{
+		Error(fail = "Batched object update didn't match the list-order update");
+		return true;
+	}
+	return false;
+}
+
+bool LEVEL::CheckBatchScenarios()
+{
+	//Place each order-sensitive object the lead player touches (a spring and a monitor ahead of them) in the object list with each badnik, in both orders,
+	//and play a scripted run and jump into them, checking every frame's batched update against list order, then put the level back the way it was
+	struct BATCH_SCENARIO_OBJECT
+	{
+		OBJECTFUNCTION function;
+		int16_t x, y; //From the lead player, and the floor under them
+		unsigned int subtype;
+	};
+	
+	static const BATCH_SCENARIO_OBJECT sensitive[] = {
+		{&ObjSpring,	 32,  -8, 0x00},	//Red spring facing up
+		{&ObjMonitor,	 48, -16, 6},		//Ring monitor
+	};
+	static const BATCH_SCENARIO_OBJECT other[] = {
+		{&ObjMotobug,	 32, -16, 0},
+		{&ObjCrabmeat,	 64, -16, 0},
+		{&ObjBuzzBomber, 64, -64, 0},
+		{&ObjNewtron,	 40, -32, 1},	//Shoots missiles
+	};
+	
+	PLAYER *lead = playerList[0];
+	CONTROLLER *controller = &gController[lead->controller];
+	CONTROLLER heldController = *controller;
+	int16_t floor = lead->y.pos + lead->yRadius;
+	
+	auto Place = [&](const BATCH_SCENARIO_OBJECT &place)
+	{
+		OBJECT *object = new OBJECT(place.function);
+		if (object == nullptr)
+			return true;
+		object->x.pos = lead->x.pos + place.x;
+		object->y.pos = floor + place.y;
+		object->subtype = place.subtype;
+		if (objectList.link_back(object) == nullptr)
+		{
+			delete object;
+			return true;
+		}
+		LinkObjectLoad(object); //Monitors remember being broken in theirs
+		return false;
+	};
+	
+	SAVESTATE *scenarioState = new SAVESTATE;
+	if (scenarioState->Save())
+	{
+		Error(fail = scenarioState->fail);
+		delete scenarioState;
+		return true;
+	}
+	
+	bool error = false;
+	for (size_t i = 0; i < sizeof(sensitive) / sizeof(sensitive[0]) && !error; i++)
+	{
+		for (size_t v = 0; v < sizeof(other) / sizeof(other[0]) * 2 && !error; v++)
+		{
+			//Place our objects in this order
+			const BATCH_SCENARIO_OBJECT &first = (v & 1) ? other[v / 2] : sensitive[i];
+			const BATCH_SCENARIO_OBJECT &second = (v & 1) ? sensitive[i] : other[v / 2];
+			if (Place(first) || Place(second))
+			{
+				Error(fail = "Failed to allocate object in memory");
+				error = true;
+				break;
+			}
+			
+			//Run right, jumping a few frames in (drawing so objects know if they're on-screen)
+			for (unsigned int frame = 0; frame < LEVEL_BATCH_SCENARIO_FRAMES; frame++)
+			{
+				CONTROLMASK held;
+				held.right = true;
+				held.a = (frame == LEVEL_BATCH_SCENARIO_JUMP);
+				
+				controller->lastHeld = controller->held;
+				controller->press = CONTROLMASK();
+				controller->press.right = !controller->lastHeld.right;
+				controller->press.a = held.a && !controller->lastHeld.a;
+				controller->held = held;
+				
+				frameArena.Reset();
+				if ((error = CheckUpdateStage()) == true)
+					break;
+				Draw();
+			}
+			
+			//Put the level back
+			if (!error && (error = scenarioState->Load()) == true)
+				Error(fail = scenarioState->fail);
+		}
+	}
+	
+	*controller = heldController;
+	delete scenarioState;
+	return error;
+}
+
 bool LEVEL::Update()
 {
+	//Release last frame's transient allocations
+	frameArena.Reset();
+	
 	//Update title card
 	titleCard->UpdateAndDraw();
 	if (titleCard->activeLock)
@@ -1184,17 +1991,33 @@ bool LEVEL::Update()
 	if (fading)
 		return false;
 	
-	//Update the stage
-	if (UpdateStage())
+	//Check the batched object update against list order over objects the player interacts with, once the lead player first lands
+	if (gCheckObjectBatching && !batchScenariosChecked && playerList.size() && !playerList[0]->status.inAir)
+	{
+		batchScenariosChecked = true;
+		if (CheckBatchScenarios())
+			return true;
+		frameArena.Reset();
+	}
+	
+	//Update the stage (checking the batched object update against list order, if asked to)
+	if (gCheckObjectBatching ? CheckUpdateStage() : UpdateStage())
+		return true;
+	if (ringManager->fail != nullptr)
+	{
+		fail = ringManager->fail; //Failed to create an attracted ring
 		return true;
+	}
 	frameCounter++;
 	
 	//Update level dynamic events
 	if (playerList.size())
 		DynamicEvents();
 	
-	//Load objects and update oscillatory values
-	CheckObjectLoad();
+	//Load objects and rings, and update oscillatory values
+	if (CheckObjectLoad())
+		return true;
+	ringManager->UpdateWindow();
 	OscillatoryUpdate();
 	
 	//Increase our time
@@ -1220,7 +2043,7 @@ void LEVEL::Draw()
 		background->Draw(updateStage, camera->xPos, camera->yPos);
 	
 	//Draw foreground
-	if (layout.foreground != nullptr && tileTexture != nullptr && camera != nullptr)
+	if (layout.chunk != nullptr && tileTexture != nullptr && camera != nullptr)
 	{
 		int cLeft = mmax(camera->xPos / 16, 0);
 		int cTop = mmax(camera->yPos / 16, 0);
@@ -1232,7 +2055,7 @@ void LEVEL::Draw()
 			for (int tx = cLeft; tx < cRight; tx++)
 			{
 				//Get tile
-				TILE *tile = &layout.foreground[ty * layout.width + tx];
+				TILE *tile = layout.GetTile(tx, ty);
 				
 				if (tile->tile >= tiles || tile->tile >= tileTexture->height / 16)
 					continue;
@@ -1247,12 +2070,14 @@ void LEVEL::Draw()
 	}
 	
 	//Draw players and objects
-	for (size_t i = 0; i < playerList.size(); i++)
-		playerList[i]->DrawToScreen();
-	for (size_t i = 0; i < objectList.size(); i++)
-		objectList[i]->Draw();
-	for (size_t i = 0; i < coreObjectList.size(); i++)
-		coreObjectList[i]->Draw();
+	for (PLAYER *player : playerList)
+		player->DrawToScreen();
+	for (OBJECT *object : objectList)
+		object->Draw();
+	for (OBJECT *object : coreObjectList)
+		object->Draw();
+	ringManager->Draw();
+	particleSystem->Draw();
 	
 	//Draw HUD
 	hud->Draw();
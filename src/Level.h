@@ -1,9 +1,16 @@
 #pragma once
 #include <string>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
+#include <mutex>
+#include <new>
+#include <type_traits>
 #include <stddef.h>
 #include <stdint.h>
 
-#include "LinkedList.h"
+#include "Array.h"
+#include "Arena.h"
 #include "Render.h"
 #include "LevelSpecific.h"
 #include "Player.h"
@@ -11,10 +18,33 @@
 #include "Camera.h"
 #include "TitleCard.h"
 #include "Hud.h"
+#include "RingManager.h"
+#include "Particle.h"
 #include "Background.h"
+#include "AssetCache.h"
+#include "LoadJobs.h"
+
+class LOADJOBS;
+class SAVESTATE;
 
 #define OSCILLATORY_VALUES 16
 
+//Object spawning budget (objects off-screen that are spawned per frame, objects on-screen are never delayed)
+#define LEVEL_SPAWN_BUDGET	4
+
+//Level-lifetime arena (level data, object loads, and the level's own objects, freed all at once when the level is unloaded)
+#define LEVEL_ARENA_BLOCK		0x40000
+
+//Next level prefetching (started once the screen is this close, in pixels, to the end of the level)
+#define LEVEL_PREFETCH_DISTANCE	0x200
+
+//Object types that can be updated in batches (see objFuncBatched)
+#define OBJECT_BATCHES 8
+
+//Batched object update scenario check (frames each interleaving is played for, and the frame the player jumps on)
+#define LEVEL_BATCH_SCENARIO_FRAMES	120
+#define LEVEL_BATCH_SCENARIO_JUMP	8
+
 //Level render layer
 #define OBJECT_LAYERS 8
 enum LEVEL_RENDERLAYER
@@ -28,6 +58,14 @@ enum LEVEL_RENDERLAYER
 	LEVEL_RENDERLAYER_BACKGROUND,
 };
 
+//Object waiting on a batched update, with its order in a list-order update
+struct OBJECT_ORDERED
+{
+	OBJECT *object;
+	size_t order;
+};
+
+
 //Level formats
 enum LEVELFORMAT
 {
@@ -110,7 +148,6 @@ struct TILE
 	
 	//Tile index
 	uint16_t tile : 10;
-	uint8_t srcChunk;
 };
 
 struct CHUNKMAPPING
@@ -125,12 +162,28 @@ struct TILEMAPPING
 	uint16_t alternateColTile; 
 };
 
-//Layout
+//Layout (chunk indices, each chunk being 8x8 tiles from the chunk mappings)
+#define LAYOUT_CHUNK_TILES	(8 * 8)
+#define LAYOUT_MAX_PIXELS	INT16_MAX	//Largest width or height (players, objects, object loads, the camera, and collision all use int16_t world positions, like the original)
+
 struct LAYOUT
 {
+	//Dimensions in tiles and chunks
 	size_t width = 0;
 	size_t height = 0;
-	TILE *foreground = nullptr;
+	size_t chunkWidth = 0;
+	size_t chunkHeight = 0;
+	
+	//Chunk index of each chunk in the layout, and the chunk mappings they index
+	const uint16_t *chunk = nullptr;
+	CHUNKMAPPING *chunkMapping = nullptr;
+	
+	//Lookup functions (the given tile position must be within the layout)
+	inline size_t GetChunk(size_t tx, size_t ty) { return chunk[(ty >> 3) * chunkWidth + (tx >> 3)]; }
+	inline size_t GetTileIndex(size_t tx, size_t ty) { return GetChunk(tx, ty) * LAYOUT_CHUNK_TILES + (((ty & 7) << 3) | (tx & 7)); }
+	inline TILE *GetTile(size_t tx, size_t ty) { return &chunkMapping[GetChunk(tx, ty)].tile[((ty & 7) << 3) | (tx & 7)]; }
+	
+	void Free();
 };
 
 //Collision tile data
@@ -157,6 +210,7 @@ struct OBJECT_LOAD
 	//Current status
 	OBJECT *loaded = nullptr;
 	bool loadRange = false;
+	bool queued = false;	//Waiting in the spawn queue
 	bool specificBit = false;
 };
 
@@ -178,6 +232,7 @@ class LEVEL
 		TEXTURE *tileTexture = nullptr;
 		BACKGROUND *background = nullptr;
 		PALETTECYCLEFUNCTION paletteFunction = nullptr;
+		LEVELSPECIFIC_STATE levelSpecific;
 		
 		//Chunk and tile data
 		size_t chunks = 0, tiles = 0;
@@ -190,6 +245,7 @@ class LEVEL
 		//Collision data
 		size_t collisionTiles = 0;
 		COLLISIONTILE *collisionTile = nullptr;
+		COLLISIONFIELD collisionField;
 		
 		//Boundaries
 		uint16_t leftBoundary = 0;
@@ -203,19 +259,51 @@ class LEVEL
 		uint16_t bottomBoundaryTarget = 0;
 		
 		//Players and objects
-		LINKEDLIST<PLAYER*> playerList;
-		LINKEDLIST<OBJECT*> coreObjectList;
-		LINKEDLIST<OBJECT_LOAD*> objectLoadList;
-		LINKEDLIST<OBJECT*> objectList;
+		ARRAY<PLAYER*> playerList;
+		ARRAY<OBJECT*> coreObjectList;
+		ARRAY<OBJECT_LOAD*> objectLoadList;
+		ARRAY<OBJECT_LOAD*> objectLoadSpare;	//Released object loads, reused before allocating more from our arena
+		ARRAY<OBJECT_LOAD*> spawnQueue;	//Object loads in range, but off-screen, waiting to be spawned within our per-frame budget
+		ARRAY<OBJECT*> objectList;
+		ARRAY<OBJECT*> objectListPlaced;	//Object list being rebuilt with newly linked children in place (kept for its memory)
+		bool childrenLinked = false;		//If children have been linked that aren't in the object list yet
+		
+		//Batched object update (gives the same results as updating in list order, which gCheckObjectBatching checks)
+		bool batchObjects = false;						//If order-insensitive objects are updated in batches after everything else (opt-in with gBatchObjects, list order is the original behaviour)
+		ARRAY<OBJECT_ORDERED> objectBatch[OBJECT_BATCHES];	//Order-insensitive objects waiting to be updated together by type
+		ARRAY<OBJECT_ORDERED> objectSpawns;				//Objects spawned during a batched update, linked in the order list order would have linked them
+		bool deferSpawns = false;
+		size_t updateCount = 0;							//Objects updated so far this frame
+		size_t updateOrder = 0;							//Order of the object being updated
+		SAVESTATE *batchCheckState = nullptr;
+		bool batchScenariosChecked = false;				//If CheckBatchScenarios has run this level
 		
 		//Title card, camera, and HUD
 		CAMERA *camera = nullptr;
 		TITLECARD *titleCard = nullptr;
 		HUD *hud = nullptr;
 		
-		//Object texture cache
-		LINKEDLIST<TEXTURE*> objTextureCache;
-		LINKEDLIST<MAPPINGS*> objMappingsCache;
+		//Static rings and particles
+		RINGMANAGER *ringManager = nullptr;
+		PARTICLESYSTEM *particleSystem = nullptr;
+		
+		//Level-lifetime allocation (locked, as our load jobs allocate from it in parallel)
+		ARENA levelArena{LEVEL_ARENA_BLOCK};
+		std::mutex levelArenaMutex;
+		
+		//Per-frame allocation (transient data that's released every frame, and object draw instances, which are kept until their objects next update)
+		ARENA frameArena{0x400};
+		ARENA objectDrawArena{0x4000};
+		ARENA coreDrawArena{0x1000};
+		ARENA *drawInstanceArena = &objectDrawArena;
+		
+		//Object textures and mappings (referenced from the process-wide asset caches, and indexed by path)
+		ARRAY<TEXTURE*> objTextureCache;
+		ARRAY<MAPPINGS*> objMappingsCache;
+		std::unordered_map<std::string, TEXTURE*> objTextureIndex;
+		std::unordered_map<std::string, MAPPINGS*> objMappingsIndex;
+		TEXTURE *objTextureById[TEXTUREID_MAX] = {};	//Resolved on first use of each asset ID
+		MAPPINGS *objMappingsById[MAPPINGSID_MAX] = {};
 		
 		//Other state stuff
 		int frameCounter = 0;		//Frames the level has been loaded
@@ -225,13 +313,17 @@ class LEVEL
 		bool fading = false;		//If we're currently fading in / out
 		bool isFadingIn = false;	//If we're fading in or not
 		bool specialFade = false;	//Fading to / from white (fades to Special Stage)
+		bool quit = false;			//If the game was quit while we were loading
 		
 	public:
 		//Constructor and destructor
 		LEVEL(int id, const char *players[]);
+		LEVEL() { return; } //Staging level, for only loading data into (see LEVELPREFETCH)
 		~LEVEL();
 		
 		//Level loading functions
+		void QueueLoadJobs(LOADJOBS *loadJobs, LEVELTABLE *tableEntry, const char *players[]);
+		void Adopt(LEVEL *staged);
 		bool LoadMappings(LEVELTABLE *tableEntry);
 		bool LoadLayout(LEVELTABLE *tableEntry);
 		bool LoadCollisionTiles(LEVELTABLE *tableEntry);
@@ -239,24 +331,82 @@ class LEVEL
 		bool LoadArt(LEVELTABLE *tableEntry);
 		void UnloadAll();
 		
+		//Level-lifetime allocation functions (nothing is freed until the level is unloaded, objects with destructors are destroyed with LevelDelete)
+		template <typename T> inline T *LevelAlloc(size_t num)
+		{
+			T *ptr;
+			{
+				std::lock_guard<std::mutex> lock(levelArenaMutex);
+				ptr = levelArena.Alloc<T>(num);
+			}
+			if (ptr != nullptr && !std::is_trivially_default_constructible<T>::value)
+				for (size_t i = 0; i < num; i++)
+					new (&ptr[i]) T;
+			return ptr;
+		}
+		
+		template <typename T, typename... ARGS> inline T *LevelNew(ARGS&&... args)
+		{
+			void *ptr;
+			{
+				std::lock_guard<std::mutex> lock(levelArenaMutex);
+				ptr = levelArena.Alloc(sizeof(T), alignof(T));
+			}
+			return (ptr != nullptr) ? new (ptr) T(std::forward<ARGS>(args)...) : nullptr;
+		}
+		
+		template <typename T> inline void LevelDelete(T *&object)
+		{
+			if (object != nullptr)
+				object->~T();
+			object = nullptr;
+		}
+		
 		//Fading
 		void SetFade(bool fadeIn, bool isSpecial);
 		bool UpdateFade();
+		bool StepFade();
 		
 		//Dynamic events
 		void DynamicEvents();
+		bool IsNearEnd();
 		
 		//Object texture and mapping cache functions
-		TEXTURE *GetObjectTexture(std::string path);
-		MAPPINGS *GetObjectMappings(std::string path);
+		TEXTURE *GetObjectTexture(const std::string &path);
+		MAPPINGS *GetObjectMappings(const std::string &path);
+		bool IndexObjectAssets();
+		
+		//Object texture and mapping lookups by asset ID (resolved by path on first use, then a table lookup)
+		inline TEXTURE *GetObjectTexture(TEXTUREID id)
+		{
+			if (objTextureById[id] == nullptr)
+				objTextureById[id] = GetObjectTexture(gTexturePath[id]);
+			return objTextureById[id];
+		}
+		
+		inline MAPPINGS *GetObjectMappings(MAPPINGSID id)
+		{
+			if (objMappingsById[id] == nullptr)
+				objMappingsById[id] = GetObjectMappings(gMappingsPath[id]);
+			return objMappingsById[id];
+		}
 		
 		//Object load functions
 		OBJECT_LOAD *GetObjectLoad(OBJECT *object);
+		OBJECT_LOAD *NewObjectLoad();
 		void LinkObjectLoad(OBJECT *object);
 		void ReleaseObjectLoad(OBJECT *object);
 		void UnrefObjectLoad(OBJECT *object);
 		
-		void CheckObjectLoad();
+		bool IsObjectLoadInView(OBJECT_LOAD *objectLoad);
+		bool SpawnObjectLoad(OBJECT_LOAD *objectLoad);
+		bool CheckObjectLoad();
+		
+		//Object hierarchy function
+		void PlaceLinkedChildren(size_t *index);
+		
+		//Link a spawned object to the end of the object list
+		void LinkObject(OBJECT *object);
 		
 		//Object layer function
 		LEVEL_RENDERLAYER GetObjectLayer(bool highPriority, int priority);
@@ -268,10 +418,53 @@ class LEVEL
 		void OscillatoryInit();
 		void OscillatoryUpdate();
 		
+		//Batched object update functions
+		bool BatchObject(OBJECT *object);
+		bool UpdateObjectBatches();
+		void LinkObjectSpawns();
+		
+		//Hash the state that matters to gameplay (the same on every machine running this build)
+		uint32_t Checksum();
+		
 		//Update and draw functions
+		bool UpdateObjects(size_t *index, bool batch);
 		bool UpdateStage();
+		bool CheckUpdateStage();
+		bool CheckBatchScenarios();
 		bool Update();
 		void Draw();
 };
 
 extern LEVELTABLE gLevelTable[];
+
+//If order-insensitive objects are updated in batches, and if every frame's batched object update is checked against a list-order update (given on the command line, the check is slow)
+extern bool gBatchObjects;
+extern bool gCheckObjectBatching;
+
+//Level prefetch class (loads the next level's data on a low-priority thread during gameplay, for the next level to adopt)
+class LEVELPREFETCH
+{
+	public:
+		//Level and players being prefetched
+		LEVELID levelId;
+		const char **players;
+		
+	private:
+		//Staging level, and the thread loading it (on a single low-priority worker, so we never compete with the running level)
+		LEVEL *staged;
+		LOADJOBS loadJobs{1, true};
+		std::thread thread;
+		std::atomic<bool> done{false};
+		std::atomic<bool> cancel{false};
+		
+	public:
+		LEVELPREFETCH(int id, const char *setPlayers[]);
+		~LEVELPREFETCH();
+		
+		//Take our staged level if it's loading for the given players, raising our worker's priority and calling frame until it's finished
+		//if it's not yet (frame returns true to cancel), returns nullptr if it failed, was cancelled, or is for different players
+		LEVEL *Take(const char *takePlayers[], std::function<bool()> frame);
+		
+	private:
+		void ThreadMain();
+};
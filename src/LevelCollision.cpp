@@ -1,20 +1,391 @@
+#include <string.h>
+
 #include "LevelCollision.h"
 #include "Level.h"
 #include "Game.h"
 #include "Log.h"
+#include "Error.h"
+#include "MathUtil.h"
 
 //Get the layout tile at the given x,y coordinate
 TILE *GetTileAt(int16_t x, int16_t y)
 {
-	if (x < 0 || x >= (int16_t)(gLevel->layout.width * 16) || y < 0 || y >= (int16_t)(gLevel->layout.height * 16))
+	if (x < 0 || x >= (int32_t)(gLevel->layout.width * 16) || y < 0 || y >= (int32_t)(gLevel->layout.height * 16))
 		return nullptr;
-	return &gLevel->layout.foreground[(y / 16) * gLevel->layout.width + (x / 16)];
+	return gLevel->layout.GetTile(x / 16, y / 16);
 }
 
 #define TILE_ON_LAYER(alt, lrb, tile) (!(alt ? ((!lrb && !tile->altTop) || (lrb && !tile->altLRB)) : ((!lrb && !tile->norTop) || (lrb && !tile->norLRB))))
 
+//Collision field
+bool BuildCollisionField(LEVEL *level, COLLISIONFIELD *field)
+{
+	LOG(("Building collision field... "));
+	
+	//Each collision tile can be placed with 4 different flips, index these as they're used
+	uint16_t *placedIndex = level->LevelAlloc<uint16_t>(level->collisionTiles * 4);
+	field->tile = level->LevelAlloc<COLLISIONFIELD_TILE>(level->collisionTiles * 4 + 1);
+	if (placedIndex == nullptr || field->tile == nullptr)
+		return Error(level->fail = "Failed to allocate collision field in memory");
+	
+	memset(placedIndex, 0, level->collisionTiles * 4 * sizeof(uint16_t));
+	memset(field->tile, 0, sizeof(COLLISIONFIELD_TILE));
+	field->tiles = 1;
+	
+	//Get the placed collision tile of every chunk tile on each layer (indexed the same way as the layout)
+	size_t chunkTiles = level->chunks * LAYOUT_CHUNK_TILES;
+	for (int layer = 0; layer < COLLISIONLAYER_MAX; layer++)
+	{
+		field->layer[layer] = level->LevelAlloc<uint16_t>(chunkTiles);
+		if (field->layer[layer] == nullptr)
+			return Error(level->fail = "Failed to allocate collision field in memory");
+		
+		for (size_t i = 0; i < chunkTiles; i++)
+		{
+			//Check if this tile has collision on this layer
+			TILE *tile = &level->chunkMapping[i / LAYOUT_CHUNK_TILES].tile[i % LAYOUT_CHUNK_TILES];
+			field->layer[layer][i] = 0;
+			
+			if (tile->tile == 0 || tile->tile >= level->tiles || !TILE_ON_LAYER(LAYER_IS_ALT(layer), LAYER_IS_LRB(layer), tile))
+				continue;
+			
+			TILEMAPPING *tileMap = &level->tileMapping[tile->tile];
+			size_t collisionIndex = LAYER_IS_ALT(layer) ? (tileMap->alternateColTile) : (tileMap->normalColTile);
+			if (collisionIndex == 0 || collisionIndex >= level->collisionTiles)
+				continue;
+			
+			//Get the placed collision tile for this flip, creating it if it hasn't been used yet
+			uint16_t *placed = &placedIndex[collisionIndex * 4 + (tile->xFlip ? 1 : 0) + (tile->yFlip ? 2 : 0)];
+			
+			if (*placed == 0)
+			{
+				COLLISIONTILE *collisionTile = &level->collisionTile[collisionIndex];
+				COLLISIONFIELD_TILE *fieldTile = &field->tile[field->tiles];
+				
+				//Get our angle, reversed if horizontally flipped and inverted if vertically flipped
+				uint8_t angle = collisionTile->angle;
+				if (tile->xFlip)
+					angle = -angle;
+				if (tile->yFlip)
+					angle = (-(angle + 0x40)) - 0x40;
+				fieldTile->angle = angle;
+				
+				//Get our heights, with their positions reversed and signs flipped to match
+				for (int v = 0; v < 0x10; v++)
+				{
+					int8_t heightV = collisionTile->normal[tile->xFlip ? (0xF - v) : v];
+					int8_t heightH = collisionTile->rotated[tile->yFlip ? (0xF - v) : v];
+					fieldTile->heightV[v] = tile->yFlip ? -heightV : heightV;
+					fieldTile->heightH[v] = tile->xFlip ? -heightH : heightH;
+				}
+				
+				*placed = (uint16_t)field->tiles++;
+			}
+			
+			field->layer[layer][i] = *placed;
+		}
+	}
+	
+	#ifdef LEVELCOLLISION_VERIFY
+		if (VerifyCollisionField())
+			return true;
+	#endif
+	
+	LOG(("Success!\n"));
+	return false;
+}
+
+//Get the placed collision tile at the given x,y coordinate (nullptr if there's no collision)
+static inline COLLISIONFIELD_TILE *GetFieldTileAt(int16_t x, int16_t y, COLLISIONLAYER layer)
+{
+	if (x < 0 || x >= (int32_t)(gLevel->layout.width * 16) || y < 0 || y >= (int32_t)(gLevel->layout.height * 16))
+		return nullptr;
+	uint16_t index = gLevel->collisionField.layer[layer][gLevel->layout.GetTileIndex(x / 16, y / 16)];
+	return (index != 0) ? &gLevel->collisionField.tile[index] : nullptr;
+}
+
 //Horizontal collision check
-int16_t GetCollisionH_Tile2(int16_t x, int16_t y, COLLISIONLAYER layer, bool flipped, uint8_t *angle)
+static int16_t GetCollisionH_Tile2(int16_t x, int16_t y, COLLISIONLAYER layer, bool flipped, uint8_t *angle)
+{
+	//Get our placed collision tile
+	COLLISIONFIELD_TILE *tile = GetFieldTileAt(x, y, layer);
+	
+	if (tile != nullptr)
+	{
+		//Get our angle
+		if (angle != nullptr)
+			*angle = tile->angle;
+		
+		//Get our height in the heightmap
+		int8_t height = tile->heightH[y & 0xF];
+		if (flipped)
+			height = -height;
+		
+		//Return surface position
+		if (height > 0)
+		{
+			return 0xF - (height + (x & 0xF));
+		}
+		else if (height < 0)
+		{
+			int16_t distance = x & 0xF;
+			if (height + distance < 0)
+				return ~distance;
+		}
+	}
+	
+	return 0xF - (x & 0xF);
+}
+
+int16_t GetCollisionH(int16_t x, int16_t y, COLLISIONLAYER layer, bool flipped, uint8_t *angle)
+{
+	//Flip our x-position if flipped
+	if (flipped)
+		x ^= 0xF;
+	
+	//Get our placed collision tile
+	COLLISIONFIELD_TILE *tile = GetFieldTileAt(x, y, layer);
+	
+	if (tile != nullptr)
+	{
+		//Get our angle
+		if (angle != nullptr)
+			*angle = tile->angle;
+		
+		//Get our height in the heightmap
+		int8_t height = tile->heightH[y & 0xF];
+		if (flipped)
+			height = -height;
+		
+		//Either return this surface or check the tile above
+		if (height > 0)
+		{
+			if (height != 0x10)
+				return 0xF - (height + (x & 0xF));
+			else
+				return GetCollisionH_Tile2(x - (flipped ? -0x10 : 0x10), y, layer, flipped, angle) - 0x10;
+		}
+		else if (height < 0)
+		{
+			if (height + (x & 0xF) < 0)
+				return GetCollisionH_Tile2(x - (flipped ? -0x10 : 0x10), y, layer, flipped, angle) - 0x10;
+		}
+	}
+	
+	return GetCollisionH_Tile2(x + (flipped ? -0x10 : 0x10), y, layer, flipped, angle) + 0x10;
+}
+
+//Vertical collision
+static int16_t GetCollisionV_Tile2(int16_t x, int16_t y, COLLISIONLAYER layer, bool flipped, uint8_t *angle)
+{
+	//Get our placed collision tile
+	COLLISIONFIELD_TILE *tile = GetFieldTileAt(x, y, layer);
+	
+	if (tile != nullptr)
+	{
+		//Get our angle
+		if (angle != nullptr)
+			*angle = tile->angle;
+		
+		//Get our height in the heightmap
+		int8_t height = tile->heightV[x & 0xF];
+		if (flipped)
+			height = -height;
+		
+		//Return surface position
+		if (height > 0)
+		{
+			return 0xF - (height + (y & 0xF));
+		}
+		else if (height < 0)
+		{
+			int16_t distance = y & 0xF;
+			if (height + distance < 0)
+				return ~distance;
+		}
+	}
+	
+	return 0xF - (y & 0xF);
+}
+
+int16_t GetCollisionV(int16_t x, int16_t y, COLLISIONLAYER layer, bool flipped, uint8_t *angle)
+{
+	//Flip our y-position if flipped
+	if (flipped)
+		y ^= 0xF;
+	
+	//Get our placed collision tile
+	COLLISIONFIELD_TILE *tile = GetFieldTileAt(x, y, layer);
+	
+	if (tile != nullptr)
+	{
+		//Get our angle
+		if (angle != nullptr)
+			*angle = tile->angle;
+		
+		//Get our height in the heightmap
+		int8_t height = tile->heightV[x & 0xF];
+		if (flipped)
+			height = -height;
+		
+		//Either return this surface or check the tile above
+		if (height > 0)
+		{
+			if (height != 0x10)
+				return 0xF - (height + (y & 0xF));
+			else
+				return GetCollisionV_Tile2(x, y - (flipped ? -0x10 : 0x10), layer, flipped, angle) - 0x10;
+		}
+		else if (height < 0)
+		{
+			if (height + (y & 0xF) < 0)
+				return GetCollisionV_Tile2(x, y - (flipped ? -0x10 : 0x10), layer, flipped, angle) - 0x10;
+		}
+	}
+	
+	return GetCollisionV_Tile2(x, y + (flipped ? -0x10 : 0x10), layer, flipped, angle) + 0x10;
+}
+
+//Batched collision check (gives the same results as GetCollisionV and GetCollisionH, checking runs of sensors facing the same way together)
+struct SENSOR_LOOKUP
+{
+	//The level's lookups, kept in locals (our writes to the sensors could otherwise alias them, reloading them for every sensor)
+	const COLLISIONFIELD_TILE *tile;
+	const uint16_t *const *layer;
+	const uint16_t *chunk;
+	size_t chunkWidth;
+	int32_t width, height;
+	
+	//Get the placed collision tile at the given position (the no collision tile if outside of the layout)
+	inline const COLLISIONFIELD_TILE *GetTile(int16_t x, int16_t y, COLLISIONLAYER checkLayer, bool *found) const
+	{
+		uint16_t index = 0;
+		if (x >= 0 && x < width && y >= 0 && y < height)
+		{
+			size_t tx = (uint16_t)x >> 4, ty = (uint16_t)y >> 4;
+			index = layer[checkLayer][chunk[(ty >> 3) * chunkWidth + (tx >> 3)] * LAYOUT_CHUNK_TILES + (((ty & 7) << 3) | (tx & 7))];
+		}
+		*found = index != 0;
+		return &tile[index];
+	}
+};
+
+template <COLLISIONDIRECTION direction> static void GetCollisionSensorRun(const SENSOR_LOOKUP &lookup, COLLISIONSENSOR *sensor, size_t count)
+{
+	//Check a run of sensors facing the same way (so which way that is is known here, and isn't branched on for every sensor)
+	const bool vertical = direction <= COLLISIONDIRECTION_UP;
+	const bool flipped = (direction & 1) != 0;
+	const int16_t offset = flipped ? -0x10 : 0x10;
+	
+	for (size_t i = 0; i < count; i++)
+	{
+		//Get our position, flipped along the direction we're checking in
+		int16_t x = sensor[i].x ^ ((!vertical && flipped) ? 0xF : 0);
+		int16_t y = sensor[i].y ^ ((vertical && flipped) ? 0xF : 0);
+		COLLISIONLAYER layer = sensor[i].layer;
+		uint8_t angle = sensor[i].angle;
+		
+		//Check our first tile, and either use its surface, or get which tile to check next (behind or in front of us)
+		bool found;
+		const COLLISIONFIELD_TILE *tile = lookup.GetTile(x, y, layer, &found);
+		if (found)
+			angle = tile->angle;
+		
+		int8_t surface = vertical ? tile->heightV[x & 0xF] : tile->heightH[y & 0xF]; //The no collision tile is all 0
+		if (flipped)
+			surface = -surface;
+		
+		int16_t position = (vertical ? y : x) & 0xF;
+		int16_t distance;
+		
+		if (surface > 0 && surface != 0x10)
+		{
+			distance = 0xF - (surface + position);
+		}
+		else
+		{
+			int16_t step = (surface == 0x10 || (surface < 0 && surface + position < 0)) ? -offset : offset;
+			
+			//Check the second tile
+			int16_t x2 = vertical ? x : (x + step);
+			int16_t y2 = vertical ? (y + step) : y;
+			int16_t position2 = (vertical ? y2 : x2) & 0xF;
+			
+			tile = lookup.GetTile(x2, y2, layer, &found);
+			if (found)
+				angle = tile->angle;
+			
+			surface = vertical ? tile->heightV[x2 & 0xF] : tile->heightH[y2 & 0xF];
+			if (flipped)
+				surface = -surface;
+			
+			//Get the second tile's surface position, and offset it back to the first tile
+			distance = 0xF - position2;
+			if (surface > 0)
+				distance = 0xF - (surface + position2);
+			else if (surface < 0 && surface + position2 < 0)
+				distance = ~position2;
+			distance += (step == offset) ? 0x10 : -0x10;
+		}
+		
+		sensor[i].distance = distance;
+		sensor[i].angle = angle;
+	}
+}
+
+void GetCollisionSensors(COLLISIONSENSOR *sensor, size_t sensors)
+{
+	SENSOR_LOOKUP lookup;
+	lookup.tile = gLevel->collisionField.tile;
+	lookup.layer = gLevel->collisionField.layer;
+	lookup.chunk = gLevel->layout.chunk;
+	lookup.chunkWidth = gLevel->layout.chunkWidth;
+	lookup.width = (int32_t)(gLevel->layout.width * 16);
+	lookup.height = (int32_t)(gLevel->layout.height * 16);
+	
+	//Check our sensors in runs facing the same way
+	for (size_t i = 0; i < sensors;)
+	{
+		size_t run = 1;
+		while (i + run < sensors && sensor[i + run].direction == sensor[i].direction)
+			run++;
+		
+		switch (sensor[i].direction)
+		{
+			case COLLISIONDIRECTION_DOWN:
+				GetCollisionSensorRun<COLLISIONDIRECTION_DOWN>(lookup, sensor + i, run);
+				break;
+			case COLLISIONDIRECTION_UP:
+				GetCollisionSensorRun<COLLISIONDIRECTION_UP>(lookup, sensor + i, run);
+				break;
+			case COLLISIONDIRECTION_RIGHT:
+				GetCollisionSensorRun<COLLISIONDIRECTION_RIGHT>(lookup, sensor + i, run);
+				break;
+			case COLLISIONDIRECTION_LEFT:
+				GetCollisionSensorRun<COLLISIONDIRECTION_LEFT>(lookup, sensor + i, run);
+				break;
+		}
+		i += run;
+	}
+}
+
+int16_t GetCollisionSensor(int16_t x, int16_t y, COLLISIONLAYER layer, COLLISIONDIRECTION direction, uint8_t *angle)
+{
+	//Check a single sensor
+	COLLISIONSENSOR sensor = {x, y, layer, direction, 0, (angle != nullptr) ? *angle : (uint8_t)0};
+	GetCollisionSensors(&sensor, 1);
+	
+	//Odd angles mark flat tiles, use the cardinal angle of the direction we checked in for these
+	static const uint8_t cardinalAngle[] = {0x00, 0x80, 0xC0, 0x40};
+	if (angle != nullptr)
+		*angle = (sensor.angle & 1) ? cardinalAngle[direction] : sensor.angle;
+	return sensor.distance;
+}
+
+#ifdef LEVELCOLLISION_VERIFY
+//Original collision checks (looking up the layout tile, tile mapping, and collision tile on every probe)
+
+static int16_t GetCollisionH_Tile2_Reference(int16_t x, int16_t y, COLLISIONLAYER layer, bool flipped, uint8_t *angle)
 {
 	//Get our chunk tile
 	TILE *tile = GetTileAt(x, y);
@@ -67,7 +438,7 @@ int16_t GetCollisionH_Tile2(int16_t x, int16_t y, COLLISIONLAYER layer, bool fli
 	return 0xF - (x & 0xF);
 }
 
-int16_t GetCollisionH(int16_t x, int16_t y, COLLISIONLAYER layer, bool flipped, uint8_t *angle)
+static int16_t GetCollisionH_Reference(int16_t x, int16_t y, COLLISIONLAYER layer, bool flipped, uint8_t *angle)
 {
 	//Flip our x-position if flipped
 	if (flipped)
@@ -113,21 +484,20 @@ int16_t GetCollisionH(int16_t x, int16_t y, COLLISIONLAYER layer, bool flipped,
 				if (height != 0x10)
 					return 0xF - (height + (x & 0xF));
 				else
-					return GetCollisionH_Tile2(x - (flipped ? -0x10 : 0x10), y, layer, flipped, angle) - 0x10;
+					return GetCollisionH_Tile2_Reference(x - (flipped ? -0x10 : 0x10), y, layer, flipped, angle) - 0x10;
 			}
 			else if (height < 0)
 			{
 				if (height + (x & 0xF) < 0)
-					return GetCollisionH_Tile2(x - (flipped ? -0x10 : 0x10), y, layer, flipped, angle) - 0x10;
+					return GetCollisionH_Tile2_Reference(x - (flipped ? -0x10 : 0x10), y, layer, flipped, angle) - 0x10;
 			}
 		}
 	}
 	
-	return GetCollisionH_Tile2(x + (flipped ? -0x10 : 0x10), y, layer, flipped, angle) + 0x10;
+	return GetCollisionH_Tile2_Reference(x + (flipped ? -0x10 : 0x10), y, layer, flipped, angle) + 0x10;
 }
 
-//Vertical collision
-int16_t GetCollisionV_Tile2(int16_t x, int16_t y, COLLISIONLAYER layer, bool flipped, uint8_t *angle)
+static int16_t GetCollisionV_Tile2_Reference(int16_t x, int16_t y, COLLISIONLAYER layer, bool flipped, uint8_t *angle)
 {
 	//Get our chunk tile
 	TILE *tile = GetTileAt(x, y);
@@ -181,7 +551,7 @@ int16_t GetCollisionV_Tile2(int16_t x, int16_t y, COLLISIONLAYER layer, bool fli
 	return 0xF - (y & 0xF);
 }
 
-int16_t GetCollisionV(int16_t x, int16_t y, COLLISIONLAYER layer, bool flipped, uint8_t *angle)
+static int16_t GetCollisionV_Reference(int16_t x, int16_t y, COLLISIONLAYER layer, bool flipped, uint8_t *angle)
 {
 	//Flip our y-position if flipped
 	if (flipped)
@@ -227,15 +597,60 @@ int16_t GetCollisionV(int16_t x, int16_t y, COLLISIONLAYER layer, bool flipped,
 				if (height != 0x10)
 					return 0xF - (height + (y & 0xF));
 				else
-					return GetCollisionV_Tile2(x, y - (flipped ? -0x10 : 0x10), layer, flipped, angle) - 0x10;
+					return GetCollisionV_Tile2_Reference(x, y - (flipped ? -0x10 : 0x10), layer, flipped, angle) - 0x10;
 			}
 			else if (height < 0)
 			{
 				if (height + (y & 0xF) < 0)
-					return GetCollisionV_Tile2(x, y - (flipped ? -0x10 : 0x10), layer, flipped, angle) - 0x10;
+					return GetCollisionV_Tile2_Reference(x, y - (flipped ? -0x10 : 0x10), layer, flipped, angle) - 0x10;
 			}
 		}
 	}
 	
-	return GetCollisionV_Tile2(x, y + (flipped ? -0x10 : 0x10), layer, flipped, angle) + 0x10;
+	return GetCollisionV_Tile2_Reference(x, y + (flipped ? -0x10 : 0x10), layer, flipped, angle) + 0x10;
+}
+
+//Verify the collision field gives the exact same results as the original checks everywhere in the level
+bool VerifyCollisionField()
+{
+	int width = (int)(gLevel->layout.width * 16);
+	int height = (int)(gLevel->layout.height * 16);
+	
+	for (int layer = 0; layer < COLLISIONLAYER_MAX; layer++)
+	{
+		for (int flipped = 0; flipped < 2; flipped++)
+		{
+			for (int y = -0x20; y < height + 0x20; y++)
+			{
+				for (int x = -0x20; x < width + 0x20; x++)
+				{
+					uint8_t angle = 0xAA, referenceAngle = 0xAA;
+					if (GetCollisionH(x, y, (COLLISIONLAYER)layer, flipped, &angle) != GetCollisionH_Reference(x, y, (COLLISIONLAYER)layer, flipped, &referenceAngle) || angle != referenceAngle)
+						return Error(gLevel->fail = "Collision field doesn't match the horizontal collision check");
+					
+					angle = referenceAngle = 0xAA;
+					if (GetCollisionV(x, y, (COLLISIONLAYER)layer, flipped, &angle) != GetCollisionV_Reference(x, y, (COLLISIONLAYER)layer, flipped, &referenceAngle) || angle != referenceAngle)
+						return Error(gLevel->fail = "Collision field doesn't match the vertical collision check");
+					
+					//Check the batched collision check too
+					COLLISIONSENSOR sensor[2] = {
+						{(int16_t)x, (int16_t)y, (COLLISIONLAYER)layer, flipped ? COLLISIONDIRECTION_LEFT : COLLISIONDIRECTION_RIGHT, 0, 0xAA},
+						{(int16_t)x, (int16_t)y, (COLLISIONLAYER)layer, flipped ? COLLISIONDIRECTION_UP : COLLISIONDIRECTION_DOWN, 0, 0xAA},
+					};
+					GetCollisionSensors(sensor, 2);
+					
+					angle = referenceAngle = 0xAA;
+					if (sensor[0].distance != GetCollisionH_Reference(x, y, (COLLISIONLAYER)layer, flipped, &referenceAngle) || sensor[0].angle != referenceAngle)
+						return Error(gLevel->fail = "Batched collision check doesn't match the horizontal collision check");
+					
+					angle = referenceAngle = 0xAA;
+					if (sensor[1].distance != GetCollisionV_Reference(x, y, (COLLISIONLAYER)layer, flipped, &referenceAngle) || sensor[1].angle != referenceAngle)
+						return Error(gLevel->fail = "Batched collision check doesn't match the vertical collision check");
+				}
+			}
+		}
+	}
+	
+	return false;
 }
+#endif
@@ -1,16 +1,69 @@
 #pragma once
+#include <stddef.h>
 #include <stdint.h>
 
+class LEVEL;
+
+//#define LEVELCOLLISION_VERIFY	//Compare the collision field against the original per-probe tile lookups over the whole level once it's built
+
 enum COLLISIONLAYER
 {
 	COLLISIONLAYER_NORMAL_TOP,
 	COLLISIONLAYER_NORMAL_LRB,
 	COLLISIONLAYER_ALTERNATE_TOP,
 	COLLISIONLAYER_ALTERNATE_LRB,
+	COLLISIONLAYER_MAX,
+};
+
+enum COLLISIONDIRECTION
+{
+	COLLISIONDIRECTION_DOWN,	//GetCollisionV, not flipped
+	COLLISIONDIRECTION_UP,		//GetCollisionV, flipped
+	COLLISIONDIRECTION_RIGHT,	//GetCollisionH, not flipped
+	COLLISIONDIRECTION_LEFT,	//GetCollisionH, flipped
 };
 
 #define LAYER_IS_ALT(layer)	(layer == COLLISIONLAYER_ALTERNATE_TOP || layer == COLLISIONLAYER_ALTERNATE_LRB)
 #define LAYER_IS_LRB(layer)	(layer == COLLISIONLAYER_NORMAL_LRB || layer == COLLISIONLAYER_ALTERNATE_LRB)
 
+//Collision tile as placed in the layout (heights are indexed by position within the layout tile, with its flipping already applied)
+struct COLLISIONFIELD_TILE
+{
+	int8_t heightV[0x10];	//Heights for vertical probes, by column
+	int8_t heightH[0x10];	//Widths for horizontal probes, by row
+	uint8_t angle;
+};
+
+//Collision field (each layout tile's collision on each layer, precomputed when the level is loaded)
+struct COLLISIONFIELD
+{
+	//Placed collision tiles (index 0 is used for no collision)
+	COLLISIONFIELD_TILE *tile = nullptr;
+	size_t tiles = 0;
+	
+	//Placed collision tile index of each layout tile on each layer
+	uint16_t *layer[COLLISIONLAYER_MAX] = {nullptr};
+};
+
+//Collision sensor (for checking many positions at once)
+struct COLLISIONSENSOR
+{
+	//Position, layer, and direction to check in
+	int16_t x, y;
+	COLLISIONLAYER layer;
+	COLLISIONDIRECTION direction;
+	
+	//Distance to the surface, and its angle (only written if a collision tile is found, so should be given a default)
+	int16_t distance;
+	uint8_t angle;
+};
+
+bool BuildCollisionField(LEVEL *level, COLLISIONFIELD *field);
+#ifdef LEVELCOLLISION_VERIFY
+	bool VerifyCollisionField();
+#endif
+
 int16_t GetCollisionH(int16_t x, int16_t y, COLLISIONLAYER layer, bool flipped, uint8_t *angle);
 int16_t GetCollisionV(int16_t x, int16_t y, COLLISIONLAYER layer, bool flipped, uint8_t *angle);
+void GetCollisionSensors(COLLISIONSENSOR *sensor, size_t sensors);
+int16_t GetCollisionSensor(int16_t x, int16_t y, COLLISIONLAYER layer, COLLISIONDIRECTION direction, uint8_t *angle);
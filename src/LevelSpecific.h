@@ -1,8 +1,21 @@
 #pragma once
+#include <stdint.h>
 #include "Background.h"
 
 typedef void (*PALETTECYCLEFUNCTION)();
 
+//Level specific state (held by the level, rather than in static locals, so it's reset with each level and saved in savestates)
+struct LEVELSPECIFIC_STATE
+{
+	//Palette cycle
+	int paletteTimer = 0;
+	
+	//Background scrolling
+	uint32_t cloudScroll[3] = {0, 0, 0};	//GHZ clouds
+	int horWaterTimer = 4;					//EHZ horizon water ripple
+	uint16_t horWaterRipple = 0;
+};
+
 void GHZ_PaletteCycle();
 void EHZ_PaletteCycle();
 void GHZ_Background(BACKGROUND *background, bool doScroll, int cameraX, int cameraY);
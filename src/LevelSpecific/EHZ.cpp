@@ -4,7 +4,7 @@
 void EHZ_PaletteCycle()
 {
 	//Waterfall and water palette cycle
-	static int timer = 0;
+	int &timer = gLevel->levelSpecific.paletteTimer;
 	
 	if (--timer < 0)
 	{
@@ -50,8 +50,8 @@ void EHZ_Background(BACKGROUND *background, bool doScroll, int cameraX, int came
 	background->DrawStrip(&sky, LEVEL_RENDERLAYER_BACKGROUND, 0, -scrollBG1, -scrollBG1);
 	
 	//Rippling water at the horizon (change ripple every 8 frames)
-	static int horWaterTimer = 4;
-	static uint16_t horWaterRipple = 0;
+	int &horWaterTimer = gLevel->levelSpecific.horWaterTimer;
+	uint16_t &horWaterRipple = gLevel->levelSpecific.horWaterRipple;
 	
 	if (doScroll)
 	{
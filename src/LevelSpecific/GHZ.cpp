@@ -4,7 +4,7 @@
 void GHZ_PaletteCycle()
 {
 	//Waterfall and water palette cycle
-	static int timer = 0;
+	int &timer = gLevel->levelSpecific.paletteTimer;
 	
 	if (--timer < 0)
 	{
@@ -34,7 +34,7 @@ void GHZ_Background(BACKGROUND *background, bool doScroll, int cameraX, int came
 	int16_t backY = -(cameraY / -0x20 + 0x20);
 	
 	//Scroll clouds
-	static uint32_t cloudScroll[3] = {0, 0, 0};
+	uint32_t *cloudScroll = gLevel->levelSpecific.cloudScroll;
 	if (doScroll)
 	{
 		(cloudScroll[0] += 0x10) %= (background->texture->width * 0x10);
@@ -9,6 +9,19 @@ template <typename T> struct LL_NODE
 	LL_NODE<T> *prev = nullptr;
 };
 
+template <typename T> class LL_ITERATOR
+{
+	public:
+		LL_NODE<T> *node;
+		
+	public:
+		LL_ITERATOR(LL_NODE<T> *startNode) : node(startNode) { return; }
+		
+		inline T &operator*() { return node->node_entry; }
+		inline LL_ITERATOR &operator++() { node = node->next; return *this; }
+		inline bool operator!=(const LL_ITERATOR &other) const { return node != other.node; }
+};
+
 template <typename T> class LINKEDLIST
 {
 	public:
@@ -16,6 +29,10 @@ template <typename T> class LINKEDLIST
 		LL_NODE<T> *tail = nullptr;
 		size_t llSize = 0;
 		
+		//Last node found by node_at, so walking the list by index doesn't restart from the head every time
+		LL_NODE<T> *cursorNode = nullptr;
+		size_t cursorIndex = 0;
+		
 	public:
 		//Constructor and destructor
 		LINKEDLIST() { return; }
@@ -39,6 +56,7 @@ template <typename T> class LINKEDLIST
 				head->prev = newNode;
 			head = newNode;
 			
+			cursorNode = nullptr;
 			llSize++;
 			return newNode;
 		}
@@ -64,6 +82,30 @@ template <typename T> class LINKEDLIST
 			return newNode;
 		}
 		
+		inline LL_NODE<T> *insert(size_t index, T push)
+		{
+			//Link to the back if inserting at the end
+			LL_NODE<T> *at = node_at(index);
+			if (at == nullptr)
+				return link_back(push);
+			
+			//Allocate a new node and link it behind the node at the given index
+			LL_NODE<T> *newNode = new LL_NODE<T>;
+			newNode->node_entry = push;
+			newNode->next = at;
+			newNode->prev = at->prev;
+			
+			if (at->prev != nullptr)
+				at->prev->next = newNode;
+			else
+				head = newNode;
+			at->prev = newNode;
+			
+			cursorNode = nullptr;
+			llSize++;
+			return newNode;
+		}
+		
 		//Position identification
 		inline size_t pos_of_node(LL_NODE<T> want)
 		{
@@ -90,12 +132,32 @@ template <typename T> class LINKEDLIST
 		//Random access and size
 		inline LL_NODE<T> *node_at(size_t index)
 		{
-			//Find the node at the given index (from head)
+			if (index >= llSize)
+				return nullptr;
+			
+			//Start from the head, tail, or our cursor, whichever is closest
+			LL_NODE<T> *node = head;
 			size_t i = 0;
-			for (LL_NODE<T> *node = head; node != nullptr; node = node->next)
-				if (i++ == index)
-					return node;
-			return nullptr;
+			if (index > llSize / 2)
+			{
+				node = tail;
+				i = llSize - 1;
+			}
+			if (cursorNode != nullptr && (index >= cursorIndex ? (index - cursorIndex) : (cursorIndex - index)) < (index >= i ? (index - i) : (i - index)))
+			{
+				node = cursorNode;
+				i = cursorIndex;
+			}
+			
+			//Walk to the node at the given index
+			for (; i < index; i++)
+				node = node->next;
+			for (; i > index; i--)
+				node = node->prev;
+			
+			cursorNode = node;
+			cursorIndex = index;
+			return node;
 		}
 		
 		inline T at(size_t index)
@@ -103,7 +165,7 @@ template <typename T> class LINKEDLIST
 			//Find the given entry at the given index (from head)
 			return node_at(index)->node_entry;
 		}
-
+		
 		inline size_t size() { return llSize; }
 		
 		//Erasers
@@ -127,6 +189,7 @@ template <typename T> class LINKEDLIST
 				return;
 			
 			//Adjust linked list correctly and destroy node
+			cursorNode = nullptr;
 			if (node->prev != nullptr)
 				node->prev->next = node->next;
 			else
@@ -148,6 +211,10 @@ template <typename T> class LINKEDLIST
 			tail = nullptr;
 		}
 		
+		//Iteration
+		inline LL_ITERATOR<T> begin() { return LL_ITERATOR<T>(head); }
+		inline LL_ITERATOR<T> end() { return LL_ITERATOR<T>(nullptr); }
+		
 		//Access operator
 		T operator[](size_t index) { return at(index); };
 };
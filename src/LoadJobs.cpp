@@ -0,0 +1,188 @@
+#include <chrono>
+#ifdef WINDOWS
+	#include <windows.h>
+#else
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+
+#include "LoadJobs.h"
+#include "Log.h"
+
+//Constructor and destructor
+LOADJOBS::LOADJOBS(size_t setMaxWorkers, bool setLowPriority) : maxWorkers(setMaxWorkers), lowPriority(setLowPriority)
+{
+	//Clamp our worker count to what we can hold
+	if (maxWorkers < 1)
+		maxWorkers = 1;
+	if (maxWorkers > LOADJOBS_MAX_THREADS)
+		maxWorkers = LOADJOBS_MAX_THREADS;
+}
+
+LOADJOBS::~LOADJOBS()
+{
+	//Free our jobs
+	CLEAR_INSTANCE_ARRAY(job);
+}
+
+//Job functions
+size_t LOADJOBS::Add(LOADJOBFUNCTION function, std::initializer_list<size_t> dependencies)
+{
+	//Create our job, and link it to the jobs it depends on
+	LOADJOB *newJob = new LOADJOB;
+	newJob->function = function;
+	
+	size_t index = job.size();
+	for (size_t dependency : dependencies)
+	{
+		if (dependency >= index)
+			continue;
+		job[dependency]->dependents.link_back(index);
+		newJob->dependencies++;
+	}
+	
+	job.link_back(newJob);
+	return index;
+}
+
+static void SetBackgroundPriority(std::thread::native_handle_type thread, bool background)
+{
+	//Run the given thread only when there's nothing else to run (where supported), or back at normal priority
+	#ifdef WINDOWS
+		SetThreadPriority(thread, background ? THREAD_PRIORITY_IDLE : THREAD_PRIORITY_NORMAL);
+	#elif defined(SCHED_IDLE)
+		sched_param param = {};
+		pthread_setschedparam(thread, background ? SCHED_IDLE : SCHED_OTHER, &param);
+	#else
+		sched_param param = {};
+		param.sched_priority = background ? sched_get_priority_min(SCHED_OTHER) : 0;
+		pthread_setschedparam(thread, SCHED_OTHER, &param);
+	#endif
+}
+
+void LOADJOBS::WorkerMain()
+{
+	//Lower our priority if we're loading in the background (under our lock, so we can't miss being raised)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (lowPriority)
+		{
+			#ifdef WINDOWS
+				SetBackgroundPriority(GetCurrentThread(), true);
+			#else
+				SetBackgroundPriority(pthread_self(), true);
+			#endif
+		}
+	}
+	
+	while (1)
+	{
+		//Wait for a job to be ready
+		size_t index;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			readyCondition.wait(lock, [&]{ return stop || pendingJobs == 0 || ready.size() != 0; });
+			if (stop || pendingJobs == 0)
+				return;
+			
+			index = ready.back();
+			ready.pop_back();
+			runningJobs++;
+		}
+		
+		//Run our job
+		const char *jobFail = job[index]->function();
+		
+		//Release our dependents, or stop every other worker if we failed
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			runningJobs--;
+			pendingJobs--;
+			
+			if (jobFail != nullptr)
+			{
+				if (fail == nullptr)
+					fail = jobFail;
+				stop = true;
+			}
+			else
+			{
+				for (size_t dependent : job[index]->dependents)
+					if (--job[dependent]->dependencies == 0)
+						ready.link_back(dependent);
+			}
+		}
+		
+		readyCondition.notify_all();
+		doneCondition.notify_one();
+	}
+}
+
+bool LOADJOBS::Run(std::function<bool()> frame)
+{
+	//Get our initially ready jobs (in reverse, so they're started in the order they were added)
+	pendingJobs = job.size();
+	for (size_t i = job.size(); i-- > 0;)
+		if (job[i]->dependencies == 0)
+			ready.link_back(i);
+	
+	//Start a worker thread per hardware thread, but no more than we were given or have jobs (under our lock, as RaisePriority goes through them)
+	size_t startWorkers = std::thread::hardware_concurrency();
+	if (startWorkers < 1)
+		startWorkers = 1;
+	if (startWorkers > maxWorkers)
+		startWorkers = maxWorkers;
+	if (startWorkers > job.size())
+		startWorkers = job.size();
+	
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (workers = 0; workers < startWorkers; workers++)
+			worker[workers] = std::thread(&LOADJOBS::WorkerMain, this);
+	}
+	LOG(("Load jobs: %d jobs on %d threads\n", (int)job.size(), (int)startWorkers));
+	
+	//Present frames until every job is done (or we've stopped, and the running jobs have finished)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		while (!(pendingJobs == 0 || (stop && runningJobs == 0)))
+		{
+			if (doneCondition.wait_for(lock, std::chrono::milliseconds(LOADJOBS_FRAME_WAIT), [&]{ return pendingJobs == 0 || (stop && runningJobs == 0); }))
+				break;
+			
+			lock.unlock();
+			bool cancel = frame();
+			lock.lock();
+			
+			if (cancel && !stop)
+			{
+				stop = true;
+				readyCondition.notify_all();
+			}
+		}
+	}
+	
+	//Wait for our worker threads to finish (no longer listing them for RaisePriority)
+	size_t joinWorkers;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		joinWorkers = workers;
+		workers = 0;
+	}
+	for (size_t i = 0; i < joinWorkers; i++)
+		worker[i].join();
+	
+	return stop || fail != nullptr;
+}
+
+void LOADJOBS::RaisePriority()
+{
+	//Raise our running workers, and any that have yet to start won't lower themselves
+	std::lock_guard<std::mutex> lock(mutex);
+	if (!lowPriority)
+		return;
+	lowPriority = false;
+	
+	for (size_t i = 0; i < workers; i++)
+		SetBackgroundPriority(worker[i].native_handle(), false);
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <stddef.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <initializer_list>
+
+#include "Array.h"
+
+//Load job constants
+#define LOADJOBS_MAX_THREADS	8	//Maximum worker threads loading at once
+#define LOADJOBS_FRAME_WAIT		1	//Milliseconds the main thread waits for our jobs between presenting frames
+
+//Load job (a self-contained load that returns its failure, or nullptr on success)
+typedef std::function<const char*()> LOADJOBFUNCTION;
+
+struct LOADJOB
+{
+	LOADJOBFUNCTION function;
+	size_t dependencies = 0;	//Jobs that have to finish before we can start
+	ARRAY<size_t> dependents;	//Jobs waiting on us
+};
+
+//Load job system class (runs a graph of loads on a pool of worker threads, while the main thread keeps presenting frames)
+class LOADJOBS
+{
+	public:
+		//Failure (of the first job to fail)
+		const char *fail = nullptr;
+	
+	private:
+		//Jobs, and the ones ready to run
+		ARRAY<LOADJOB*> job;
+		ARRAY<size_t> ready;
+		
+		//Worker threads
+		std::thread worker[LOADJOBS_MAX_THREADS];
+		size_t workers = 0;
+		size_t maxWorkers;
+		bool lowPriority;	//Guarded by our mutex, as it can be raised while we're running
+		
+		//Synchronization
+		std::mutex mutex;
+		std::condition_variable readyCondition;
+		std::condition_variable doneCondition;
+		size_t pendingJobs = 0;
+		size_t runningJobs = 0;
+		bool stop = false;
+	
+	public:
+		LOADJOBS(size_t setMaxWorkers = LOADJOBS_MAX_THREADS, bool setLowPriority = false);
+		~LOADJOBS();
+		
+		//Add a job, which only starts once the given (previously added) jobs have finished, returns the job's index
+		size_t Add(LOADJOBFUNCTION function, std::initializer_list<size_t> dependencies = {});
+		
+		//Run every job, calling frame on the main thread until they're done (frame returns true to cancel), returns true on failure or cancel
+		bool Run(std::function<bool()> frame);
+		
+		//Raise our workers to normal priority, if we're loading in the background (for when we're now being waited on)
+		void RaisePriority();
+	
+	private:
+		void WorkerMain();
+};
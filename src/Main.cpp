@@ -1,3 +1,5 @@
+#include <string.h>
+
 #include "Log.h"
 #include "Filesystem.h"
 #include "Render.h"
@@ -5,6 +7,9 @@
 #include "Input.h"
 #include "Error.h"
 #include "Game.h"
+#include "Netplay.h"
+#include "Benchmark.h"
+#include "Level.h"
 
 //Include backend cores
 #include "Backend/Core.h"
@@ -19,20 +24,29 @@
 
 int main(int argc, char *argv[])
 {
-	(void)argc; (void)argv;
-	
 	#ifdef ENABLE_NXLINK
 		//Enable NXLink for Switch debugging
 		socketInitializeDefault();
 		nxlinkStdio();
 	#endif
 	
-	//Initialize game sub-systems and backend core, then enter game loop
+	//Update order-insensitive objects in batches, and check the batched object update against list order every frame, if asked to
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-batchobjects"))
+			gBatchObjects = true;
+		else if (!strcmp(argv[i], "-checkbatching"))
+			gCheckObjectBatching = true;
+	}
+	
+	//Initialize game sub-systems and backend core (and netplay or the benchmark, if given on the command line), then enter game loop
 	bool error = false;
-	if ((error = (Backend_InitCore() || InitializePath() || InitializeRender() || InitializeAudio() || InitializeInput())) == false)
+	if ((error = (Backend_InitCore() || InitializePath() || InitializeRender() || InitializeAudio() || InitializeInput() || InitializeNetplay(argc, argv) || InitializeBenchmark(argc, argv))) == false)
 		error = EnterGameLoop();
 	
 	//End game sub-systems and backend core
+	QuitBenchmark();
+	QuitNetplay();
 	QuitInput();
 	QuitAudio();
 	QuitRender();
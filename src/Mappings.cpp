@@ -32,16 +32,21 @@ MAPPINGS::MAPPINGS(std::string path)
 	}
 	
 	//Read from the file
+	uint16_t *data = new uint16_t[size * 6];
+	fp.ReadBE16Array(data, size * 6);
+	
 	for (size_t i = 0; i < size; i++)
 	{
-		rect[i].x = fp.ReadBE16();
-		rect[i].y = fp.ReadBE16();
-		rect[i].w = fp.ReadBE16();
-		rect[i].h = fp.ReadBE16();
-		origin[i].x = (int16_t)fp.ReadBE16();
-		origin[i].y = (int16_t)fp.ReadBE16();
+		rect[i].x = data[i * 6 + 0];
+		rect[i].y = data[i * 6 + 1];
+		rect[i].w = data[i * 6 + 2];
+		rect[i].h = data[i * 6 + 3];
+		origin[i].x = (int16_t)data[i * 6 + 4];
+		origin[i].y = (int16_t)data[i * 6 + 5];
 	}
 	
+	delete[] data;
+	
 	LOG(("Success!\n"));
 }
 
@@ -108,27 +108,32 @@ uint8_t GetAtan(int16_t x, int16_t y)
 	return angle;
 }
 
-uint32_t RandomNumber()
+//Random number generator
+struct M68KREG
 {
-	struct M68KREG
+	union
 	{
-		union
+		struct
 		{
-			struct
-			{
-				#if ENDIAN == BIG
-					//Big endian - high word first, low word second
-					uint16_t high;
-					uint16_t low;
-				#else
-					//Little endian - low word first, high word second
-					uint16_t low;
-					uint16_t high;
-				#endif
-			} w;
-			uint32_t l = 0x00000000;
-		};
-	} static seed;
+			#if ENDIAN == BIG
+				//Big endian - high word first, low word second
+				uint16_t high;
+				uint16_t low;
+			#else
+				//Little endian - low word first, high word second
+				uint16_t low;
+				uint16_t high;
+			#endif
+		} w;
+		uint32_t l = 0x00000000;
+	};
+};
+
+static M68KREG randomSeed;
+
+uint32_t RandomNumber()
+{
+	M68KREG &seed = randomSeed;
 	
 	//Re-seed if 0
 	if (seed.l == 0)
@@ -147,4 +152,7 @@ uint32_t RandomNumber()
 	seed.w.high = retSeed.w.low;	//move.w	d0,d1
 	
 	return retSeed.l;
-}
\ No newline at end of file
+}
+
+uint32_t GetRandomSeed() { return randomSeed.l; }
+void SetRandomSeed(uint32_t seed) { randomSeed.l = seed; }
\ No newline at end of file
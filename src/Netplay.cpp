@@ -0,0 +1,598 @@
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+#ifdef WINDOWS
+	#include <winsock2.h>
+	#include <ws2tcpip.h>
+#else
+	#include <sys/types.h>
+	#include <sys/socket.h>
+	#include <netinet/in.h>
+	#include <netdb.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+#include "Netplay.h"
+#include "Game.h"
+#include "MathUtil.h"
+#include "Error.h"
+#include "Log.h"
+
+//Netplay session global
+NETPLAY *gNetplay = nullptr;
+
+//Packed input bits
+#define INPUT_START	(1 << 0)
+#define INPUT_A		(1 << 1)
+#define INPUT_B		(1 << 2)
+#define INPUT_C		(1 << 3)
+#define INPUT_RIGHT	(1 << 4)
+#define INPUT_LEFT	(1 << 5)
+#define INPUT_DOWN	(1 << 6)
+#define INPUT_UP	(1 << 7)
+
+//Size of a packet with the given number of inputs
+#define PACKET_SIZE(inputs)	(offsetof(NETPLAY_PACKET, input) + (inputs))
+
+//Socket helpers
+static void CloseSocket(intptr_t sock)
+{
+	#ifdef WINDOWS
+		closesocket((SOCKET)sock);
+	#else
+		close((int)sock);
+	#endif
+}
+
+static bool SetNonBlocking(intptr_t sock)
+{
+	#ifdef WINDOWS
+		u_long nonBlocking = 1;
+		return ioctlsocket((SOCKET)sock, FIONBIO, &nonBlocking) != 0;
+	#else
+		int flags = fcntl((int)sock, F_GETFL, 0);
+		return flags < 0 || fcntl((int)sock, F_SETFL, flags | O_NONBLOCK) < 0;
+	#endif
+}
+
+static inline uint32_t NextRandom(uint32_t *seed)
+{
+	//Our own generator (the level's is part of its state, so we can't touch it)
+	*seed = *seed * 1103515245 + 12345;
+	return *seed >> 16;
+}
+
+static inline double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//Constructor and destructor
+NETPLAY::NETPLAY(const NETPLAY_CONFIG &setConfig) : config(setConfig)
+{
+	LOG(("%s netplay on port %d...\n", config.host ? "Hosting" : "Joining", config.port));
+	
+	//Get our controllers, and seed our simulated conditions and soak test input differently for each side
+	localIndex = config.host ? 0 : 1;
+	remoteIndex = config.host ? 1 : 0;
+	lossSeed = config.host ? 0x4C4F5353 : 0x53534F4C;
+	soakSeed = config.host ? 0x534F414B : 0x4B414F53;
+	
+	#ifdef WINDOWS
+		WSADATA wsaData;
+		if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+		{
+			Error(fail = "Failed to initialize Winsock");
+			return;
+		}
+	#endif
+	
+	//Open our socket
+	sock = (intptr_t)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0)
+	{
+		Error(fail = "Failed to open netplay socket");
+		return;
+	}
+	
+	//Bind to our port if we're hosting (any port otherwise), and get our host's address if we're joining
+	sockaddr_in bindAddress = {};
+	bindAddress.sin_family = AF_INET;
+	bindAddress.sin_addr.s_addr = htonl(INADDR_ANY);
+	bindAddress.sin_port = htons(config.host ? config.port : 0);
+	
+	if (bind((int)sock, (sockaddr*)&bindAddress, sizeof(bindAddress)) != 0)
+	{
+		Error(fail = "Failed to bind netplay socket (is the port in use?)");
+		return;
+	}
+	if (SetNonBlocking(sock))
+	{
+		Error(fail = "Failed to make netplay socket non-blocking");
+		return;
+	}
+	
+	if (!config.host)
+	{
+		addrinfo hints = {};
+		hints.ai_family = AF_INET;
+		hints.ai_socktype = SOCK_DGRAM;
+		
+		addrinfo *result = nullptr;
+		if (getaddrinfo(config.address, nullptr, &hints, &result) != 0 || result == nullptr || result->ai_addrlen > sizeof(peerAddress))
+		{
+			if (result != nullptr)
+				freeaddrinfo(result);
+			Error(fail = "Failed to resolve netplay host's address");
+			return;
+		}
+		
+		memcpy(peerAddress, result->ai_addr, result->ai_addrlen);
+		peerAddressSize = result->ai_addrlen;
+		((sockaddr_in*)peerAddress)->sin_port = htons(config.port);
+		freeaddrinfo(result);
+		connected = true;
+	}
+}
+
+NETPLAY::~NETPLAY()
+{
+	//Close our socket and free any packets we were holding
+	CLEAR_INSTANCE_ARRAY(delayed);
+	if (sock >= 0)
+		CloseSocket(sock);
+	
+	#ifdef WINDOWS
+		WSACleanup();
+	#endif
+}
+
+//Input functions
+uint8_t NETPLAY::PackInput(const CONTROLMASK &mask)
+{
+	return (mask.start ? INPUT_START : 0) | (mask.a ? INPUT_A : 0) | (mask.b ? INPUT_B : 0) | (mask.c ? INPUT_C : 0) |
+		(mask.right ? INPUT_RIGHT : 0) | (mask.left ? INPUT_LEFT : 0) | (mask.down ? INPUT_DOWN : 0) | (mask.up ? INPUT_UP : 0);
+}
+
+CONTROLMASK NETPLAY::UnpackInput(uint8_t input)
+{
+	CONTROLMASK mask;
+	mask.start = (input & INPUT_START) != 0;
+	mask.a = (input & INPUT_A) != 0;
+	mask.b = (input & INPUT_B) != 0;
+	mask.c = (input & INPUT_C) != 0;
+	mask.right = (input & INPUT_RIGHT) != 0;
+	mask.left = (input & INPUT_LEFT) != 0;
+	mask.down = (input & INPUT_DOWN) != 0;
+	mask.up = (input & INPUT_UP) != 0;
+	return mask;
+}
+
+uint8_t NETPLAY::ReadLocalInput()
+{
+	//Play random input for soak tests (held for a random length of time, without pausing), otherwise read our first controller
+	if (config.soakFrames != 0)
+	{
+		if (--soakHold <= 0)
+		{
+			soakInput = (uint8_t)(NextRandom(&soakSeed) & ~INPUT_START);
+			soakHold = 4 + (NextRandom(&soakSeed) % 40);
+		}
+		return soakInput;
+	}
+	return PackInput(gController[0].held);
+}
+
+uint8_t NETPLAY::RemoteInputAt(int32_t at)
+{
+	//Get our peer's input for the given frame, predicting it to be their newest input if we don't have it yet
+	return remoteInput[((at <= remoteConfirmed) ? at : remoteConfirmed) % NETPLAY_INPUT_HISTORY];
+}
+
+void NETPLAY::ApplyInputs(int32_t at)
+{
+	//Get each player's held input this frame and last frame (nothing is held before the first frame)
+	uint8_t localHeld = localInput[at % NETPLAY_INPUT_HISTORY];
+	uint8_t localLast = (at > 0) ? localInput[(at - 1) % NETPLAY_INPUT_HISTORY] : 0;
+	uint8_t remoteHeld = RemoteInputAt(at);
+	uint8_t remoteLast = (at > 0) ? RemoteInputAt(at - 1) : 0;
+	remoteUsed[at % NETPLAY_INPUT_HISTORY] = remoteHeld;
+	
+	//Set our players' controllers
+	gController[localIndex].held = UnpackInput(localHeld);
+	gController[localIndex].lastHeld = UnpackInput(localLast);
+	gController[localIndex].press = UnpackInput(localHeld & ~localLast);
+	gController[remoteIndex].held = UnpackInput(remoteHeld);
+	gController[remoteIndex].lastHeld = UnpackInput(remoteLast);
+	gController[remoteIndex].press = UnpackInput(remoteHeld & ~remoteLast);
+}
+
+//Simulation functions
+bool NETPLAY::Simulate(int32_t at, bool save)
+{
+	//Save the level before this frame (unless it's the frame we just restored), so we can roll back to it
+	if (save && state[at % (NETPLAY_MAX_ROLLBACK + 2)].Save())
+	{
+		Error(fail = state[at % (NETPLAY_MAX_ROLLBACK + 2)].fail);
+		return true;
+	}
+	
+	//Update the level with this frame's inputs (and its fade, so re-simulating replays that too), then get its checksum
+	ApplyInputs(at);
+	if (gLevel->Update())
+	{
+		fail = gLevel->fail;
+		return true;
+	}
+	
+	if (gLevel->fading && gLevel->StepFade() && fadeOutFrame < 0)
+		fadeOutFrame = at;
+	
+	checksum[at % NETPLAY_INPUT_HISTORY] = gLevel->Checksum();
+	return false;
+}
+
+bool NETPLAY::Rollback()
+{
+	auto start = std::chrono::steady_clock::now();
+	
+	//Restore the level to before our oldest mispredicted frame, then re-simulate up to the present
+	if (fadeOutFrame >= rollbackFrame)
+		fadeOutFrame = -1;
+	if (state[rollbackFrame % (NETPLAY_MAX_ROLLBACK + 2)].Load())
+	{
+		Error(fail = state[rollbackFrame % (NETPLAY_MAX_ROLLBACK + 2)].fail);
+		return true;
+	}
+	
+	for (int32_t at = rollbackFrame; at < frame; at++)
+		if (Simulate(at, at != rollbackFrame))
+			return true;
+	
+	//Keep track of how long that took (re-simulating has to fit in a frame alongside the frame itself)
+	double ms = MillisecondsSince(start);
+	rollbacks++;
+	resimulatedFrames += frame - rollbackFrame;
+	resimulationMs += ms;
+	if (ms > longestResimulationMs)
+		longestResimulationMs = ms;
+	if (ms * 1000.0 > NETPLAY_FRAME_US)
+		overBudget++;
+	return false;
+}
+
+//Network functions
+void NETPLAY::SendRaw(const NETPLAY_PACKET &packet, size_t size)
+{
+	if (!connected)
+		return;
+	sendto((int)sock, (const char*)&packet, (int)size, 0, (sockaddr*)peerAddress, (int)peerAddressSize);
+}
+
+void NETPLAY::Send()
+{
+	//Drop this packet if we're simulating loss
+	if (config.loss != 0 && NextRandom(&lossSeed) % 100 < config.loss)
+		return;
+	
+	//Fill our packet with every input our peer hasn't acknowledged
+	NETPLAY_PACKET packet;
+	packet.magic = NETPLAY_MAGIC;
+	packet.session = session;
+	packet.frame = frame;
+	packet.advantage = frame - peerFrame;
+	packet.ack = remoteConfirmed;
+	packet.checksumFrame = confirmedFrame;
+	packet.checksum = (confirmedFrame >= 0) ? checksum[confirmedFrame % NETPLAY_INPUT_HISTORY] : 0;
+	
+	int32_t newestInput = frame + NETPLAY_INPUT_DELAY - 1;
+	packet.inputStart = peerAck + 1;
+	packet.inputs = (uint8_t)mmin(mmax(newestInput - peerAck, 0), NETPLAY_PACKET_INPUTS);
+	for (int32_t i = 0; i < packet.inputs; i++)
+		packet.input[i] = localInput[(packet.inputStart + i) % NETPLAY_INPUT_HISTORY];
+	
+	//Send it now, or hold it if we're simulating latency
+	size_t size = PACKET_SIZE(packet.inputs);
+	if (config.latency == 0)
+	{
+		SendRaw(packet, size);
+		return;
+	}
+	
+	NETPLAY_DELAYED *held = new NETPLAY_DELAYED;
+	held->sendTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(config.latency);
+	held->size = size;
+	held->packet = packet;
+	delayed.link_back(held);
+}
+
+void NETPLAY::FlushDelayed()
+{
+	//Send the packets we've held for long enough (they're in the order they were sent)
+	auto now = std::chrono::steady_clock::now();
+	size_t sent = 0;
+	while (sent < delayed.size() && delayed[sent]->sendTime <= now)
+	{
+		SendRaw(delayed[sent]->packet, delayed[sent]->size);
+		delete delayed[sent];
+		sent++;
+	}
+	if (sent != 0)
+		delayed.erase(0, sent);
+}
+
+void NETPLAY::Receive()
+{
+	//Handle every packet waiting for us
+	while (1)
+	{
+		NETPLAY_PACKET packet;
+		uint8_t fromAddress[sizeof(peerAddress)];
+		socklen_t fromSize = sizeof(fromAddress);
+		
+		int received = (int)recvfrom((int)sock, (char*)&packet, sizeof(packet), 0, (sockaddr*)fromAddress, &fromSize);
+		if (received < 0)
+			break;
+		if ((size_t)received < PACKET_SIZE(0) || packet.magic != NETPLAY_MAGIC || (size_t)received != PACKET_SIZE(packet.inputs) || packet.inputs > NETPLAY_PACKET_INPUTS)
+			continue;
+		
+		//Take whoever messages us first as our peer if we're hosting, then only listen to them
+		if (!connected)
+		{
+			memcpy(peerAddress, fromAddress, fromSize);
+			peerAddressSize = fromSize;
+			connected = true;
+			LOG(("Netplay peer connected\n"));
+		}
+		else if (fromSize != peerAddressSize || memcmp(fromAddress, peerAddress, fromSize))
+		{
+			continue;
+		}
+		
+		HandlePacket(packet);
+	}
+}
+
+void NETPLAY::HandlePacket(const NETPLAY_PACKET &packet)
+{
+	//Ignore packets from other levels (our peer's in the one before or after)
+	if (packet.session != session)
+		return;
+	peerStarted = true;
+	lastReceive = std::chrono::steady_clock::now();
+	
+	//Take our peer's timing and acknowledgement
+	peerFrame = mmax(peerFrame, packet.frame);
+	peerAdvantage = packet.advantage;
+	peerAck = mmax(peerAck, packet.ack);
+	
+	//Take our peer's inputs that follow on from the ones we have, noting the oldest we mispredicted
+	for (int32_t i = 0; i < packet.inputs; i++)
+	{
+		int32_t at = packet.inputStart + i;
+		if (at != remoteConfirmed + 1)
+			continue;
+		if (at - frame >= NETPLAY_INPUT_HISTORY - NETPLAY_MAX_ROLLBACK - 2)
+			break;
+		
+		remoteInput[at % NETPLAY_INPUT_HISTORY] = packet.input[i];
+		remoteConfirmed = at;
+		if (at < frame && remoteUsed[at % NETPLAY_INPUT_HISTORY] != packet.input[i] && at < rollbackFrame)
+			rollbackFrame = at;
+	}
+	
+	//Keep our peer's newest checksum to compare with ours
+	if (packet.checksumFrame > peerChecksumFrame)
+	{
+		peerChecksumFrame = packet.checksumFrame;
+		peerChecksum = packet.checksum;
+	}
+}
+
+void NETPLAY::CompareChecksums()
+{
+	//Compare our peer's checksum with ours, once we've confirmed that frame too (and if it's still in our history)
+	if (peerChecksumFrame < 0 || peerChecksumFrame > confirmedFrame)
+		return;
+	
+	if (confirmedFrame - peerChecksumFrame < NETPLAY_INPUT_HISTORY && checksum[peerChecksumFrame % NETPLAY_INPUT_HISTORY] != peerChecksum)
+	{
+		LOG(("Netplay desync on frame %d (our checksum 0x%08X, our peer's 0x%08X)\n", peerChecksumFrame, checksum[peerChecksumFrame % NETPLAY_INPUT_HISTORY], peerChecksum));
+		Error(fail = "Netplay desynced (the level's state is different on each side)");
+	}
+	peerChecksumFrame = -1;
+}
+
+//Session functions
+bool NETPLAY::Start()
+{
+	if (fail != nullptr)
+		return true;
+	
+	//Reset for this level (our first frames have no input, to make up for our input delay)
+	//Both sides confirm a level faded out on the same frame, so the frames it lasted count towards our soak test the same on both
+	soakBase += fadeOutFrame + 1;
+	session++;
+	frame = 0;
+	memset(localInput, 0, sizeof(localInput));
+	memset(remoteInput, 0, sizeof(remoteInput));
+	memset(remoteUsed, 0, sizeof(remoteUsed));
+	remoteConfirmed = NETPLAY_INPUT_DELAY - 1;
+	peerAck = NETPLAY_INPUT_DELAY - 1;
+	rollbackFrame = 0;
+	confirmedFrame = -1;
+	fadeOutFrame = -1;
+	peerChecksumFrame = -1;
+	peerStarted = false;
+	peerFrame = 0;
+	peerAdvantage = 0;
+	lastSync = 0;
+	
+	rollbacks = resimulatedFrames = overBudget = stalls = 0;
+	resimulationMs = longestResimulationMs = 0.0;
+	
+	//Wait for our peer to be in this level too
+	LOG(("Waiting for netplay peer...\n"));
+	auto start = std::chrono::steady_clock::now();
+	lastReceive = start;
+	
+	while (!peerStarted)
+	{
+		Send();
+		FlushDelayed();
+		Receive();
+		if (peerStarted)
+			break;
+		
+		if (MillisecondsSince(start) > NETPLAY_CONNECT_TIMEOUT)
+		{
+			Error(fail = "Netplay peer didn't connect in time");
+			return true;
+		}
+		std::this_thread::sleep_for(std::chrono::microseconds(NETPLAY_FRAME_US));
+	}
+	
+	//Start our frame timing from now
+	frameTime = std::chrono::steady_clock::now();
+	lastReceive = frameTime;
+	return false;
+}
+
+bool NETPLAY::Advance()
+{
+	if (fail != nullptr)
+		return true;
+	
+	//Wait for this frame's time (catching up if we've fallen far behind)
+	frameTime += std::chrono::microseconds(NETPLAY_FRAME_US);
+	auto now = std::chrono::steady_clock::now();
+	if (frameTime > now)
+		std::this_thread::sleep_until(frameTime);
+	else if (now - frameTime > std::chrono::microseconds(NETPLAY_FRAME_US * 6))
+		frameTime = now;
+	
+	//Get our peer's packets (checking that they're still there), and send the ones we've held long enough
+	Receive();
+	if (MillisecondsSince(lastReceive) > NETPLAY_TIMEOUT)
+	{
+		Error(fail = "Netplay peer stopped responding");
+		return true;
+	}
+	FlushDelayed();
+	
+	//Roll back and re-simulate if we mispredicted, then check that we're still in sync
+	if (rollbackFrame < frame && Rollback())
+		return true;
+	rollbackFrame = frame;
+	confirmedFrame = mmin(remoteConfirmed, frame - 1);
+	
+	CompareChecksums();
+	if (fail != nullptr)
+		return true;
+	
+	//Wait for our peer if we'd predict too far ahead of them, or every so often if we're running ahead of them
+	bool stall = frame - remoteConfirmed > NETPLAY_MAX_ROLLBACK;
+	if (!stall && frame - lastSync >= NETPLAY_SYNC_INTERVAL && ((frame - peerFrame) - peerAdvantage) / 2 >= 1)
+	{
+		stall = true;
+		lastSync = frame;
+	}
+	
+	if (stall)
+	{
+		stalls++;
+		Send();
+		return false;
+	}
+	
+	//Take our local input (for after our input delay), then simulate this frame, and send our inputs to our peer
+	localInput[(frame + NETPLAY_INPUT_DELAY) % NETPLAY_INPUT_HISTORY] = ReadLocalInput();
+	if (Simulate(frame, true))
+		return true;
+	
+	frame++;
+	rollbackFrame = frame;
+	Send();
+	return false;
+}
+
+void NETPLAY::End()
+{
+	//Print our statistics (re-simulation speed is what decides how far we can roll back in a frame)
+	LOG(("Netplay level ended on frame %d: %u rollbacks, %u frames re-simulated", frame, rollbacks, resimulatedFrames));
+	if (resimulationMs > 0.0)
+	{
+		LOG((" (%.1f frames per ms, longest %.2fms, %u over a frame)", resimulatedFrames / resimulationMs, longestResimulationMs, overBudget));
+	}
+	LOG((", %u frames waited\n", stalls));
+	
+	//Keep resending our last inputs and acknowledging our peer's for a moment, so neither side is left waiting on the other
+	if (fail != nullptr)
+		return;
+	
+	auto start = std::chrono::steady_clock::now();
+	while (MillisecondsSince(start) < NETPLAY_LINGER)
+	{
+		Receive();
+		Send();
+		FlushDelayed();
+		std::this_thread::sleep_for(std::chrono::microseconds(NETPLAY_FRAME_US));
+	}
+}
+
+//Command line functions
+bool InitializeNetplay(int argc, char *argv[])
+{
+	//Get our options
+	NETPLAY_CONFIG config;
+	bool netplay = false;
+	
+	for (int i = 1; i < argc; i++)
+	{
+		bool hasValue = i + 1 < argc;
+		if (!strcmp(argv[i], "-host"))
+		{
+			netplay = true;
+			config.host = true;
+			if (hasValue && argv[i + 1][0] != '-')
+				config.port = (uint16_t)atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "-join") && hasValue)
+		{
+			netplay = true;
+			config.host = false;
+			config.address = argv[++i];
+			if (i + 1 < argc && argv[i + 1][0] != '-')
+				config.port = (uint16_t)atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "-latency") && hasValue)
+		{
+			config.latency = (unsigned int)atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "-loss") && hasValue)
+		{
+			int loss = atoi(argv[++i]);
+			config.loss = (unsigned int)mmax(mmin(loss, 100), 0);
+		}
+		else if (!strcmp(argv[i], "-soak") && hasValue)
+		{
+			config.soakFrames = (unsigned int)atoi(argv[++i]);
+		}
+	}
+	
+	if (!netplay)
+		return false;
+	
+	//Start our session
+	gNetplay = new NETPLAY(config);
+	return gNetplay->fail != nullptr;
+}
+
+void QuitNetplay()
+{
+	//End our session
+	delete gNetplay;
+	gNetplay = nullptr;
+}
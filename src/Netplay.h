@@ -0,0 +1,175 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <chrono>
+
+#include "Array.h"
+#include "SaveState.h"
+#include "Input.h"
+
+//Netplay constants
+#define NETPLAY_DEFAULT_PORT		7845
+#define NETPLAY_INPUT_DELAY			2		//Frames our local input is delayed by (hides that much latency without rolling back)
+#define NETPLAY_MAX_ROLLBACK		8		//Most frames we'll predict ahead of our peer's input (and so re-simulate on a misprediction)
+#define NETPLAY_INPUT_HISTORY		128		//Frames of input kept (must cover our rollback, input delay, and the inputs our peer hasn't acknowledged)
+#define NETPLAY_PACKET_INPUTS		64		//Most unacknowledged inputs resent in a packet
+#define NETPLAY_FRAME_US			16667	//Microseconds per frame (60 frames a second)
+#define NETPLAY_SYNC_INTERVAL		10		//Frames between waiting a frame for our peer, if we're running ahead of them
+#define NETPLAY_CONNECT_TIMEOUT		30000	//Milliseconds we wait for our peer to start a level
+#define NETPLAY_TIMEOUT				5000	//Milliseconds without a packet before our peer is considered disconnected
+#define NETPLAY_LINGER				500		//Milliseconds we keep sending for after a level ends (so our peer gets our last inputs)
+#define NETPLAY_MAGIC				0x504E5343	//"CSNP"
+
+//Netplay configuration (given on the command line)
+struct NETPLAY_CONFIG
+{
+	//Connection
+	bool host = false;
+	const char *address = "127.0.0.1";
+	uint16_t port = NETPLAY_DEFAULT_PORT;
+	
+	//Simulated network conditions, applied to the packets we send (for testing over loopback)
+	unsigned int latency = 0;	//Milliseconds every packet is held for
+	unsigned int loss = 0;		//Percent of packets dropped
+	
+	//Soak test (plays random input, and exits successfully after this many frames are confirmed without desyncing, counted across levels)
+	unsigned int soakFrames = 0;
+};
+
+//Netplay packet (inputs we haven't had acknowledged, and what we need for timing and desync detection)
+struct NETPLAY_PACKET
+{
+	uint32_t magic;
+	uint32_t session;		//Level we're in (counted from the start of the session)
+	int32_t frame;			//Frame we're simulating
+	int32_t advantage;		//Frames we're ahead of our peer's last packet
+	int32_t ack;			//Newest frame we've received our peer's input for
+	int32_t checksumFrame;	//Newest frame we've confirmed, and its checksum
+	uint32_t checksum;
+	int32_t inputStart;		//First frame of our inputs
+	uint8_t inputs;
+	uint8_t input[NETPLAY_PACKET_INPUTS];
+};
+
+//Packet held back to simulate latency
+struct NETPLAY_DELAYED
+{
+	std::chrono::steady_clock::time_point sendTime;
+	size_t size;
+	NETPLAY_PACKET packet;
+};
+
+//Netplay class (two-player rollback netplay over UDP)
+//Our peer's input is predicted to be what they last held, and when it turns out to be different, the level is restored to the mispredicted
+//frame's savestate and re-simulated up to the present with the inputs we now know, before the next frame is simulated
+class NETPLAY
+{
+	public:
+		//Failure (disconnects and desyncs)
+		const char *fail = nullptr;
+		
+		//Configuration
+		NETPLAY_CONFIG config;
+	
+	private:
+		//Socket, and our peer's address
+		intptr_t sock = -1;
+		uint8_t peerAddress[32];
+		size_t peerAddressSize = 0;
+		bool connected = false;
+		
+		//Session state
+		uint32_t session = 0;
+		int32_t frame = 0;					//Frame we're about to simulate
+		int32_t localIndex, remoteIndex;	//Controllers our local and remote players use (the host is player 1, and who joins is player 2)
+		
+		//Input history (held buttons, packed into bits)
+		uint8_t localInput[NETPLAY_INPUT_HISTORY];
+		uint8_t remoteInput[NETPLAY_INPUT_HISTORY];
+		uint8_t remoteUsed[NETPLAY_INPUT_HISTORY];	//Remote input we simulated each frame with (predicted, if it wasn't confirmed yet)
+		int32_t remoteConfirmed = 0;		//Newest frame we have our peer's input for
+		int32_t peerAck = 0;				//Newest frame our peer has our input for
+		int32_t rollbackFrame = 0;			//Oldest mispredicted frame (our frame if nothing's mispredicted)
+		
+		//Savestates (of the level before each frame we can roll back to) and checksums (of the level after each frame)
+		SAVESTATE state[NETPLAY_MAX_ROLLBACK + 2];
+		uint32_t checksum[NETPLAY_INPUT_HISTORY];
+		int32_t confirmedFrame = -1;		//Newest frame simulated with our peer's actual input
+		int32_t fadeOutFrame = -1;			//Frame the level finished fading out on (-1 if it hasn't)
+		
+		//Our peer's checksum we haven't compared yet
+		int32_t peerChecksumFrame = -1;
+		uint32_t peerChecksum = 0;
+		
+		//Timing
+		std::chrono::steady_clock::time_point frameTime;
+		std::chrono::steady_clock::time_point lastReceive;
+		bool peerStarted = false;			//If our peer's in this level yet
+		int32_t peerFrame = 0;
+		int32_t peerAdvantage = 0;
+		int32_t lastSync = 0;
+		
+		//Simulated network conditions
+		ARRAY<NETPLAY_DELAYED*> delayed;
+		uint32_t lossSeed;
+		
+		//Soak test input
+		uint32_t soakSeed;
+		uint8_t soakInput = 0;
+		int32_t soakHold = 0;
+		int32_t soakBase = 0;				//Frames of the levels we've finished (soak tests count across levels, as levels end when the player dies)
+		
+		//Statistics
+		unsigned int rollbacks = 0;
+		unsigned int resimulatedFrames = 0;
+		unsigned int overBudget = 0;
+		double resimulationMs = 0.0;
+		double longestResimulationMs = 0.0;
+		unsigned int stalls = 0;
+	
+	public:
+		NETPLAY(const NETPLAY_CONFIG &setConfig);
+		~NETPLAY();
+		
+		//Wait for our peer to be in the current level, then start simulating it from its first frame, returns true on failure
+		bool Start();
+		
+		//Simulate the level's next frame (re-simulating first if we mispredicted), or wait for our peer instead, returns true on failure
+		bool Advance();
+		
+		//Finish the current level (resending our last inputs for a moment, so our peer gets them)
+		void End();
+		
+		//If the level's finished fading out on a confirmed frame (so we can leave it)
+		inline bool LevelDone() { return fadeOutFrame >= 0 && confirmedFrame >= fadeOutFrame; }
+		
+		//Soak test state
+		inline bool SoakDone() { return config.soakFrames != 0 && soakBase + confirmedFrame >= (int32_t)config.soakFrames; }
+	
+	private:
+		//Input functions
+		static uint8_t PackInput(const CONTROLMASK &mask);
+		static CONTROLMASK UnpackInput(uint8_t input);
+		uint8_t ReadLocalInput();
+		uint8_t RemoteInputAt(int32_t at);
+		void ApplyInputs(int32_t at);
+		
+		//Simulation functions
+		bool Simulate(int32_t at, bool save);
+		bool Rollback();
+		
+		//Network functions
+		void Send();
+		void SendRaw(const NETPLAY_PACKET &packet, size_t size);
+		void FlushDelayed();
+		void Receive();
+		void HandlePacket(const NETPLAY_PACKET &packet);
+		void CompareChecksums();
+};
+
+//Netplay session global (null when not playing online)
+extern NETPLAY *gNetplay;
+
+//Parse netplay's command line options, creating our session if we're in one, returns true on failure
+bool InitializeNetplay(int argc, char *argv[]);
+void QuitNetplay();
@@ -1,5 +1,7 @@
 #include <stdlib.h>
 #include <string.h>
+#include <assert.h>
+#include <new>
 
 #include "Object.h"
 #include "Objects.h"
@@ -19,8 +21,91 @@
 //#define SONIC12_SOLIDOBJECT_VERTICAL          //In Sonic 3, the Solid Object routine was adjusted to prefer vertical collision
 //#define SONIC12_SOLIDOBJECT_BOTTOM_INERTIA    //In Sonic 3, touching the bottom of an object clears your inertia
 
+//Object pool (objects, and so their scratch, are only ever created, updated, and destroyed on the main thread)
+SPLITPOOL<sizeof(OBJECT), OBJECT_COLD, OBJECT_POOL_CHUNK> gObjectPool;
+
+void *OBJECT::operator new(size_t size) noexcept
+{
+	//Allocate from the object pool (which only holds objects, nothing derives from us), whoever creates us checks that we were allocated
+	assert(size == sizeof(OBJECT));
+	void *memory = gObjectPool.Alloc();
+	if (memory == nullptr)
+		Error("Failed to allocate object in memory");
+	return memory;
+}
+
+void OBJECT::operator delete(void *ptr)
+{
+	//Return to the object pool
+	gObjectPool.Free(ptr);
+}
+
+//Scratch pools (size classes of 16, 32, 64, 128, and 256 bytes, anything larger falls back to malloc)
+#define SCRATCH_POOL_CHUNK	0x40
+
+static POOL<0x10, SCRATCH_POOL_CHUNK> scratchPool16;
+static POOL<0x20, SCRATCH_POOL_CHUNK> scratchPool32;
+static POOL<0x40, SCRATCH_POOL_CHUNK> scratchPool64;
+static POOL<0x80, SCRATCH_POOL_CHUNK> scratchPool128;
+static POOL<0x100, SCRATCH_POOL_CHUNK> scratchPool256;
+
+void *OBJECT::AllocScratch(size_t size)
+{
+	//Allocate from the smallest size class that fits
+	void *memory;
+	if (size <= 0x10)
+		memory = scratchPool16.Alloc();
+	else if (size <= 0x20)
+		memory = scratchPool32.Alloc();
+	else if (size <= 0x40)
+		memory = scratchPool64.Alloc();
+	else if (size <= 0x80)
+		memory = scratchPool128.Alloc();
+	else if (size <= 0x100)
+		memory = scratchPool256.Alloc();
+	else
+		memory = malloc(size);
+	
+	if (memory == nullptr)
+		Error(Cold()->fail = "Failed to allocate object scratch in memory");
+	return memory;
+}
+
+void OBJECT::FreeScratch()
+{
+	//Don't free if we don't have scratch
+	if (scratch == nullptr)
+		return;
+	
+	//Destroy our scratch, then return it to the size class it came from
+	OBJECT_COLD *cold = Cold();
+	cold->scratchDestructor(scratch);
+	
+	size_t scratchSize = cold->scratchSize;
+	if (scratchSize <= 0x10)
+		scratchPool16.Free(scratch);
+	else if (scratchSize <= 0x20)
+		scratchPool32.Free(scratch);
+	else if (scratchSize <= 0x40)
+		scratchPool64.Free(scratch);
+	else if (scratchSize <= 0x80)
+		scratchPool128.Free(scratch);
+	else if (scratchSize <= 0x100)
+		scratchPool256.Free(scratch);
+	else
+		free(scratch);
+	
+	scratch = nullptr;
+	cold->scratchSize = 0;
+	cold->scratchDestructor = nullptr;
+}
+
 //Object class
-OBJECT::OBJECT(OBJECTFUNCTION objectFunction) : function(objectFunction) { return; }
+OBJECT::OBJECT(OBJECTFUNCTION objectFunction) : function(objectFunction)
+{
+	//Our cold data was constructed along with our place in the object pool
+	return;
+}
 
 OBJECT::~OBJECT()
 {
@@ -36,11 +121,28 @@ OBJECT::~OBJECT()
 	gLevel->UnrefObjectLoad(this);
 	
 	//Free allocated scratch memory
-	free(scratch);
+	FreeScratch();
 	
-	//Destroy draw instances and children
-	CLEAR_INSTANCE_LINKEDLIST(drawInstances);
-	CLEAR_INSTANCE_LINKEDLIST(children);
+	//Unlink us from our parent
+	OBJECT_COLD *cold = Cold();
+	if (cold->hierarchyParent != nullptr)
+	{
+		for (OBJECT **link = &cold->hierarchyParent->Cold()->firstChild; *link != nullptr; link = &(*link)->Cold()->nextSibling)
+		{
+			if (*link == this)
+			{
+				*link = cold->nextSibling;
+				break;
+			}
+		}
+		
+		for (OBJECT *ancestor = cold->hierarchyParent; ancestor != nullptr; ancestor = ancestor->Cold()->hierarchyParent)
+			ancestor->Cold()->descendants -= cold->descendants + 1;
+	}
+	
+	//Detach our children (they're deleted along with us by CHECK_ARRAY_OBJECTDELETE)
+	for (OBJECT *child = cold->firstChild; child != nullptr; child = child->Cold()->nextSibling)
+		child->Cold()->hierarchyParent = nullptr;
 }
 
 //Generic object functions
@@ -170,40 +272,31 @@ void OBJECT::Animate_S1(const uint8_t **animationList)
 
 int16_t OBJECT::CheckCollisionDown_1Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, uint8_t *outAngle)
 {
-	int16_t distance = GetCollisionV(xPos, yPos, layer, false, outAngle);
-	if (outAngle != nullptr)
-		*outAngle = ((*outAngle) & 1) ? 0x00 : (*outAngle);
-	return distance;
+	return GetCollisionSensor(xPos, yPos, layer, COLLISIONDIRECTION_DOWN, outAngle);
 }
 
 int16_t OBJECT::CheckCollisionUp_1Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, uint8_t *outAngle)
 {
-	int16_t distance = GetCollisionV(xPos, yPos, layer, true, outAngle);
-	if (outAngle != nullptr)
-		*outAngle = ((*outAngle) & 1) ? 0x80 : (*outAngle);
-	return distance;
+	return GetCollisionSensor(xPos, yPos, layer, COLLISIONDIRECTION_UP, outAngle);
 }
 
 int16_t OBJECT::CheckCollisionLeft_1Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, uint8_t *outAngle)
 {
-	int16_t distance = GetCollisionH(xPos, yPos, layer, true, outAngle);
-	if (outAngle != nullptr)
-		*outAngle = ((*outAngle) & 1) ? 0x40 : (*outAngle);
-	return distance;
+	return GetCollisionSensor(xPos, yPos, layer, COLLISIONDIRECTION_LEFT, outAngle);
 }
 
 int16_t OBJECT::CheckCollisionRight_1Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, uint8_t *outAngle)
 {
-	int16_t distance = GetCollisionH(xPos, yPos, layer, false, outAngle);
-	if (outAngle != nullptr)
-		*outAngle = ((*outAngle) & 1) ? 0xC0 : (*outAngle);
-	return distance;
+	return GetCollisionSensor(xPos, yPos, layer, COLLISIONDIRECTION_RIGHT, outAngle);
 }
 
 void OBJECT::DrawInstance(OBJECT_RENDERFLAGS iRenderFlags, TEXTURE *iTexture, OBJECT_MAPPING iMapping, bool iHighPriority, uint8_t iPriority, uint16_t iMappingFrame, int16_t iXPos, int16_t iYPos)
 {
+	//Append a draw instance to our range in the draw instance arena (moved to the top of the arena if another object allocated after us)
+	drawInstances = (OBJECT_DRAWINSTANCE*)gLevel->drawInstanceArena->Extend(drawInstances, sizeof(OBJECT_DRAWINSTANCE) * drawInstanceCount, sizeof(OBJECT_DRAWINSTANCE) * (drawInstanceCount + 1), alignof(OBJECT_DRAWINSTANCE));
+	
 	//Create a draw instance with the properties given
-	OBJECT_DRAWINSTANCE *newInstance = new OBJECT_DRAWINSTANCE;
+	OBJECT_DRAWINSTANCE *newInstance = &drawInstances[drawInstanceCount++];
 	newInstance->renderFlags = iRenderFlags;
 	newInstance->texture = iTexture;
 	newInstance->mapping = iMapping;
@@ -212,7 +305,6 @@ void OBJECT::DrawInstance(OBJECT_RENDERFLAGS iRenderFlags, TEXTURE *iTexture, OB
 	newInstance->mappingFrame = iMappingFrame;
 	newInstance->xPos = iXPos;
 	newInstance->yPos = iYPos;
-	drawInstances.link_back(newInstance);
 }
 
 void OBJECT::UnloadOffscreen(int16_t xPos)
@@ -223,6 +315,22 @@ void OBJECT::UnloadOffscreen(int16_t xPos)
 		deleteFlag = true;
 }
 
+//Object hierarchy functions
+void OBJECT::LinkChild(OBJECT *child)
+{
+	//Link to the end of our children
+	OBJECT **link = &Cold()->firstChild;
+	while (*link != nullptr)
+		link = &(*link)->Cold()->nextSibling;
+	*link = child;
+	child->Cold()->hierarchyParent = this;
+	
+	//Have the level place us in the object list after our last descendant (along with every other child linked this update, see LEVEL::PlaceLinkedChildren)
+	gLevel->childrenLinked = true;
+	for (OBJECT *ancestor = this; ancestor != nullptr; ancestor = ancestor->Cold()->hierarchyParent)
+		ancestor->Cold()->descendants += child->Cold()->descendants + 1;
+}
+
 //Object interaction functions
 const uint16_t enemyPoints[] = {100, 200, 500, 1000};
 
@@ -284,67 +392,59 @@ void OBJECT::ClearSolidContact()
 		
 		#ifndef FIX_LAZY_CONTACT_CLEAR
 			//Clear pushing and standing together
-			if (playerContact[i].standing || playerContact[i].pushing)
+			if (Cold()->playerContact[i].standing || Cold()->playerContact[i].pushing)
 			{
 				//Clear all of our contact flags
 				player->status.shouldNotFall = false;
 				player->status.pushing = false;
-				playerContact[i].standing = false;
-				playerContact[i].pushing = false;
+				Cold()->playerContact[i].standing = false;
+				Cold()->playerContact[i].pushing = false;
 				player->status.inAir = true;
 			}
 		#else
 			//Clear standing
-			if (playerContact[i].standing)
+			if (Cold()->playerContact[i].standing)
 			{
 				//Clear all of our contact flags
 				player->status.shouldNotFall = false;
-				playerContact[i].standing = false;
+				Cold()->playerContact[i].standing = false;
 				player->status.inAir = true;
 			}
 			
 			//Clear pushing
-			if (playerContact[i].pushing)
+			if (Cold()->playerContact[i].pushing)
 			{
 				//Clear all of our contact flags
 				player->status.pushing = false;
-				playerContact[i].pushing = false;
+				Cold()->playerContact[i].pushing = false;
 			}
 		#endif
 	}
 }
 
-void OBJECT::Smash(size_t num, const OBJECT_SMASHMAP *smashmap, OBJECTFUNCTION fragmentFunction)
+void OBJECT::Smash(size_t num, const OBJECT_SMASHMAP *smashmap)
 {
 	//Get our rect to use
 	RECT mapRect;
 	POINT mapOrig;
 	
+	OBJECT_MAPPING *mapping = &Cold()->mapping;
 	if (!renderFlags.staticMapping)
 	{
-		mapRect = mapping.mappings->rect[mappingFrame];
-		mapOrig = mapping.mappings->origin[mappingFrame];
+		mapRect = mapping->mappings->rect[mappingFrame];
+		mapOrig = mapping->mappings->origin[mappingFrame];
 	}
 	else
 	{
-		mapRect = mapping.rect;
-		mapOrig = mapping.origin;
+		mapRect = mapping->rect;
+		mapOrig = mapping->origin;
 	}
 	
-	//Create smash fragments based on copies of us and the smash map
+	uint8_t fragmentFlags = (renderFlags.xFlip ? PARTICLEFLAG_XFLIP : 0) | (renderFlags.yFlip ? PARTICLEFLAG_YFLIP : 0);
+	
+	//Create smash fragment particles based on pieces of us and the smash map
 	for (size_t i = 0; i < num; i++)
 	{
-		//Create a fragment
-		OBJECT *newFragment = new OBJECT(fragmentFunction);
-		newFragment->texture = texture;
-		newFragment->mapping.rect = {mapRect.x + smashmap->rect.x, mapRect.y + smashmap->rect.y, smashmap->rect.w, smashmap->rect.h};
-		newFragment->mapping.origin = {smashmap->rect.w / 2, smashmap->rect.h / 2};
-		newFragment->renderFlags = renderFlags;
-		newFragment->renderFlags.staticMapping = true;
-		newFragment->priority = priority;
-		newFragment->widthPixels = widthPixels;
-		newFragment->heightPixels = heightPixels;
-		
 		//Get our position difference
 		int offX = (smashmap->rect.x + smashmap->rect.w / 2) - mapOrig.x;
 		int offY = (smashmap->rect.y + smashmap->rect.h / 2) - mapOrig.y;
@@ -353,15 +453,9 @@ void OBJECT::Smash(size_t num, const OBJECT_SMASHMAP *smashmap, OBJECTFUNCTION f
 		if (renderFlags.yFlip)
 			offY = -offY;
 		
-		//Set our fragment position and velocity
-		newFragment->x.pos = x.pos + offX;
-		newFragment->y.pos = y.pos + offY;
-		newFragment->xVel = smashmap->xVel;
-		newFragment->yVel = smashmap->yVel;
-		
-		//Do an initial update, and link to level
-		fragmentFunction(newFragment);
-		gLevel->objectList.link_back(newFragment);
+		//Create a fragment
+		RECT fragmentRect = {mapRect.x + smashmap->rect.x, mapRect.y + smashmap->rect.y, smashmap->rect.w, smashmap->rect.h};
+		gLevel->particleSystem->SpawnFragment(PARTICLETYPE_FRAGMENT_SMASH, texture, fragmentRect, fragmentFlags, priority, x.pos + offX, y.pos + offY, smashmap->xVel, smashmap->yVel, 0);
 		smashmap++;
 	}
 	
@@ -369,37 +463,29 @@ void OBJECT::Smash(size_t num, const OBJECT_SMASHMAP *smashmap, OBJECTFUNCTION f
 	PlaySound(SOUNDID_WALL_SMASH);
 }
 
-void OBJECT::Fragment(size_t num, const OBJECT_FRAGMENTMAP *fragmap, OBJECTFUNCTION fragmentFunction)
+void OBJECT::Fragment(size_t num, const OBJECT_FRAGMENTMAP *fragmap)
 {
 	//Get our rect to use
 	RECT mapRect;
 	POINT mapOrig;
 	
+	OBJECT_MAPPING *mapping = &Cold()->mapping;
 	if (!renderFlags.staticMapping)
 	{
-		mapRect = mapping.mappings->rect[mappingFrame];
-		mapOrig = mapping.mappings->origin[mappingFrame];
+		mapRect = mapping->mappings->rect[mappingFrame];
+		mapOrig = mapping->mappings->origin[mappingFrame];
 	}
 	else
 	{
-		mapRect = mapping.rect;
-		mapOrig = mapping.origin;
+		mapRect = mapping->rect;
+		mapOrig = mapping->origin;
 	}
 	
-	//Create smash fragments based on copies of us and the smash map
+	uint8_t fragmentFlags = (renderFlags.xFlip ? PARTICLEFLAG_XFLIP : 0) | (renderFlags.yFlip ? PARTICLEFLAG_YFLIP : 0);
+	
+	//Create collapse fragment particles based on pieces of us and the fragment map
 	for (size_t i = 0; i < num; i++)
 	{
-		//Create a fragment
-		OBJECT *newFragment = new OBJECT(fragmentFunction);
-		newFragment->texture = texture;
-		newFragment->mapping.rect = {mapRect.x + fragmap->rect.x, mapRect.y + fragmap->rect.y, fragmap->rect.w, fragmap->rect.h};
-		newFragment->mapping.origin = {fragmap->rect.w / 2, fragmap->rect.h / 2};
-		newFragment->renderFlags = renderFlags;
-		newFragment->renderFlags.staticMapping = true;
-		newFragment->priority = priority;
-		newFragment->widthPixels = widthPixels;
-		newFragment->heightPixels = heightPixels;
-		
 		//Get our position difference
 		int offX = (fragmap->rect.x + fragmap->rect.w / 2) - mapOrig.x;
 		int offY = (fragmap->rect.y + fragmap->rect.h / 2) - mapOrig.y;
@@ -408,14 +494,9 @@ void OBJECT::Fragment(size_t num, const OBJECT_FRAGMENTMAP *fragmap, OBJECTFUNCT
 		if (renderFlags.yFlip)
 			offY = -offY;
 		
-		//Set our fragment position and velocity
-		newFragment->x.pos = x.pos + offX;
-		newFragment->y.pos = y.pos + offY;
-		newFragment->subtype = fragmap->delay;
-		
-		//Do an initial update, and link to level
-		fragmentFunction(newFragment);
-		gLevel->objectList.link_back(newFragment);
+		//Create a fragment that falls after its delay
+		RECT fragmentRect = {mapRect.x + fragmap->rect.x, mapRect.y + fragmap->rect.y, fragmap->rect.w, fragmap->rect.h};
+		gLevel->particleSystem->SpawnFragment(PARTICLETYPE_FRAGMENT_COLLAPSE, texture, fragmentRect, fragmentFlags, priority, x.pos + offX, y.pos + offY, 0, 0, fragmap->delay);
 		fragmap++;
 	}
 	
@@ -428,7 +509,7 @@ void OBJECT::AttachPlayer(PLAYER *player, size_t i)
 {
 	//If already standing on an object, clear that object's standing bit
 	if (player->status.shouldNotFall && player->interact != nullptr)
-		player->interact->playerContact[i].standing = false; //Clear the previous object stood on's standing bit
+		player->interact->Cold()->playerContact[i].standing = false; //Clear the previous object stood on's standing bit
 	
 	//Set to stand on this object
 	player->interact = this;
@@ -438,7 +519,7 @@ void OBJECT::AttachPlayer(PLAYER *player, size_t i)
 	
 	//Land on object
 	player->status.shouldNotFall = true;
-	playerContact[i].standing = true;
+	Cold()->playerContact[i].standing = true;
 	
 	if (player->status.inAir)
 	{
@@ -519,7 +600,7 @@ void OBJECT::SolidObjectTop(int16_t width, int16_t height, int16_t lastXPos, boo
 		PLAYER *player = gLevel->playerList[i];
 		
 		//If the player is already standing on us
-		if (playerContact[i].standing == true)
+		if (Cold()->playerContact[i].standing == true)
 		{
 			//Check if we're still on the platform
 			int16_t xDiff = player->x.pos - lastXPos + width;
@@ -588,7 +669,7 @@ bool OBJECT::LandOnTopSolid(PLAYER *player, size_t i, int16_t width1, int16_t wi
 void OBJECT::ReleasePlayer(PLAYER *player, size_t i, bool setAirOnExit)
 {
 	player->status.shouldNotFall = false;
-	playerContact[i].standing = false;
+	Cold()->playerContact[i].standing = false;
 	if (setAirOnExit)
 		player->status.inAir = true;
 }
@@ -604,7 +685,7 @@ OBJECT_SOLIDTOUCH OBJECT::SolidObjectFull(int16_t width, int16_t height_air, int
 		PLAYER *player = gLevel->playerList[i];
 		
 		//Check if we're still standing on the object
-		if (playerContact[i].standing)
+		if (Cold()->playerContact[i].standing)
 		{
 			//Check if we're to exit the top of the object
 			int16_t xDiff = (player->x.pos - lastXPos) + width;
@@ -811,7 +892,7 @@ void OBJECT::SolidObjectFull_Cont(OBJECT_SOLIDTOUCH *solidTouch, PLAYER *player,
 					//Contact on ground: Set side touch and set pushing flags
 					if (solidTouch != nullptr)
 						solidTouch->side[i] = true;
-					playerContact[i].pushing = true;
+					Cold()->playerContact[i].pushing = true;
 					player->status.pushing = true;
 				}
 				else
@@ -819,7 +900,7 @@ void OBJECT::SolidObjectFull_Cont(OBJECT_SOLIDTOUCH *solidTouch, PLAYER *player,
 					//Contact in mid-air: Set side touch and clear pushing flags
 					if (solidTouch != nullptr)
 						solidTouch->side[i] = true;
-					playerContact[i].pushing = false;
+					Cold()->playerContact[i].pushing = false;
 					player->status.pushing = false;
 				}
 				return;
@@ -834,14 +915,14 @@ void OBJECT::SolidObjectFull_Cont(OBJECT_SOLIDTOUCH *solidTouch, PLAYER *player,
 void OBJECT::SolidObjectFull_ClearPush(PLAYER *player, size_t i)
 {
 	//Check we should stop pushing
-	if (playerContact[i].pushing)
+	if (Cold()->playerContact[i].pushing)
 	{
 		//Reset animation
 		if (player->anim != PLAYERANIMATION_ROLL && player->anim != PLAYERANIMATION_DROPDASH && player->anim != PLAYERANIMATION_SPINDASH)
 			player->anim = PLAYERANIMATION_RUN; //wrong animation id
 		
 		//Clear pushing flags
-		playerContact[i].pushing = false;
+		Cold()->playerContact[i].pushing = false;
 		player->status.pushing = false;
 	}
 }
@@ -854,11 +935,11 @@ void OBJECT::CollideStandingPlayersWithLevel()
 		PLAYER *player = gLevel->playerList[i];
 		
 		//Check floor if touching and release if so
-		if (playerContact[i].standing)
+		if (Cold()->playerContact[i].standing)
 		{
 			if (CheckCollisionDown_1Point(COLLISIONLAYER_NORMAL_TOP, player->x.pos, player->y.pos + player->yRadius, nullptr) < 0)
 			{
-				playerContact[i].standing = false;
+				Cold()->playerContact[i].standing = false;
 				player->status.inAir = true;
 			}
 		}
@@ -869,18 +950,19 @@ void OBJECT::CollideStandingPlayersWithLevel()
 bool OBJECT::Update()
 {
 	//If our function has changed, free any allocated scratch memory
-	if (function != prevFunction)
+	OBJECT_COLD *cold = Cold();
+	if (function != cold->prevFunction)
 	{
 		//Free all scratch memory
-		free(scratch);
-		scratch =  nullptr;
+		FreeScratch();
 		
 		//Remember this as our last function
-		prevFunction = function;
+		cold->prevFunction = function;
 	}
 	
-	//Destroy draw instances from last update
-	CLEAR_INSTANCE_LINKEDLIST(drawInstances);
+	//Forget draw instances from last update (their memory is released when the arena is reset)
+	drawInstances = nullptr;
+	drawInstanceCount = 0;
 	
 	//Run our object code
 	if (function != nullptr)
@@ -888,27 +970,20 @@ bool OBJECT::Update()
 	else
 		deleteFlag = true; //We're just a waste of memory, delete
 	
-	//Check if any of our assets failed to load
-	if (texture != nullptr && texture->fail != nullptr)
-	{
-		fail = texture->fail;
+	//Check if our object code failed (to allocate what it needed), or any of our assets failed to load
+	if (cold->fail != nullptr)
 		return true;
-	}
 	
-	if (mapping.mappings != nullptr && mapping.mappings->fail != nullptr)
+	if (texture != nullptr && texture->fail != nullptr)
 	{
-		fail = mapping.mappings->fail;
+		cold->fail = texture->fail;
 		return true;
 	}
 	
-	//Update children if not going to be deleted
-	if (!deleteFlag)
+	if (cold->mapping.mappings != nullptr && cold->mapping.mappings->fail != nullptr)
 	{
-		//Update children's code
-		for (size_t i = 0; i < children.size(); i++)
-			if (children[i]->Update())
-				return true;
-		CHECK_LINKEDLIST_OBJECTDELETE(children);
+		cold->fail = cold->mapping.mappings->fail;
+		return true;
 	}
 	
 	return false;
@@ -916,13 +991,13 @@ bool OBJECT::Update()
 
 void OBJECT::Draw()
 {
-	if (drawInstances.size() > 0)
+	if (drawInstanceCount > 0)
 	{
 		//On-screen check (checks the first draw instance, which is basically how the original does it)
 		int alignX = renderFlags.alignPlane ? gLevel->camera->xPos : 0;
 		int alignY = renderFlags.alignPlane ? gLevel->camera->yPos : 0;
-		int16_t xPos = drawInstances[0]->xPos;
-		int16_t yPos = drawInstances[0]->yPos;
+		int16_t xPos = drawInstances[0].xPos;
+		int16_t yPos = drawInstances[0].yPos;
 		
 		renderFlags.isOnscreen = false;
 		
@@ -930,14 +1005,11 @@ void OBJECT::Draw()
 			!(yPos - alignY < -heightPixels || yPos - alignY > gRenderSpec.height + heightPixels))
 		{
 			//Draw our draw instances if on-screen and set flag
-			for (size_t i = 0; i < drawInstances.size(); i++)
-				RenderDrawInstance(drawInstances[i]);
+			for (size_t i = 0; i < drawInstanceCount; i++)
+				RenderDrawInstance(&drawInstances[i]);
 			renderFlags.isOnscreen = true;
 		}
 	}
-	
-	for (size_t i = 0; i < children.size(); i++)
-		children[i]->Draw();
 }
 
 //Draw instance draw function
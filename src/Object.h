@@ -2,12 +2,14 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <new>
 
-#include "LinkedList.h"
+#include "Array.h"
 #include "Render.h"
 #include "Mappings.h"
 #include "LevelCollision.h"
 #include "CommonMacros.h"
+#include "Pool.h"
 
 //Declare the object and player classes
 class OBJECT;
@@ -18,21 +20,27 @@ typedef void (*OBJECTFUNCTION)(OBJECT*);
 
 //Constants
 #define OBJECT_PLAYER_REFERENCES 0x100
+#define OBJECT_POOL_CHUNK 0x100
 
 //Common macros
-#define CHECK_LINKEDLIST_OBJECTDELETE(linkedList)	for (LL_NODE<OBJECT*> *node = linkedList.head; node != nullptr;)	\
-													{	\
-														node = linkedList.head;	\
-														for (; node != nullptr; node = node->next)	\
-														{	\
-															if (node->node_entry->deleteFlag)	\
-															{	\
-																delete node->node_entry;	\
-																linkedList.erase_node(node);	\
-																break;	\
-															}	\
-														}	\
-													}
+#define CHECK_ARRAY_OBJECTDELETE(array)	for (size_t i = 0; i < array.size(); i++)	\
+										{	\
+											if (array[i]->deleteFlag)	\
+												for (OBJECT *child = array[i]->Cold()->firstChild; child != nullptr; child = child->Cold()->nextSibling)	\
+													child->deleteFlag = true;	\
+										}	\
+										{	\
+											size_t keep = 0;	\
+											for (size_t i = 0; i < array.size(); i++)	\
+											{	\
+												OBJECT *object = array[i];	\
+												if (object->deleteFlag)	\
+													delete object;	\
+												else	\
+													array[keep++] = object;	\
+											}	\
+											array.resize(keep);	\
+										}
 
 //Enumerations
 enum COLLISIONTYPE
@@ -113,23 +121,68 @@ struct OBJECT_DRAWINSTANCE
 	int16_t xPos, yPos;
 };
 
+//Player contact status
+struct OBJECT_PLAYERCONTACT
+{
+	bool standing = false;
+	bool pushing = false;
+	bool objectSpecific = false;
+};
+
+//Object cold data (not touched by the draw and touch loops, kept in a separate array in the object pool, see OBJECT::Cold)
+//What the object update reads every frame comes first, so it's in the record's first cache line
+struct OBJECT_COLD
+{
+	//Our last function (to know when to free our scratch)
+	OBJECTFUNCTION prevFunction = nullptr;
+	
+	//Descendants in the object hierarchy (skipped by the object update if we're deleted)
+	size_t descendants = 0;
+	
+	//Failure
+	const char *fail = nullptr;
+	
+	//Our mappings
+	OBJECT_MAPPING mapping;
+	
+	//Object hierarchy (children are kept directly after their parent in the level's object list, so the list is in parent-then-children order)
+	OBJECT *hierarchyParent = nullptr;
+	OBJECT *firstChild = nullptr;
+	OBJECT *nextSibling = nullptr;
+	
+	struct
+	{
+		bool reflect = false;	//Projectile that gets reflected
+		bool flame = false;		//Flame
+		bool lightning = false;	//Lightning
+		bool aqua = false;		//Aqua
+	} hurtType;
+	
+	//Scratch size and destructor (the scratch's type is only known to the object function that allocated it)
+	size_t scratchSize = 0;
+	void (*scratchDestructor)(void *scratch) = nullptr;
+	
+	//Player contact status (only touched by solid objects)
+	OBJECT_PLAYERCONTACT playerContact[OBJECT_PLAYER_REFERENCES];
+};
+
 //Object class
+//Only the hot data (touched by the update, draw, and touch loops every frame) is kept here, objects are allocated from a pool that keeps
+//each object's cold data in a separate array (so the hot data of every live object is packed together)
 class OBJECT
 {
 	public:
-		//Failure
-		const char *fail = nullptr;
+		//Our object-specific function
+		OBJECTFUNCTION function = nullptr;
 		
-		//Object sub-type
-		unsigned int subtype = 0;
+		//Routine
+		uint8_t routine = 0;			//Routine
+		uint8_t routineSecondary = 0;	//Routine Secondary
 		
-		//Rendering stuff
-		OBJECT_RENDERFLAGS renderFlags;
-		LINKEDLIST<OBJECT_DRAWINSTANCE*> drawInstances;
+		uint8_t angle = 0;	//Angle
 		
-		//Our texture and mappings
-		TEXTURE *texture = nullptr;
-		OBJECT_MAPPING mapping;
+		//Delete flag
+		bool deleteFlag = false;
 		
 		//Position
 		FPDEF(x, int16_t, pos, uint8_t, sub, int32_t)
@@ -148,13 +201,11 @@ class OBJECT
 		int16_t touchWidth = 0;
 		int16_t touchHeight = 0;
 		
-		struct
-		{
-			bool reflect = false;	//Projectile that gets reflected
-			bool flame = false;		//Flame
-			bool lightning = false;	//Lightning
-			bool aqua = false;		//Aqua
-		} hurtType;
+		//Rendering stuff
+		OBJECT_RENDERFLAGS renderFlags;
+		
+		//Our status
+		OBJECT_STATUS status;
 		
 		//Sprite properties
 		bool highPriority = false;					//Drawn above the foreground
@@ -169,22 +220,12 @@ class OBJECT
 		unsigned int prevAnim = 0;
 		signed int animFrameDuration = 0;
 		
-		//Our status
-		OBJECT_STATUS status;
-		
-		//Player contact status
-		struct
-		{
-			bool standing = false;
-			bool pushing = false;
-			bool objectSpecific = false;
-		} playerContact[OBJECT_PLAYER_REFERENCES];
+		//Object sub-type
+		unsigned int subtype = 0;
 		
-		//Routine
-		uint8_t routine = 0;			//Routine
-		uint8_t routineSecondary = 0;	//Routine Secondary
+		//Our texture
+		TEXTURE *texture = nullptr;
 		
-		uint8_t angle = 0;	//Angle
 		union //Parent
 		{
 			void *parent = nullptr;
@@ -192,36 +233,44 @@ class OBJECT
 			PLAYER *parentPlayer;
 		};
 		
-		//Children linked list
-		LINKEDLIST<OBJECT*> children;
-		
 		//Scratch memory
 		void *scratch = nullptr; //No specific type - whatever an object specifies
 		
-		//Our object-specific function
-		OBJECTFUNCTION function = nullptr;
-		OBJECTFUNCTION prevFunction = nullptr;
-		
-		//Delete flag
-		bool deleteFlag = false;
+		//Draw instances (a range in the level's draw instance arena, rebuilt every update)
+		OBJECT_DRAWINSTANCE *drawInstances = nullptr;
+		size_t drawInstanceCount = 0;
 		
 	public:
 		//Constructor and destructor
 		OBJECT(OBJECTFUNCTION object);
 		~OBJECT();
 		
-		//Scratch allocation function
+		//Pool allocation
+		static void *operator new(size_t size) noexcept;
+		static void operator delete(void *ptr);
+		inline OBJECT_COLD *Cold();
+		
+		//Scratch allocation functions
+		template <typename T> static void DestroyScratch(void *scratch) { ((T*)scratch)->~T(); }
+		
 		template <typename T> inline T *Scratch()
 		{
-			//Allocate scratch if null, then return it or the already allocated scratch
+			//Allocate scratch if null, then return it or the already allocated scratch (null if we failed to allocate it)
 			if (scratch == nullptr)
 			{
-				scratch = malloc(sizeof(T)); //Allocate memory (have to use malloc because destructor doesn't know scratch type)
-				*((T*)scratch) = {}; //Explicitly initialize because we used malloc
+				void *memory = AllocScratch(sizeof(T)); //Allocate memory from the scratch pools and construct
+				if (memory == nullptr)
+					return nullptr;
+				scratch = new(memory) T();
+				Cold()->scratchSize = sizeof(T);
+				Cold()->scratchDestructor = &DestroyScratch<T>;
 			}
 			return (T*)scratch;
 		}
 		
+		void *AllocScratch(size_t size);
+		void FreeScratch();
+		
 		//Generic object functions
 		void Move();
 		void MoveAndFall();
@@ -238,8 +287,10 @@ class OBJECT
 		
 		void UnloadOffscreen(int16_t xPos);
 		
-		void Smash(size_t num, const OBJECT_SMASHMAP *smashmap, OBJECTFUNCTION fragmentFunction);
-		void Fragment(size_t num, const OBJECT_FRAGMENTMAP *fragmap, OBJECTFUNCTION fragmentFunction);
+		void LinkChild(OBJECT *child);
+		
+		void Smash(size_t num, const OBJECT_SMASHMAP *smashmap);
+		void Fragment(size_t num, const OBJECT_FRAGMENTMAP *fragmap);
 		
 		//Object interaction functions
 		bool Hurt(PLAYER *player);
@@ -264,3 +315,8 @@ class OBJECT
 		void Draw();
 		void RenderDrawInstance(OBJECT_DRAWINSTANCE *drawInstance);
 };
+
+//Object pool (objects, with their cold data kept in a separate array)
+extern SPLITPOOL<sizeof(OBJECT), OBJECT_COLD, OBJECT_POOL_CHUNK> gObjectPool;
+
+inline OBJECT_COLD *OBJECT::Cold() { return gObjectPool.Cold(this); }
@@ -3,9 +3,6 @@
 
 void ObjPathSwitcher(OBJECT *object);
 void ObjRing(OBJECT *object);
-void ObjRingSpawner(OBJECT *object);
-void ObjBouncingRing(OBJECT *object);
-void ObjBouncingRing_Spawner(OBJECT *object);
 void ObjAttractRing(OBJECT *object);
 void ObjMonitor(OBJECT *object);
 void ObjSpring(OBJECT *object);
@@ -19,8 +16,11 @@ void ObjSonic1Scenery(OBJECT *object);
 void ObjMotobug(OBJECT *object);
 void ObjChopper(OBJECT *object);
 void ObjCrabmeat(OBJECT *object);
+void ObjCrabmeatProjectile(OBJECT *object);
 void ObjBuzzBomber(OBJECT *object);
+void ObjBuzzBomberMissile(OBJECT *object);
 void ObjNewtron(OBJECT *object);
+void ObjNewtronMissile(OBJECT *object);
 void ObjGHZWaterfallSound(OBJECT *object);
 void ObjGHZPlatform(OBJECT *object);
 void ObjGHZLedge(OBJECT *object);
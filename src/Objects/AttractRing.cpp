@@ -18,8 +18,8 @@ void ObjAttractRing(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/Generic.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/Ring.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_GENERIC);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_RING);
 			
 			//Initialize other properties
 			object->renderFlags.alignPlane = true;
@@ -38,10 +38,11 @@ void ObjAttractRing(OBJECT *object)
 			//If player lost the lightning barrier, turn into a bouncing ring
 			if (object->parentPlayer->barrier != BARRIER_LIGHTNING)
 			{
-				object->function = ObjBouncingRing;
-				object->routine = 0;
-				object->xRadius = 8;
-				object->yRadius = 8;
+				int i = gLevel->particleSystem->Spawn(PARTICLETYPE_RING, object->x.pos, object->y.pos, object->xVel, object->yVel);
+				if (i >= 0 && object->parentPlayer->status.reverseGravity)
+					gLevel->particleSystem->flags[i] |= PARTICLEFLAG_REVERSEGRAVITY;
+				object->deleteFlag = true;
+				break;
 			}
 			
 			//Horizontal pull
@@ -82,7 +83,7 @@ void ObjAttractRing(OBJECT *object)
 			object->Move();
 			
 			object->mappingFrame = (gLevel->frameCounter >> 3) & 0x3;
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			break;
 		}
 		case 2: //Touched player, collect a ring
@@ -98,7 +99,7 @@ void ObjAttractRing(OBJECT *object)
 	//Fallthrough
 		case 3: //Sparkling
 			object->Animate(animationList);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			break;
 		case 4: //Deleting after sparkle
 			object->deleteFlag = true;
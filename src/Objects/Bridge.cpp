@@ -18,18 +18,18 @@ void ObjBridgeSegment(OBJECT *object)
 		switch (gLevel->zone)
 		{
 			case ZONEID_GHZ:
-				object->texture = gLevel->GetObjectTexture("data/Object/GHZGeneric.bmp");
-				object->mapping.mappings = gLevel->GetObjectMappings("data/Object/GHZBridge.map");
+				object->texture = gLevel->GetObjectTexture(TEXTUREID_GHZGENERIC);
+				object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_GHZBRIDGE);
 				break;
 			case ZONEID_EHZ:
-				object->texture = gLevel->GetObjectTexture("data/Object/EHZGeneric.bmp");
-				object->mapping.mappings = gLevel->GetObjectMappings("data/Object/EHZBridge.map");
+				object->texture = gLevel->GetObjectTexture(TEXTUREID_EHZGENERIC);
+				object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_EHZBRIDGE);
 				break;
 		}
 	}
 	
 	//Draw this segment
-	object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+	object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 }
 
 void ObjBridge(OBJECT *object)
@@ -42,6 +42,8 @@ void ObjBridge(OBJECT *object)
 	};
 	
 	SCRATCH *scratch = object->Scratch<SCRATCH>();
+	if (scratch == nullptr)
+		return;
 	
 	switch (object->routine)
 	{
@@ -59,9 +61,14 @@ void ObjBridge(OBJECT *object)
 			for (unsigned int i = 0; i < object->subtype; i++)
 			{
 				OBJECT *newSegment = new OBJECT(&ObjBridgeSegment);
+				if (newSegment == nullptr)
+				{
+					object->Cold()->fail = "Failed to allocate object in memory";
+					return;
+				}
 				newSegment->x.pos = bridgeLeft + 16 * i;
 				newSegment->y.pos = object->y.pos;
-				object->children.link_back(newSegment);
+				object->LinkChild(newSegment);
 			}
 		}
 //Fallthrough
@@ -79,7 +86,7 @@ void ObjBridge(OBJECT *object)
 			//Is a player standing on us?
 			bool touching = false;
 			for (int i = 0; i < OBJECT_PLAYER_REFERENCES; i++)
-				if (object->playerContact[i].standing)
+				if (object->Cold()->playerContact[i].standing)
 					touching = true;
 			
 			//Handle bridge depression stuff depending on players standing on us
@@ -102,7 +109,7 @@ void ObjBridge(OBJECT *object)
 					PLAYER *player = gLevel->playerList[i];
 					
 					//Check if this specific player is standing on us
-					if (object->playerContact[i].standing)
+					if (object->Cold()->playerContact[i].standing)
 					{
 						//If a secondary player, pull the bridge position slightly towards us
 						int16_t standingLog = ((player->x.pos - object->x.pos) + bridgeWidth) / 16;
@@ -126,18 +133,23 @@ void ObjBridge(OBJECT *object)
 					scratch->depressForce += 4;
 			}
 			
-			//Handle depression
-			for (size_t j = 0; j < object->children.size(); j++)
+			//Handle depression (remembering our logs in order, so players standing on us find theirs without walking our children again)
+			OBJECT *log[0x100];
+			size_t logs = 0;
+			
+			for (OBJECT *child = object->Cold()->firstChild; child != nullptr && logs < 0x100; child = child->Cold()->nextSibling, logs++)
 			{
+				log[logs] = child;
+				
 				//Get the angle of this log (go up to 0x40 from the left, and go back down to 0x00 to the right)
 				uint8_t angle;
-				if (j < scratch->depressPosition)
-					angle = (0x40 * (j + 1)) / (scratch->depressPosition + 1); //To the left of the depress position
+				if (logs < scratch->depressPosition)
+					angle = (0x40 * (logs + 1)) / (scratch->depressPosition + 1); //To the left of the depress position
 				else
-					angle = (0x40 * (object->subtype - j)) / (object->subtype - scratch->depressPosition); //To the right of the depress position
+					angle = (0x40 * (object->subtype - logs)) / (object->subtype - scratch->depressPosition); //To the right of the depress position
 				
 				//Set our depression position according to the force of a player above us and the angle of the log as gotten above
-				object->children[j]->y.pos = object->y.pos + (GetSin(scratch->depressForce * angle / 0x40) * depressForce[scratch->depressPosition] / 0x100);
+				child->y.pos = object->y.pos + (GetSin(scratch->depressForce * angle / 0x40) * depressForce[scratch->depressPosition] / 0x100);
 			}
 			
 			//Act as a solid platform
@@ -146,7 +158,7 @@ void ObjBridge(OBJECT *object)
 				//Get the player
 				PLAYER *player = gLevel->playerList[i];
 				
-				if (object->playerContact[i].standing)
+				if (object->Cold()->playerContact[i].standing)
 				{
 					//Check if we're leaving the platform
 					int16_t xDiff = (player->x.pos - object->x.pos) + bridgeWidth;
@@ -155,7 +167,7 @@ void ObjBridge(OBJECT *object)
 					{
 						//Leave the platform (don't set us to be inAir so walking or rolling off the bridge doesn't not work)
 						player->status.shouldNotFall = false;
-						object->playerContact[i].standing = false;
+						object->Cold()->playerContact[i].standing = false;
 					}
 					else
 					{
@@ -165,7 +177,8 @@ void ObjBridge(OBJECT *object)
 							scratch->depressPosition = xDiff;
 						
 						//Set our y-position
-						player->y.pos = object->children[xDiff]->y.pos - (8 + player->yRadius);
+						if ((size_t)xDiff < logs)
+							player->y.pos = log[xDiff]->y.pos - (8 + player->yRadius);
 					}
 				}
 				else
@@ -174,7 +187,7 @@ void ObjBridge(OBJECT *object)
 					int16_t standingLog = ((player->x.pos - object->x.pos) + bridgeWidth) / 16;
 					object->LandOnTopSolid(player, i, bridgeWidth, bridgeWidthSecondary, 8, object->x.pos, nullptr);
 					
-					if (object->playerContact[i].standing)
+					if (object->Cold()->playerContact[i].standing)
 					{
 						//If we're the lead, update depress position
 						if (i == 0)
@@ -32,6 +32,8 @@ void ObjBuzzBomberMissile(OBJECT *object)
 	};
 	
 	SCRATCH *scratch = object->Scratch<SCRATCH>();
+	if (scratch == nullptr)
+		return;
 	
 	switch (object->routine)
 	{
@@ -41,8 +43,8 @@ void ObjBuzzBomberMissile(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/Sonic1Badnik.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/Missile.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_SONIC1BADNIK);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_MISSILE);
 			
 			//Initialize other properties
 			object->renderFlags.alignPlane = true;
@@ -67,7 +69,7 @@ void ObjBuzzBomberMissile(OBJECT *object)
 			
 			//Draw and animate
 			object->Animate_S1(missileAnimationList);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			break;
 		}
 		case 2: //Missile hitbox initialization
@@ -76,7 +78,7 @@ void ObjBuzzBomberMissile(OBJECT *object)
 			object->collisionType = COLLISIONTYPE_HURT;
 			object->touchWidth = 6;
 			object->touchHeight = 6;
-			object->hurtType.reflect = true;
+			object->Cold()->hurtType.reflect = true;
 			object->anim = 1;
 			object->routine++;
 		}
@@ -89,7 +91,7 @@ void ObjBuzzBomberMissile(OBJECT *object)
 			else
 				object->MoveAndFall();
 			object->Animate_S1(missileAnimationList);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			
 			//Delete if below stage
 			if (object->y.pos >= gLevel->bottomBoundaryTarget)
@@ -110,6 +112,8 @@ void ObjBuzzBomber(OBJECT *object)
 	};
 	
 	SCRATCH *scratch = object->Scratch<SCRATCH>();
+	if (scratch == nullptr)
+		return;
 	
 	//Status bitmask
 	#define STATE_FIRED		0x01
@@ -123,8 +127,8 @@ void ObjBuzzBomber(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/Sonic1Badnik.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/BuzzBomber.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_SONIC1BADNIK);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_BUZZBOMBER);
 			
 			//Initialize other properties
 			object->renderFlags.alignPlane = true;
@@ -161,6 +165,11 @@ void ObjBuzzBomber(OBJECT *object)
 						{
 							//If near a player, fire in our facing direction
 							OBJECT *projectile = new OBJECT(&ObjBuzzBomberMissile);
+							if (projectile == nullptr)
+							{
+								object->Cold()->fail = "Failed to allocate object in memory";
+								return;
+							}
 							projectile->xVel = 0x200;
 							projectile->yVel = 0x200;
 							
@@ -176,7 +185,7 @@ void ObjBuzzBomber(OBJECT *object)
 							projectile->y.pos = object->y.pos + 28;
 							projectile->status = object->status;
 							projectile->parentObject = object;
-							gLevel->objectList.link_back(projectile);
+							gLevel->LinkObject(projectile);
 							
 							//Update our state
 							scratch->state = STATE_FIRED;
@@ -240,7 +249,7 @@ void ObjBuzzBomber(OBJECT *object)
 			
 			//Animate and draw
 			object->Animate_S1(animationList);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			object->UnloadOffscreen(object->x.pos);
 			break;
 		}
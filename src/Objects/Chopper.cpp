@@ -19,6 +19,8 @@ void ObjChopper(OBJECT *object)
 	};
 	
 	SCRATCH *scratch = object->Scratch<SCRATCH>();
+	if (scratch == nullptr)
+		return;
 	
 	switch (object->routine)
 	{
@@ -28,8 +30,8 @@ void ObjChopper(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/Sonic1Badnik.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/Chopper.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_SONIC1BADNIK);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_CHOPPER);
 			
 			//Initialize render properties
 			object->renderFlags.alignPlane = true;
@@ -76,7 +78,7 @@ void ObjChopper(OBJECT *object)
 			}
 			
 			//Draw
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			break;
 		}
 	}
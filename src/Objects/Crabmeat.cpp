@@ -31,8 +31,8 @@ void ObjCrabmeatProjectile(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/Sonic1Badnik.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/Crabmeat.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_SONIC1BADNIK);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_CRABMEAT);
 			
 			//Initialize other properties
 			object->renderFlags.alignPlane = true;
@@ -41,7 +41,7 @@ void ObjCrabmeatProjectile(OBJECT *object)
 			object->collisionType = COLLISIONTYPE_HURT;
 			object->touchWidth = 8;
 			object->touchHeight = 8;
-			object->hurtType.reflect = true;
+			object->Cold()->hurtType.reflect = true;
 			
 			object->widthPixels = 8;
 			object->yVel = -0x400;
@@ -53,7 +53,7 @@ void ObjCrabmeatProjectile(OBJECT *object)
 			//Move and fall, animate and draw
 			object->Animate(animationList);
 			object->MoveAndFall();
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			
 			//Delete if fell off stage
 			if (object->y.pos >= gLevel->bottomBoundaryTarget)
@@ -90,6 +90,8 @@ void ObjCrabmeat(OBJECT *object)
 	};
 	
 	SCRATCH *scratch = object->Scratch<SCRATCH>();
+	if (scratch == nullptr)
+		return;
 	
 	//Mode bitmask
 	#define MODE_COLLISION	0x1
@@ -104,8 +106,8 @@ void ObjCrabmeat(OBJECT *object)
 			object->yRadius = 16;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/Sonic1Badnik.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/Crabmeat.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_SONIC1BADNIK);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_CRABMEAT);
 			
 			//Initialize other properties
 			object->renderFlags.alignPlane = true;
@@ -126,7 +128,7 @@ void ObjCrabmeat(OBJECT *object)
 			object->MoveAndFall();
 			
 			//Check for the floor
-			uint8_t nextAngle;
+			uint8_t nextAngle = 0;
 			int16_t distance = object->CheckCollisionDown_1Point(COLLISIONLAYER_NORMAL_TOP, object->x.pos, object->y.pos + object->yRadius, &nextAngle);
 			if (distance >= 0)
 				break;
@@ -165,16 +167,26 @@ void ObjCrabmeat(OBJECT *object)
 							object->anim = 6;
 							
 							OBJECT *projLeft = new OBJECT(&ObjCrabmeatProjectile);
+							if (projLeft == nullptr)
+							{
+								object->Cold()->fail = "Failed to allocate object in memory";
+								return;
+							}
 							projLeft->x.pos = object->x.pos - 16;
 							projLeft->y.pos = object->y.pos;
 							projLeft->xVel = -0x100;
-							gLevel->objectList.link_back(projLeft);
+							gLevel->LinkObject(projLeft);
 							
 							OBJECT *projRight = new OBJECT(&ObjCrabmeatProjectile);
+							if (projRight == nullptr)
+							{
+								object->Cold()->fail = "Failed to allocate object in memory";
+								return;
+							}
 							projRight->x.pos = object->x.pos + 16;
 							projRight->y.pos = object->y.pos;
 							projRight->xVel = 0x100;
-							gLevel->objectList.link_back(projRight);
+							gLevel->LinkObject(projRight);
 						}
 					}
 					break;
@@ -215,7 +227,7 @@ void ObjCrabmeat(OBJECT *object)
 			
 			//Animate and draw
 			object->Animate_S1(animationList);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			object->UnloadOffscreen(object->x.pos);
 			break;
 		}
@@ -39,8 +39,8 @@ void ObjScore(OBJECT *object)
 	{
 		case 0:
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/Generic.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/Score.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_GENERIC);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_SCORE);
 			
 			//Initialize other properties
 			object->renderFlags.alignPlane = true;
@@ -61,7 +61,7 @@ void ObjScore(OBJECT *object)
 			//Move, fall, and draw to screen
 			object->Move();
 			object->yVel += 0x18;
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			break;
 	}
 }
@@ -80,61 +80,29 @@ void ObjExplosion(OBJECT *object)
 			//OBJECT *newAnimal = new OBJECT(&ObjAnimal);
 			//newAnimal->x.pos = object->x.pos;
 			//newAnimal->y.pos = object->y.pos;
-			//gLevel->objectList.link_back(newAnimal);
+			//gLevel->LinkObject(newAnimal);
 			
 			OBJECT *newScore = new OBJECT(&ObjScore);
+			if (newScore == nullptr)
+			{
+				object->Cold()->fail = "Failed to allocate object in memory";
+				return;
+			}
 			newScore->x.pos = object->x.pos;
 			newScore->y.pos = object->y.pos;
 			newScore->mappingFrame = object->subtype;
-			gLevel->objectList.link_back(newScore);
+			gLevel->LinkObject(newScore);
 		}
 	//Fallthrough
 		case 1: //Explosion without an animal
 		{
-			//Advance routine
-			object->routine++;
-			
 			//Play pop sound
 			PlaySound(SOUNDID_POP);
 			
-			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/Generic.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/Explosion.map");
-			
-			//Initialize other properties
-			object->renderFlags.xFlip = false;
-			object->renderFlags.yFlip = false;
-			object->renderFlags.alignPlane = true;
-			object->priority = 1;
-			
-			//Clear collision
+			//Replace us with an explosion particle
+			gLevel->particleSystem->Spawn(PARTICLETYPE_EXPLOSION, object->x.pos, object->y.pos);
 			object->collisionType = COLLISIONTYPE_NULL;
-			
-			//Other stuff
-			object->widthPixels = 12;
-			
-			//Initialize animation
-			object->animFrameDuration = 3;
-			object->mappingFrame = 0;
-		}
-	//Fallthrough
-		case 2:
-		{
-			//Animate
-			if (object->animFrameDuration-- == 0)
-			{
-				object->animFrameDuration = 7;
-				
-				//Advance frame, and delete once finished
-				if (++object->mappingFrame == 5)
-				{
-					object->deleteFlag = true;
-					break;
-				}
-			}
-			
-			//Draw
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->deleteFlag = true;
 			break;
 		}
 	}
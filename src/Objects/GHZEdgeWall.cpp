@@ -73,13 +73,13 @@ void ObjGHZEdgeWall_Solid_Individual(PLAYER *player, int i, OBJECT *object, int1
 		if (!player->status.inAir)
 		{
 			//On ground, set pushing
-			object->playerContact[i].pushing = true;
+			object->Cold()->playerContact[i].pushing = true;
 			player->status.pushing = true;
 		}
 		else
 		{
 			//In mid-air, clear pushing
-			object->playerContact[i].pushing = false;
+			object->Cold()->playerContact[i].pushing = false;
 			player->status.pushing = false;
 		}
 	}
@@ -96,11 +96,11 @@ void ObjGHZEdgeWall_Solid_Individual(PLAYER *player, int i, OBJECT *object, int1
 	else
 	{
 		//No collision, clear pushing flags
-		if (object->playerContact[i].pushing)
+		if (object->Cold()->playerContact[i].pushing)
 		{
 			if (player->anim != PLAYERANIMATION_ROLL && player->anim != PLAYERANIMATION_DROPDASH)
 				player->anim = PLAYERANIMATION_RUN; //wrong animation again
-			object->playerContact[i].pushing = false;
+			object->Cold()->playerContact[i].pushing = false;
 			player->status.pushing = false;
 		}
 	}
@@ -125,8 +125,8 @@ void ObjGHZEdgeWall(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/GHZGeneric.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/GHZEdgeWall.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_GHZGENERIC);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_GHZEDGEWALL);
 			
 			//Set other render properties
 			object->renderFlags.alignPlane = true;
@@ -143,7 +143,7 @@ void ObjGHZEdgeWall(OBJECT *object)
 				ObjGHZEdgeWall_Solid(object, 19, 40);
 			
 			//Draw
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			object->UnloadOffscreen(object->x.pos);
 			break;
 		}
@@ -42,23 +42,6 @@ const OBJECT_FRAGMENTMAP ledgeFragment[] = {
 	{{48, 68, 16, 16}, 10},
 };
 
-void ObjGHZLedge_Fragment(OBJECT *object)
-{
-	//Wait the given amount of time to start falling
-	if (object->subtype == 0)
-	{
-		//Move, fall, and delete once off-screen
-		object->MoveAndFall();
-		if (!object->renderFlags.isOnscreen)
-			object->deleteFlag = true;
-	}
-	else
-		object->subtype--;
-	
-	//Draw to screen
-	object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
-}
-
 void ObjGHZLedge(OBJECT *object)
 {
 	//Define and allocate our scratch
@@ -69,6 +52,8 @@ void ObjGHZLedge(OBJECT *object)
 	};
 	
 	SCRATCH *scratch = object->Scratch<SCRATCH>();
+	if (scratch == nullptr)
+		return;
 	
 	switch (object->routine)
 	{
@@ -77,8 +62,8 @@ void ObjGHZLedge(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/GHZGeneric.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/GHZLedge.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_GHZGENERIC);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_GHZLEDGE);
 			
 			//Initialize render properties
 			object->renderFlags.alignPlane = true;
@@ -93,7 +78,7 @@ void ObjGHZLedge(OBJECT *object)
 			//Set collapse flag if a player standing on us
 			for (size_t i = 0; i < gLevel->playerList.size(); i++)
 			{
-				if (object->playerContact[i].standing && scratch->flag == 0)
+				if (object->Cold()->playerContact[i].standing && scratch->flag == 0)
 				{
 					scratch->flag = 1;
 					break;
@@ -107,7 +92,7 @@ void ObjGHZLedge(OBJECT *object)
 				if (scratch->delay == 0)
 				{
 					//Fragment and go to deletion routine
-					object->Fragment(25, ledgeFragment, &ObjGHZLedge_Fragment);
+					object->Fragment(25, ledgeFragment);
 					scratch->delay = ledgeFragment[0].delay;
 					scratch->flag = 2;
 					break;
@@ -128,7 +113,7 @@ void ObjGHZLedge(OBJECT *object)
 					#ifndef FIX_PLAYER_RELEASE
 						if (player->status.shouldNotFall)
 					#else
-						if (object->playerContact[i].standing)
+						if (object->Cold()->playerContact[i].standing)
 					#endif
 						{
 							player->status.shouldNotFall = false;
@@ -151,7 +136,7 @@ void ObjGHZLedge(OBJECT *object)
 			object->SolidObjectTop(48, 32, object->x.pos, false, ledgeSlope);
 			if (scratch->flag <= 1)
 			{
-				object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+				object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 				object->UnloadOffscreen(object->x.pos);
 			}
 			break;
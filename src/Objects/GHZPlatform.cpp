@@ -15,6 +15,8 @@ void ObjGHZPlatform_Move(OBJECT *object)
 {
 	//Get (but hopefully not allocate) our scratch
 	SCRATCH_GHZPlatform *scratch = object->Scratch<SCRATCH_GHZPlatform>();
+	if (scratch == nullptr)
+		return;
 	
 	//Move platform based on our subtype
 	uint8_t type = object->subtype & 0xF;
@@ -94,7 +96,7 @@ void ObjGHZPlatform_Move(OBJECT *object)
 						//Make player airborne
 						player->status.inAir = true;
 						player->status.shouldNotFall = false;
-						object->playerContact[i].standing = false;
+						object->Cold()->playerContact[i].standing = false;
 						player->yVel = object->yVel;
 					}
 				}
@@ -129,6 +131,8 @@ void ObjGHZPlatform(OBJECT *object)
 {
 	//Allocate scratch memory
 	SCRATCH_GHZPlatform *scratch = object->Scratch<SCRATCH_GHZPlatform>();
+	if (scratch == nullptr)
+		return;
 	
 	switch (object->routine)
 	{
@@ -137,8 +141,8 @@ void ObjGHZPlatform(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/GHZGeneric.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/GHZPlatform.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_GHZGENERIC);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_GHZPLATFORM);
 			
 			//Initialize render properties
 			object->renderFlags.alignPlane = true;
@@ -161,7 +165,7 @@ void ObjGHZPlatform(OBJECT *object)
 			//Is a player standing on us?
 			bool touching = false;
 			for (int i = 0; i < OBJECT_PLAYER_REFERENCES; i++)
-				if (object->playerContact[i].standing)
+				if (object->Cold()->playerContact[i].standing)
 					touching = true;
 			
 			//Decrease / increase our weight
@@ -183,7 +187,7 @@ void ObjGHZPlatform(OBJECT *object)
 				object->SolidObjectTop(object->widthPixels, 9, lastX, false, nullptr);
 			
 			//Draw
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			object->UnloadOffscreen(scratch->origX >> 16);
 			break;
 		}
@@ -191,7 +195,7 @@ void ObjGHZPlatform(OBJECT *object)
 		{
 			//Handle routines and draw
 			ObjGHZPlatform_Move(object);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			object->UnloadOffscreen(scratch->origX >> 16);
 			break;
 		}
@@ -10,8 +10,8 @@ void ObjGHZPurpleRock(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/GHZGeneric.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/GHZPurpleRock.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_GHZGENERIC);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_GHZPURPLEROCK);
 			
 			//Set render properties
 			object->renderFlags.alignPlane = true;
@@ -24,7 +24,7 @@ void ObjGHZPurpleRock(OBJECT *object)
 		{
 			//Act as solid and draw to screen
 			object->SolidObjectFull(27, 16, 16, object->x.pos, false, nullptr, false);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			object->UnloadOffscreen(object->x.pos);
 			break;
 		}
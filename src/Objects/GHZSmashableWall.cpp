@@ -25,17 +25,6 @@ static const OBJECT_SMASHMAP smashmapLeft[8] = {
 	{{16, 48, 16, 16}, -0x400,  0x500},
 };
 
-//Fragment
-void ObjGHZWallFragment(OBJECT *object)
-{
-	//Move, fall, and delete once off-screen
-	object->Move();
-	object->yVel += 0x70;
-	object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
-	if (!object->renderFlags.isOnscreen)
-		object->deleteFlag = true;
-}
-
 //Smashable wall object
 void ObjGHZSmashableWall(OBJECT *object)
 {
@@ -47,8 +36,8 @@ void ObjGHZSmashableWall(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/GHZGeneric.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/GHZSmashableWall.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_GHZGENERIC);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_GHZSMASHABLEWALL);
 			
 			//Initialize other render properties
 			object->renderFlags.alignPlane = true;
@@ -95,8 +84,8 @@ void ObjGHZSmashableWall(OBJECT *object)
 						player->inertia = player->xVel;
 						player->status.pushing = false;
 						
-						object->playerContact[i].pushing = false;
-						object->Smash(8, smashmap, &ObjGHZWallFragment);
+						object->Cold()->playerContact[i].pushing = false;
+						object->Smash(8, smashmap);
 						
 						//Delete us
 						object->deleteFlag = true;
@@ -110,6 +99,6 @@ void ObjGHZSmashableWall(OBJECT *object)
 	}
 	
 	//Draw and unload once off-screen
-	object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+	object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 	object->UnloadOffscreen(object->x.pos);
 }
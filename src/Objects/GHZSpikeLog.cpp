@@ -10,8 +10,8 @@ void ObjGHZSpikeLog_Segment(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/GHZGeneric.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/GHZSpikeLog.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_GHZGENERIC);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_GHZSPIKELOG);
 			
 			//Initialize render properties
 			object->renderFlags.alignPlane = true;
@@ -37,7 +37,7 @@ void ObjGHZSpikeLog_Segment(OBJECT *object)
 			}
 			
 			//Draw us
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 		}
 	}
 }
@@ -56,10 +56,15 @@ void ObjGHZSpikeLog(OBJECT *object)
 			for (unsigned int i = 0; i < object->subtype; i++)
 			{
 				OBJECT *newSegment = new OBJECT(&ObjGHZSpikeLog_Segment);
+				if (newSegment == nullptr)
+				{
+					object->Cold()->fail = "Failed to allocate object in memory";
+					return;
+				}
 				newSegment->x.pos = logLeft + 16 * i;
 				newSegment->y.pos = object->y.pos;
 				newSegment->subtype = (i & 0x7);
-				object->children.link_back(newSegment);
+				object->LinkChild(newSegment);
 			}
 		}
 	//Fallthrough
@@ -39,6 +39,8 @@ void ObjGHZSpikes(OBJECT *object)
 	};
 	
 	SCRATCH *scratch = object->Scratch<SCRATCH>();
+	if (scratch == nullptr)
+		return;
 	
 	switch (object->routine)
 	{
@@ -48,8 +50,8 @@ void ObjGHZSpikes(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/GHZGeneric.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/GHZSpikes.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_GHZGENERIC);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_GHZSPIKES);
 			
 			//Initialize render properties
 			object->renderFlags.alignPlane = true;
@@ -87,7 +89,7 @@ void ObjGHZSpikes(OBJECT *object)
 					//Check for players touching us and getting hurt
 					for (size_t i = 0; i < gLevel->playerList.size(); i++)
 					{
-						if (object->playerContact[i].standing == false && object->playerContact[i].pushing == true)
+						if (object->Cold()->playerContact[i].standing == false && object->Cold()->playerContact[i].pushing == true)
 							ObjGHZSpikes_Hurt(object, gLevel->playerList[i]);
 					}
 					break;
@@ -101,7 +103,7 @@ void ObjGHZSpikes(OBJECT *object)
 					//Check for players touching us and getting hurt
 					for (size_t i = 0; i < gLevel->playerList.size(); i++)
 					{
-						if (object->playerContact[i].standing == true)
+						if (object->Cold()->playerContact[i].standing == true)
 							ObjGHZSpikes_Hurt(object, gLevel->playerList[i]);
 					}
 					break;
@@ -109,7 +111,7 @@ void ObjGHZSpikes(OBJECT *object)
 			}
 			
 			//Draw and check for unloading
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			object->UnloadOffscreen(scratch->origX);
 			break;
 		}
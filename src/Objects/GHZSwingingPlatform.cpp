@@ -12,6 +12,8 @@ void ObjGHZSwingingPlatform_Move_Individual(OBJECT *parent, OBJECT *child, int16
 {
 	//Get (but hopefully not allocate) our parent's scratch
 	SCRATCH_GHZSwingingPlatform *scratch = parent->Scratch<SCRATCH_GHZSwingingPlatform>();
+	if (scratch == nullptr)
+		return;
 	
 	//Get our next position
 	int16_t origX = scratch->origX;
@@ -34,8 +36,8 @@ void ObjGHZSwingingPlatform_Move(OBJECT *object)
 	
 	//Move all child objects (and self)
 	int16_t sin = GetSin(oscillate), cos = GetCos(oscillate);
-	for (size_t i = 0; i < object->children.size(); i++)
-		ObjGHZSwingingPlatform_Move_Individual(object, object->children[i], sin, cos);
+	for (OBJECT *child = object->Cold()->firstChild; child != nullptr; child = child->Cold()->nextSibling)
+		ObjGHZSwingingPlatform_Move_Individual(object, child, sin, cos);
 	ObjGHZSwingingPlatform_Move_Individual(object, object, sin, cos);
 }
 
@@ -43,6 +45,8 @@ void ObjGHZSwingingPlatform(OBJECT *object)
 {
 	//Allocate scratch memory
 	SCRATCH_GHZSwingingPlatform *scratch = object->Scratch<SCRATCH_GHZSwingingPlatform>();
+	if (scratch == nullptr)
+		return;
 	
 	switch (object->routine)
 	{
@@ -52,8 +56,8 @@ void ObjGHZSwingingPlatform(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/GHZGeneric.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/GHZSwingingPlatform.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_GHZGENERIC);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_GHZSWINGINGPLATFORM);
 			
 			//Initialize render properties
 			object->renderFlags.alignPlane = true;
@@ -76,8 +80,13 @@ void ObjGHZSwingingPlatform(OBJECT *object)
 			{
 				//Create a segment
 				OBJECT *newSegment = new OBJECT(&ObjGHZSwingingPlatform);
-				newSegment->texture = gLevel->GetObjectTexture("data/Object/GHZGeneric.bmp");
-				newSegment->mapping.mappings = gLevel->GetObjectMappings("data/Object/GHZSwingingPlatform.map");
+				if (newSegment == nullptr)
+				{
+					object->Cold()->fail = "Failed to allocate object in memory";
+					return;
+				}
+				newSegment->texture = gLevel->GetObjectTexture(TEXTUREID_GHZGENERIC);
+				newSegment->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_GHZSWINGINGPLATFORM);
 				newSegment->renderFlags.alignPlane = true;
 				newSegment->widthPixels = 8;
 				newSegment->heightPixels = 32;
@@ -94,8 +103,8 @@ void ObjGHZSwingingPlatform(OBJECT *object)
 					newSegment->priority = 3;
 				}
 				
-				//Link to children list
-				object->children.link_back(newSegment);
+				//Link as our child
+				object->LinkChild(newSegment);
 			}
 			
 			//Set the Y-offset for the platform too
@@ -108,14 +117,14 @@ void ObjGHZSwingingPlatform(OBJECT *object)
 			int16_t lastX = object->x.pos;
 			ObjGHZSwingingPlatform_Move(object);
 			object->SolidObjectTop(object->widthPixels, object->yRadius + 1, lastX, false, nullptr);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			object->UnloadOffscreen(scratch->origX);
 			break;
 		}
 		case 2:
 		{
 			//Draw
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			break;
 		}
 	}
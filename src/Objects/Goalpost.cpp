@@ -35,6 +35,8 @@ void ObjGoalpost(OBJECT *object)
 	};
 	
 	SCRATCH *scratch = object->Scratch<SCRATCH>();
+	if (scratch == nullptr)
+		return;
 	
 	switch (object->routine)
 	{
@@ -44,8 +46,8 @@ void ObjGoalpost(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/Generic.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/Goalpost.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_GENERIC);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_GOALPOST);
 			
 			//Initialize other properties
 			object->renderFlags.alignPlane = true;
@@ -99,10 +101,15 @@ void ObjGoalpost(OBJECT *object)
 				
 				//Create a sparkle object
 				OBJECT *sparkle = new OBJECT(&ObjRing);
+				if (sparkle == nullptr)
+				{
+					object->Cold()->fail = "Failed to allocate object in memory";
+					return;
+				}
 				sparkle->anim = 1;
 				sparkle->x.pos = object->x.pos + goalpostSparklePos[scratch->sparkle][0];
 				sparkle->y.pos = object->y.pos + goalpostSparklePos[scratch->sparkle][1];
-				gLevel->objectList.link_back(sparkle);
+				gLevel->LinkObject(sparkle);
 			}
 			break;
 		}
@@ -141,5 +148,5 @@ void ObjGoalpost(OBJECT *object)
 	
 	//Animate and draw sprite
 	object->Animate(animationList);
-	object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+	object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 }
@@ -10,14 +10,16 @@ void ObjMinecart(OBJECT *object)
 	};
 	
 	SCRATCH *scratch = object->Scratch<SCRATCH>();
+	if (scratch == nullptr)
+		return;
 	
 	switch (object->routine)
 	{
 		case 0:
 		{
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/Minecart.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/Minecart.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_MINECART);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_MINECART);
 			
 			//Initialize other properties
 			object->routine++;
@@ -240,7 +242,7 @@ void ObjMinecart(OBJECT *object)
 				}
 				
 				//Friction when standing on minecart
-				if (object->playerContact[v].standing)
+				if (object->Cold()->playerContact[v].standing)
 					player->inertia = player->inertia * 8 / 9;
 			}
 			
@@ -251,7 +253,7 @@ void ObjMinecart(OBJECT *object)
 			else if (object->xVel < 0)
 				object->renderFlags.xFlip = true;
 			
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			break;
 		}
 		case 3: //Breaking
@@ -266,7 +268,7 @@ void ObjMinecart(OBJECT *object)
 				//Get the player
 				PLAYER *player = gLevel->playerList[i];
 				
-				if (object->playerContact[i].standing)
+				if (object->Cold()->playerContact[i].standing)
 				{
 					object->ReleasePlayer(player, i, true);
 					player->routine = PLAYERROUTINE_HURT;
@@ -285,7 +287,7 @@ void ObjMinecart(OBJECT *object)
 			if ((int8_t)(--object->routineSecondary) < 0)
 				object->deleteFlag = true;
 			else if (object->routineSecondary & 0x1)
-				object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+				object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 		}
 	}
 	
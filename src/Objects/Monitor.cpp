@@ -25,23 +25,23 @@ void ObjMonitor_ChkOverEdge(OBJECT *object, int i, PLAYER *player)
 		//Leave the top of the monitor
 		player->status.shouldNotFall = false;
 		player->status.inAir = true;
-		object->playerContact[i].standing = false;
+		object->Cold()->playerContact[i].standing = false;
 	}
 }
 
 void ObjMonitor_SolidObject_Lead(OBJECT *object, int i, PLAYER *player)
 {
 	//Basically, act as a solid if we're either already on top of the monitor, or not in ball form
-	if (object->playerContact[i].standing)
+	if (object->Cold()->playerContact[i].standing)
 		ObjMonitor_ChkOverEdge(object, i, player);
 	else if (player->anim != PLAYERANIMATION_ROLL && player->anim != PLAYERANIMATION_DROPDASH)
 		object->SolidObjectFull_Cont(nullptr, player, i, MONITOR_WIDTH, MONITOR_HEIGHT, object->x.pos, nullptr, false);
 #ifdef MONITOR_FIX_PUSHING
-	else if (object->playerContact[i].pushing)
+	else if (object->Cold()->playerContact[i].pushing)
 	{
 		//Clear pushing
 		player->status.pushing = false;
-		object->playerContact[i].pushing = false;
+		object->Cold()->playerContact[i].pushing = false;
 	}
 #endif
 }
@@ -49,7 +49,7 @@ void ObjMonitor_SolidObject_Lead(OBJECT *object, int i, PLAYER *player)
 void ObjMonitor_SolidObject_Follower(OBJECT *object, int i, PLAYER *player)
 {
 	//There's a 2-player check in Sonic 2 here
-	if (object->playerContact[i].standing)
+	if (object->Cold()->playerContact[i].standing)
 		ObjMonitor_ChkOverEdge(object, i, player);
 	else
 		object->SolidObjectFull_Cont(nullptr, player, i, MONITOR_WIDTH, MONITOR_HEIGHT, object->x.pos, nullptr, false);
@@ -119,8 +119,8 @@ void ObjMonitorContents(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/Generic.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/MonitorContents.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_GENERIC);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_MONITORCONTENTS);
 			
 			//Set render properties and velocity
 			object->renderFlags.alignPlane = true;
@@ -187,7 +187,7 @@ void ObjMonitorContents(OBJECT *object)
 				}
 			}
 			
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			break;
 		}
 		case 2: //Waiting for deletion
@@ -196,7 +196,7 @@ void ObjMonitorContents(OBJECT *object)
 			if (--object->animFrameDuration < 0)
 				object->deleteFlag = true;
 			else
-				object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+				object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 		}
 	}
 }
@@ -214,8 +214,8 @@ void ObjMonitor(OBJECT *object)
 			object->yRadius = 14;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/Generic.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/Monitor.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_GENERIC);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_MONITOR);
 			
 			//Set render properties
 			object->renderFlags.alignPlane = true;
@@ -263,7 +263,7 @@ void ObjMonitor(OBJECT *object)
 			
 			//Act as solid, draw and animate
 			ObjMonitor_SolidObject(object);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			object->Animate(animationList);
 			object->UnloadOffscreen(object->x.pos);
 			break;
@@ -279,29 +279,31 @@ void ObjMonitor(OBJECT *object)
 			
 			//Create the item content thing
 			OBJECT *content = new OBJECT(&ObjMonitorContents);
+			if (content == nullptr)
+			{
+				object->Cold()->fail = "Failed to allocate object in memory";
+				return;
+			}
 			content->x.pos = object->x.pos;
 			content->y.pos = object->y.pos;
 			content->anim = object->anim;
 			content->parentObject = object;
-			gLevel->objectList.link_back(content);
+			gLevel->LinkObject(content);
 			
-			//Create the explosion
-			OBJECT *explosion = new OBJECT(&ObjExplosion);
-			explosion->x.pos = object->x.pos;
-			explosion->y.pos = object->y.pos;
-			explosion->routine++; //Don't create animal or score
-			gLevel->objectList.link_back(explosion);
+			//Create the explosion (without an animal or score)
+			PlaySound(SOUNDID_POP);
+			gLevel->particleSystem->Spawn(PARTICLETYPE_EXPLOSION, object->x.pos, object->y.pos);
 			
 			//Set to broken animation and draw
 			gLevel->GetObjectLoad(object)->specificBit = true;
 			object->anim = MONITOR_ITEM_BROKEN;
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			break;
 		}
 		case 3: //Broken
 		{
 			//Draw and animate
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			object->Animate(animationList);
 			object->UnloadOffscreen(object->x.pos);
 			break;
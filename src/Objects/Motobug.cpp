@@ -20,12 +20,14 @@ void ObjMotobug(OBJECT *object)
 	};
 	
 	SCRATCH *scratch = object->Scratch<SCRATCH>();
+	if (scratch == nullptr)
+		return;
 	
 	if (object->routine == 0)
 	{
 		//Load graphics
-		object->texture = gLevel->GetObjectTexture("data/Object/Sonic1Badnik.bmp");
-		object->mapping.mappings = gLevel->GetObjectMappings("data/Object/Motobug.map");
+		object->texture = gLevel->GetObjectTexture(TEXTUREID_SONIC1BADNIK);
+		object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_MOTOBUG);
 		
 		//Initialize other properties
 		object->routine++;
@@ -112,11 +114,16 @@ void ObjMotobug(OBJECT *object)
 						scratch->smokeDelay = 15;
 						
 						OBJECT *newSmoke = new OBJECT(&ObjMotobug);
+						if (newSmoke == nullptr)
+						{
+							object->Cold()->fail = "Failed to allocate object in memory";
+							return;
+						}
 						newSmoke->x.pos = object->x.pos;
 						newSmoke->y.pos = object->y.pos;
 						newSmoke->status = object->status;
 						newSmoke->anim = 2;
-						gLevel->objectList.link_back(newSmoke);
+						gLevel->LinkObject(newSmoke);
 					}
 					break;
 				}
@@ -124,7 +131,7 @@ void ObjMotobug(OBJECT *object)
 			
 			//Animate and draw
 			object->Animate_S1(animationList);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			object->UnloadOffscreen(object->x.pos);
 			break;
 		}
@@ -132,7 +139,7 @@ void ObjMotobug(OBJECT *object)
 		{
 			//Animate and draw
 			object->Animate_S1(animationList);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			break;
 		}
 		case 4: //Smoke deletion
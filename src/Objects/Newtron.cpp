@@ -34,8 +34,8 @@ void ObjNewtronMissile(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/Sonic1Badnik.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/Missile.map");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_SONIC1BADNIK);
+			object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_MISSILE);
 			
 			//Initialize other properties
 			object->renderFlags.alignPlane = true;
@@ -48,11 +48,11 @@ void ObjNewtronMissile(OBJECT *object)
 			object->collisionType = COLLISIONTYPE_HURT;
 			object->touchWidth = 6;
 			object->touchHeight = 6;
-			object->hurtType.reflect = true;
+			object->Cold()->hurtType.reflect = true;
 			
 			//Draw and animate
 			object->Animate_S1(missileAnimationList);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			break;
 		}
 		case 1:
@@ -70,7 +70,7 @@ void ObjNewtronMissile(OBJECT *object)
 			else
 				object->MoveAndFall();
 			object->Animate_S1(missileAnimationList);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			break;
 		}
 	}
@@ -87,11 +87,11 @@ void ObjNewtron(OBJECT *object)
 			object->routine++;
 			
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/Sonic1Badnik.bmp");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_SONIC1BADNIK);
 			if (object->subtype == 0)
-				object->mapping.mappings = gLevel->GetObjectMappings("data/Object/NewtronBlue.map");
+				object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_NEWTRONBLUE);
 			else
-				object->mapping.mappings = gLevel->GetObjectMappings("data/Object/NewtronGreen.map");
+				object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_NEWTRONGREEN);
 			
 			//Initialize other properties
 			object->renderFlags.alignPlane = true;
@@ -231,6 +231,11 @@ void ObjNewtron(OBJECT *object)
 						
 						//Fire a missile in our facing direction
 						OBJECT *projectile = new OBJECT(&ObjNewtronMissile);
+						if (projectile == nullptr)
+						{
+							object->Cold()->fail = "Failed to allocate object in memory";
+							return;
+						}
 						projectile->xVel = 0x200;
 						
 						int16_t xOff = 20;
@@ -244,7 +249,7 @@ void ObjNewtron(OBJECT *object)
 						projectile->x.pos = object->x.pos + xOff;
 						projectile->y.pos = object->y.pos - 8;
 						projectile->status = object->status;
-						gLevel->objectList.link_back(projectile);
+						gLevel->LinkObject(projectile);
 					}
 					break;
 				}
@@ -252,7 +257,7 @@ void ObjNewtron(OBJECT *object)
 			
 			//Animate and draw
 			object->Animate_S1(animationList);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			object->UnloadOffscreen(object->x.pos);
 			break;
 		}
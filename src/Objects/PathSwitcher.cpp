@@ -25,9 +25,9 @@ void ObjPathSwitcher(OBJECT *object)
 			{
 				PLAYER *player = gLevel->playerList[i];
 				if (object->subtype & MASK_VERTICAL)
-					object->playerContact[i].objectSpecific = player->y.pos >= object->y.pos;
+					object->Cold()->playerContact[i].objectSpecific = player->y.pos >= object->y.pos;
 				else
-					object->playerContact[i].objectSpecific = player->x.pos >= object->x.pos;
+					object->Cold()->playerContact[i].objectSpecific = player->x.pos >= object->x.pos;
 			}
 		}
 //Fallthrough
@@ -44,7 +44,7 @@ void ObjPathSwitcher(OBJECT *object)
 					continue;
 				
 				//Get which side we're on
-				bool newSide = object->playerContact[i].objectSpecific;
+				bool newSide = object->Cold()->playerContact[i].objectSpecific;
 				if (object->subtype & MASK_VERTICAL)
 				{
 					if (player->y.pos > object->y.pos)
@@ -61,10 +61,10 @@ void ObjPathSwitcher(OBJECT *object)
 				}
 				
 				//Have we changed sides
-				if (newSide != object->playerContact[i].objectSpecific)
+				if (newSide != object->Cold()->playerContact[i].objectSpecific)
 				{
 					//Set our side, path, and priority
-					object->playerContact[i].objectSpecific = newSide;
+					object->Cold()->playerContact[i].objectSpecific = newSide;
 					
 					//Check if we're grounded (ground-only?)
 					if ((object->subtype & MASK_GROUND_ONLY) == 0 || !player->status.inAir)
@@ -12,8 +12,8 @@ void ObjRing(OBJECT *object)
 	if (object->routine == 0)
 	{
 		//Load graphics
-		object->texture = gLevel->GetObjectTexture("data/Object/Generic.bmp");
-		object->mapping.mappings = gLevel->GetObjectMappings("data/Object/Ring.map");
+		object->texture = gLevel->GetObjectTexture(TEXTUREID_GENERIC);
+		object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_RING);
 		
 		//Initialize other properties
 		object->renderFlags.alignPlane = true;
@@ -41,7 +41,7 @@ void ObjRing(OBJECT *object)
 	{
 		case 1: //Waiting for contact, just animate
 			object->mappingFrame = (gLevel->frameCounter >> 3) & 0x3;
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			object->UnloadOffscreen(object->x.pos);
 			break;
 		case 2: //Touched player, collect a ring
@@ -57,61 +57,11 @@ void ObjRing(OBJECT *object)
 	//Fallthrough
 		case 3: //Sparkling
 			object->Animate(animationList);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			break;
 		case 4: //Deleting after sparkle
 			object->deleteFlag = true;
 			gLevel->ReleaseObjectLoad(object);
 			break;
 	}
-}
-
-//Used for Sonic 1 levels
-static const int8_t posData[16][2] = {
-	{ 0x10, 0x00},
-	{ 0x18, 0x00},
-	{ 0x20, 0x00},
-	{ 0x00, 0x10},
-	{ 0x00, 0x18},
-	{ 0x00, 0x20},
-	{ 0x10, 0x10},
-	{ 0x18, 0x18},
-	{ 0x20, 0x20},
-	{-0x10, 0x10},
-	{-0x18, 0x18},
-	{-0x20, 0x20},
-	{ 0x10, 0x08},
-	{ 0x18, 0x10},
-	{-0x10, 0x08},
-	{-0x18, 0x10},
-};
-		
-void ObjRingSpawner(OBJECT *object)
-{
-	int16_t xPos = object->x.pos;
-	int16_t yPos = object->y.pos;
-	
-	//Create rings (lowest nibble of subtype)
-	int ringsToMake = (object->subtype & 0x7);
-	if (ringsToMake == 7)
-		ringsToMake = 6;
-	
-	for (int i = 0; i <= ringsToMake; i++)
-	{
-		//Create ring object
-		OBJECT *newObject = new OBJECT(&ObjRing);
-		newObject->x.pos = xPos;
-		newObject->y.pos = yPos;
-		gLevel->objectList.link_back(newObject);
-		
-		gLevel->LinkObjectLoad(newObject);
-		
-		//Get next position
-		xPos += posData[object->subtype >> 4][0];
-		yPos += posData[object->subtype >> 4][1];
-	}
-	
-	//Delete us
-	gLevel->ReleaseObjectLoad(object);
-	object->deleteFlag = true;
 }
\ No newline at end of file
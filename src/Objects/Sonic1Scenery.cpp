@@ -15,8 +15,8 @@ void ObjSonic1Scenery(OBJECT *object)
 				case 3:
 					//Load graphics
 					object->mappingFrame = 1;
-					object->texture = gLevel->GetObjectTexture("data/Object/GHZGeneric.bmp");
-					object->mapping.mappings = gLevel->GetObjectMappings("data/Object/GHZBridge.map");
+					object->texture = gLevel->GetObjectTexture(TEXTUREID_GHZGENERIC);
+					object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_GHZBRIDGE);
 					object->widthPixels = 16;
 					object->heightPixels = 32;
 					object->priority = 1;
@@ -31,7 +31,7 @@ void ObjSonic1Scenery(OBJECT *object)
 	//Fallthrough
 		case 1:
 		{
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			object->UnloadOffscreen(object->x.pos);
 			break;
 		}
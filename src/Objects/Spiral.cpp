@@ -100,7 +100,7 @@ void ObjSpiral(OBJECT *object) //Also MTZ cylinder
 				//Get the player
 				PLAYER *player = gLevel->playerList[i];
 				
-				if (object->playerContact[i].standing == false) //Not already on the spiral
+				if (object->Cold()->playerContact[i].standing == false) //Not already on the spiral
 				{
 					if (player->status.inAir) //Don't run on corkscrew if in mid-air
 						continue;
@@ -177,7 +177,7 @@ void ObjSpiral(OBJECT *object) //Also MTZ cylinder
 					
 					//Fall off
 					player->status.shouldNotFall = false;
-					object->playerContact[i].standing = false;
+					object->Cold()->playerContact[i].standing = false;
 					player->flipsRemaining = false;
 					player->flipSpeed = 4;
 				}
@@ -71,11 +71,11 @@ void ObjSpring(OBJECT *object)
 		case 0:
 		{
 			//Load graphics
-			object->texture = gLevel->GetObjectTexture("data/Object/Generic.bmp");
+			object->texture = gLevel->GetObjectTexture(TEXTUREID_GENERIC);
 			if (object->subtype & MASK_IS_YELLOW)
-				object->mapping.mappings = gLevel->GetObjectMappings("data/Object/YellowSpring.map");
+				object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_YELLOWSPRING);
 			else
-				object->mapping.mappings = gLevel->GetObjectMappings("data/Object/RedSpring.map");
+				object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_REDSPRING);
 			
 			//Set render properties
 			object->renderFlags.alignPlane = true;
@@ -120,7 +120,7 @@ void ObjSpring(OBJECT *object)
 				//Get the player and check if we touched the spring
 				PLAYER *player = gLevel->playerList[i];
 				
-				if (object->playerContact[i].standing)
+				if (object->Cold()->playerContact[i].standing)
 				{
 					//Play bouncing animation
 					object->anim = 1;
@@ -342,7 +342,7 @@ void ObjSpring(OBJECT *object)
 				//Get the player and check if we touched the spring
 				PLAYER *player = gLevel->playerList[i];
 				
-				if (object->playerContact[i].standing)
+				if (object->Cold()->playerContact[i].standing)
 				{
 					//Make sure we're on the sloping / spring part
 					if (!object->status.xFlip)
@@ -501,6 +501,6 @@ void ObjSpring(OBJECT *object)
 	
 	//Draw and animate
 	object->Animate(animationList);
-	object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+	object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 	object->UnloadOffscreen(object->x.pos);
 }
@@ -0,0 +1,408 @@
+#include "Particle.h"
+#include "Level.h"
+#include "LevelCollision.h"
+#include "MathUtil.h"
+#include "Game.h"
+#include "Error.h"
+
+//#define BOUNCINGRING_BLINK              //When set, lost rings will blink shortly before despawning
+//#define BOUNCINGRING_ONLY_FLOOR	      //When set, like in the originals, lost rings will only check for floor collision
+
+#define BOUNCINGRING_COLLISIONSTEP 0x0 //0x0 - check every frame, 0x3 - Sonic 1 checking every 4 frames, 0x7 - Sonic 2 checking every 8 frames
+
+//Ring constants
+#define RING_RADIUS			8
+#define RING_TOUCH_WIDTH	6
+#define RING_TOUCH_HEIGHT	6
+
+//Animation tables
+static const PARTICLE_FRAME animationRingSparkle[] =	{{4, 6}, {5, 6}, {6, 6}, {7, 6}};
+static const PARTICLE_FRAME animationExplosion[] =		{{0, 4}, {1, 8}, {2, 8}, {3, 8}, {4, 8}};
+static const PARTICLE_FRAME animationSkidDust[] =		{{1, 4}, {2, 4}, {3, 4}, {4, 4}};
+
+//Particle type definitions
+static const PARTICLE_DEFINITION particleDefinition[PARTICLETYPE_MAX] = {
+	//texturePath,						mappingsPath,						priority,	gravity,	collision,	deleteOffscreen,	lifetime,	spin,	animation,				animationFrames,										collect
+	{"data/Object/Generic.bmp",			"data/Object/Ring.map",				3,			0x18,		true,		false,				255,		true,	nullptr,				0,														true},	//PARTICLETYPE_RING
+	{"data/Object/Generic.bmp",			"data/Object/Ring.map",				1,			0,			false,		false,				0,			false,	animationRingSparkle,	sizeof(animationRingSparkle) / sizeof(PARTICLE_FRAME),	false},	//PARTICLETYPE_RING_SPARKLE
+	{"data/Object/Generic.bmp",			"data/Object/Explosion.map",		1,			0,			false,		false,				0,			false,	animationExplosion,		sizeof(animationExplosion) / sizeof(PARTICLE_FRAME),	false},	//PARTICLETYPE_EXPLOSION
+	{"data/Object/PlayerGeneric.bmp",	"data/Object/SkidDust.map",			1,			0,			false,		false,				0,			false,	animationSkidDust,		sizeof(animationSkidDust) / sizeof(PARTICLE_FRAME),	false},	//PARTICLETYPE_SKIDDUST
+	{nullptr,							nullptr,							0,			0x70,		false,		true,				0,			false,	nullptr,				0,														false},	//PARTICLETYPE_FRAGMENT_SMASH
+	{nullptr,							nullptr,							0,			0x38,		false,		true,				0,			false,	nullptr,				0,														false},	//PARTICLETYPE_FRAGMENT_COLLAPSE
+};
+
+//Constructor
+PARTICLESYSTEM::PARTICLESYSTEM()
+{
+	//Load each type's graphics
+	for (int i = 0; i < PARTICLETYPE_MAX; i++)
+	{
+		if (particleDefinition[i].texturePath != nullptr)
+		{
+			typeTexture[i] = gLevel->GetObjectTexture(particleDefinition[i].texturePath);
+			if (typeTexture[i]->fail != nullptr)
+			{
+				Error(fail = typeTexture[i]->fail);
+				return;
+			}
+		}
+		
+		if (particleDefinition[i].mappingsPath != nullptr)
+		{
+			typeMappings[i] = gLevel->GetObjectMappings(particleDefinition[i].mappingsPath);
+			if (typeMappings[i]->fail != nullptr)
+			{
+				Error(fail = typeMappings[i]->fail);
+				return;
+			}
+		}
+	}
+}
+
+//Spawn functions
+int PARTICLESYSTEM::Spawn(PARTICLETYPE spawnType, int16_t xPos, int16_t yPos, int16_t spawnXVel, int16_t spawnYVel)
+{
+	//Don't spawn if we're full (particles are only visual, so these can just be dropped)
+	if (particles >= PARTICLES_MAX)
+		return -1;
+	
+	//Initialize our new particle
+	const PARTICLE_DEFINITION *definition = &particleDefinition[spawnType];
+	size_t i = particles++;
+	
+	type[i] = spawnType;
+	flags[i] = 0;
+	priority[i] = definition->priority;
+	
+	xLong[i] = (int32_t)xPos << 16;
+	yLong[i] = (int32_t)yPos << 16;
+	xVel[i] = spawnXVel;
+	yVel[i] = spawnYVel;
+	
+	delay[i] = 0;
+	life[i] = definition->lifetime;
+	spin[i] = 0;
+	animFrame[i] = 0;
+	animTimer[i] = (definition->animation != nullptr) ? definition->animation[0].duration : 0;
+	mappingFrame[i] = (definition->animation != nullptr) ? definition->animation[0].mappingFrame : 0;
+	
+	texture[i] = typeTexture[spawnType];
+	rect[i] = {0, 0, 0, 0};
+	return (int)i;
+}
+
+int PARTICLESYSTEM::SpawnFragment(PARTICLETYPE spawnType, TEXTURE *spawnTexture, RECT spawnRect, uint8_t spawnFlags, uint8_t spawnPriority, int16_t xPos, int16_t yPos, int16_t spawnXVel, int16_t spawnYVel, uint16_t spawnDelay)
+{
+	//Spawn a particle, then give it our given graphics
+	int i = Spawn(spawnType, xPos, yPos, spawnXVel, spawnYVel);
+	if (i < 0)
+		return i;
+	
+	flags[i] = spawnFlags;
+	priority[i] = spawnPriority;
+	delay[i] = spawnDelay;
+	texture[i] = spawnTexture;
+	rect[i] = spawnRect;
+	return i;
+}
+
+void PARTICLESYSTEM::ScatterRings(PLAYER *player, unsigned int rings)
+{
+	//Cap our rings
+	if (rings >= 32)
+		rings = 32;
+	
+	//Spawn the given amount of rings
+	union
+	{
+		#ifdef ENDIAN_BIG
+			struct
+			{
+				uint8_t speed;
+				uint8_t angle;
+			} asInd;
+		#else
+			struct
+			{
+				uint8_t angle;
+				uint8_t speed;
+			} asInd;
+		#endif
+		
+		int16_t angleSpeed = 0x288;
+	};
+	
+	int16_t ringXVel = 0, ringYVel = 0;
+	for (unsigned int v = 0; v < rings; v++)
+	{
+		//Get the ring's velocity
+		if (angleSpeed >= 0)
+		{
+			//Set our velocity
+			ringXVel = GetSin(asInd.angle) * (1 << asInd.speed);
+			ringYVel = GetCos(asInd.angle) * (1 << asInd.speed);
+			
+			//Get the next angle and speed
+			asInd.angle += 0x10;
+			
+			if (asInd.angle < 0x10)
+			{
+				angleSpeed -= 0x80;
+				if (angleSpeed < 0)
+					angleSpeed = 0x288;
+			}
+		}
+		
+		//Create the ring
+		int i = Spawn(PARTICLETYPE_RING, player->x.pos, player->y.pos, ringXVel, ringYVel);
+		if (i >= 0 && player->status.reverseGravity)
+			flags[i] |= PARTICLEFLAG_REVERSEGRAVITY;
+		
+		ringXVel = -ringXVel;
+		angleSpeed = -angleSpeed;
+	}
+}
+
+//Interaction functions
+void PARTICLESYSTEM::Touch(PLAYER *player, int16_t playerLeft, int16_t playerTop, int16_t playerWidth, int16_t playerHeight)
+{
+	//Don't collect rings if we were just hit
+	if (player->invulnerabilityTime >= 90)
+		return;
+	
+	//Check all collectable particles
+	for (size_t i = 0; i < particles; i++)
+	{
+		if (!particleDefinition[type[i]].collect)
+			continue;
+		
+		//Check if our hitboxes are colliding
+		int16_t horizontalCheck = playerLeft - ((int16_t)(xLong[i] >> 16) - RING_TOUCH_WIDTH);
+		int16_t verticalCheck = playerTop - ((int16_t)(yLong[i] >> 16) - RING_TOUCH_HEIGHT);
+		
+		if (horizontalCheck >= -playerWidth && horizontalCheck <= RING_TOUCH_WIDTH * 2 && verticalCheck >= -playerHeight && verticalCheck <= RING_TOUCH_HEIGHT * 2)
+		{
+			//Collect the ring and turn into a sparkle
+			AddToRings(1);
+			
+			type[i] = PARTICLETYPE_RING_SPARKLE;
+			priority[i] = particleDefinition[PARTICLETYPE_RING_SPARKLE].priority;
+			xVel[i] = 0;
+			yVel[i] = 0;
+			life[i] = 0;
+			animFrame[i] = 0;
+			animTimer[i] = animationRingSparkle[0].duration;
+			mappingFrame[i] = animationRingSparkle[0].mappingFrame;
+		}
+	}
+}
+
+//Update and draw functions
+void PARTICLESYSTEM::Delete(size_t i)
+{
+	//Move our last particle into this slot
+	size_t last = --particles;
+	if (i == last)
+		return;
+	
+	type[i] = type[last];
+	flags[i] = flags[last];
+	priority[i] = priority[last];
+	xLong[i] = xLong[last];
+	yLong[i] = yLong[last];
+	xVel[i] = xVel[last];
+	yVel[i] = yVel[last];
+	delay[i] = delay[last];
+	life[i] = life[last];
+	spin[i] = spin[last];
+	animFrame[i] = animFrame[last];
+	animTimer[i] = animTimer[last];
+	mappingFrame[i] = mappingFrame[last];
+	texture[i] = texture[last];
+	rect[i] = rect[last];
+}
+
+void PARTICLESYSTEM::Update()
+{
+	//Get the range particles are deleted outside of
+	int left = gLevel->camera->xPos;
+	int top = gLevel->camera->yPos;
+	int right = left + gRenderSpec.width;
+	int bottom = top + gRenderSpec.height;
+	
+	for (size_t i = 0; i < particles;)
+	{
+		const PARTICLE_DEFINITION *definition = &particleDefinition[type[i]];
+		
+		//Wait for our delay before moving
+		if (delay[i] != 0)
+		{
+			delay[i]--;
+			i++;
+			continue;
+		}
+		
+		//Move and fall
+		xLong[i] += xVel[i] << 8;
+		if (flags[i] & PARTICLEFLAG_REVERSEGRAVITY)
+			yLong[i] -= yVel[i] << 8;
+		else
+			yLong[i] += yVel[i] << 8;
+		yVel[i] += definition->gravity;
+		
+		int16_t xPos = xLong[i] >> 16;
+		int16_t yPos = yLong[i] >> 16;
+		
+		//Bounce off of the level
+		if (definition->collision && ((gLevel->frameCounter + i) & BOUNCINGRING_COLLISIONSTEP) == 0)
+		{
+			//Check for collision with the floor or ceiling
+			int16_t checkVel = yVel[i];
+			if (flags[i] & PARTICLEFLAG_REVERSEGRAVITY)
+				checkVel = -checkVel;
+			
+			if (checkVel >= 0)
+			{
+				int16_t distance = GetCollisionV(xPos, yPos + RING_RADIUS, COLLISIONLAYER_NORMAL_TOP, false, nullptr);
+				
+				//If touching the floor, bounce off
+				if (distance < 0)
+				{
+					yLong[i] += (int32_t)distance * 0x10000;
+					yVel[i] = yVel[i] * 3 / -4;
+				}
+			}
+		#ifndef BOUNCINGRING_ONLY_FLOOR
+			else
+			{
+				int16_t distance = GetCollisionV(xPos, yPos - RING_RADIUS, COLLISIONLAYER_NORMAL_LRB, true, nullptr);
+				
+				//If touching a ceiling, bounce off
+				if (distance < 0)
+				{
+					yLong[i] -= (int32_t)distance * 0x10000;
+					yVel[i] = -yVel[i];
+				}
+			}
+			
+			//Check for collision with walls
+			if (xVel[i] > 0)
+			{
+				int16_t distance = GetCollisionH(xPos + RING_RADIUS, yPos, COLLISIONLAYER_NORMAL_LRB, false, nullptr);
+				
+				//If touching a wall, bounce off
+				if (distance < 0)
+				{
+					xLong[i] += (int32_t)distance * 0x10000;
+					xVel[i] = xVel[i] / -2;
+				}
+			}
+			else if (xVel[i] < 0)
+			{
+				int16_t distance = GetCollisionH(xPos - RING_RADIUS, yPos, COLLISIONLAYER_NORMAL_LRB, true, nullptr);
+				
+				//If touching a wall, bounce off
+				if (distance < 0)
+				{
+					xLong[i] -= (int32_t)distance * 0x10000;
+					xVel[i] = xVel[i] / -2;
+				}
+			}
+		#endif
+		}
+		
+		//Spin down over our lifetime
+		if (definition->spin && life[i] != 0)
+		{
+			spin[i] += life[i];
+			mappingFrame[i] = (spin[i] >> 9) & 0x3;
+		}
+		
+		//Count down our lifetime, and delete once it's over
+		if (definition->lifetime != 0 && --life[i] == 0)
+		{
+			Delete(i);
+			continue;
+		}
+		
+		//Animate, and delete once our animation's finished
+		if (definition->animation != nullptr && --animTimer[i] == 0)
+		{
+			if (++animFrame[i] >= definition->animationFrames)
+			{
+				Delete(i);
+				continue;
+			}
+			
+			animTimer[i] = definition->animation[animFrame[i]].duration;
+			mappingFrame[i] = definition->animation[animFrame[i]].mappingFrame;
+		}
+		
+		//Delete once off-screen
+		if (definition->deleteOffscreen)
+		{
+			xPos = xLong[i] >> 16;
+			yPos = yLong[i] >> 16;
+			if (xPos + rect[i].w < left || xPos - rect[i].w >= right || yPos + rect[i].h < top || yPos - rect[i].h >= bottom)
+			{
+				Delete(i);
+				continue;
+			}
+		}
+		
+		i++;
+	}
+}
+
+void PARTICLESYSTEM::Draw()
+{
+	for (size_t i = 0; i < particles; i++)
+	{
+		//Don't draw if we don't have a texture
+		if (texture[i] == nullptr)
+			continue;
+	
+	#ifdef BOUNCINGRING_BLINK
+		//Blink lost rings shortly before despawning
+		if (type[i] == PARTICLETYPE_RING && life[i] <= 60 && !(gLevel->frameCounter & (life[i] > 30 ? 0x4 : 0x2)))
+			continue;
+	#endif
+		
+		//Get our rect and origin
+		RECT mapRect;
+		POINT mapOrig;
+		
+		MAPPINGS *mappings = typeMappings[type[i]];
+		if (mappings != nullptr)
+		{
+			//Reject if out of bounds
+			if (mappingFrame[i] >= mappings->size)
+				continue;
+			
+			//Pull rect and origin from mappings list using our mapping frame
+			mapRect = mappings->rect[mappingFrame[i]];
+			mapOrig = mappings->origin[mappingFrame[i]];
+		}
+		else
+		{
+			//Use our static rect, with the origin at its center
+			mapRect = rect[i];
+			mapOrig = {mapRect.w / 2, mapRect.h / 2};
+		}
+		
+		bool xFlip = (flags[i] & PARTICLEFLAG_XFLIP) != 0;
+		bool yFlip = (flags[i] & PARTICLEFLAG_YFLIP) != 0;
+		
+		int origX = mapOrig.x;
+		int origY = mapOrig.y;
+		if (xFlip)
+			origX = mapRect.w - origX;
+		if (yFlip)
+			origY = mapRect.h - origY;
+		
+		//Draw to screen at our position
+		int16_t xPos = xLong[i] >> 16;
+		int16_t yPos = yLong[i] >> 16;
+		gSoftwareBuffer->DrawTexture(texture[i], texture[i]->loadedPalette, &mapRect, gLevel->GetObjectLayer((flags[i] & PARTICLEFLAG_HIGHPRIORITY) != 0, priority[i]), xPos - origX - gLevel->camera->xPos, yPos - origY - gLevel->camera->yPos, xFlip, yFlip);
+	}
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Render.h"
+#include "Mappings.h"
+
+class PLAYER;
+
+//Particle constants
+#define PARTICLES_MAX	0x200
+
+//Particle types
+enum PARTICLETYPE
+{
+	PARTICLETYPE_RING,				//Ring lost by a player
+	PARTICLETYPE_RING_SPARKLE,		//Lost ring that's been collected
+	PARTICLETYPE_EXPLOSION,			//Explosion from a badnik or monitor
+	PARTICLETYPE_SKIDDUST,			//Dust from a player skidding
+	PARTICLETYPE_FRAGMENT_SMASH,	//Fragment of a smashed object (thrown with a velocity)
+	PARTICLETYPE_FRAGMENT_COLLAPSE,	//Fragment of a collapsing object (falls after a delay)
+	PARTICLETYPE_MAX,
+};
+
+//Particle flags
+#define PARTICLEFLAG_XFLIP				0x01
+#define PARTICLEFLAG_YFLIP				0x02
+#define PARTICLEFLAG_HIGHPRIORITY		0x04
+#define PARTICLEFLAG_REVERSEGRAVITY		0x08
+
+//Particle animation frame
+struct PARTICLE_FRAME
+{
+	uint8_t mappingFrame;
+	uint8_t duration;
+};
+
+//Particle type definition
+struct PARTICLE_DEFINITION
+{
+	//Graphics (if no mappings are given, particles use their own static rect)
+	const char *texturePath;
+	const char *mappingsPath;
+	uint8_t priority;
+	
+	//Physics
+	int16_t gravity;
+	bool collision;			//Bounce off of the level's floors, ceilings, and walls
+	bool deleteOffscreen;	//Delete once moved off-screen
+	
+	//Lifetime and animation (deleted once either runs out)
+	uint16_t lifetime;		//0 for no lifetime
+	bool spin;				//Spins down over our lifetime (lost rings)
+	const PARTICLE_FRAME *animation;
+	size_t animationFrames;
+	
+	//Interaction
+	bool collect;			//Collected as a ring when touched by a player
+};
+
+//Particle system class (particles are stored as a structure of arrays, and updated and drawn in batches)
+class PARTICLESYSTEM
+{
+	public:
+		//Failure
+		const char *fail = nullptr;
+		
+		//Type graphics
+		TEXTURE *typeTexture[PARTICLETYPE_MAX] = {nullptr};
+		MAPPINGS *typeMappings[PARTICLETYPE_MAX] = {nullptr};
+		
+		//Particles
+		size_t particles = 0;
+		
+		uint8_t type[PARTICLES_MAX];
+		uint8_t flags[PARTICLES_MAX];
+		uint8_t priority[PARTICLES_MAX];
+		
+		int32_t xLong[PARTICLES_MAX];
+		int32_t yLong[PARTICLES_MAX];
+		int16_t xVel[PARTICLES_MAX];
+		int16_t yVel[PARTICLES_MAX];
+		
+		uint16_t delay[PARTICLES_MAX];
+		uint16_t life[PARTICLES_MAX];
+		uint16_t spin[PARTICLES_MAX];
+		uint8_t animFrame[PARTICLES_MAX];
+		uint8_t animTimer[PARTICLES_MAX];
+		uint16_t mappingFrame[PARTICLES_MAX];
+		
+		TEXTURE *texture[PARTICLES_MAX];
+		RECT rect[PARTICLES_MAX];
+	
+	public:
+		PARTICLESYSTEM();
+		
+		//Spawn functions
+		int Spawn(PARTICLETYPE spawnType, int16_t xPos, int16_t yPos, int16_t spawnXVel = 0, int16_t spawnYVel = 0);
+		int SpawnFragment(PARTICLETYPE spawnType, TEXTURE *spawnTexture, RECT spawnRect, uint8_t spawnFlags, uint8_t spawnPriority, int16_t xPos, int16_t yPos, int16_t spawnXVel, int16_t spawnYVel, uint16_t spawnDelay);
+		void ScatterRings(PLAYER *player, unsigned int rings);
+		
+		//Interaction functions
+		void Touch(PLAYER *player, int16_t playerLeft, int16_t playerTop, int16_t playerWidth, int16_t playerHeight);
+		
+		//Update and draw functions
+		void Delete(size_t i);
+		void Update();
+		void Draw();
+};
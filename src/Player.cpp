@@ -288,8 +288,8 @@ void ObjSpindashDust(OBJECT *object)
 			{
 				case 1: //Spindashing
 					//Load graphics
-					object->texture = gLevel->GetObjectTexture("data/Object/PlayerGeneric.bmp");
-					object->mapping.mappings = gLevel->GetObjectMappings("data/Object/SpindashDust.map");
+					object->texture = gLevel->GetObjectTexture(TEXTUREID_PLAYERGENERIC);
+					object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_SPINDASHDUST);
 					
 					//Is the player still spindashing?
 					if (object->parentPlayer->routine != PLAYERROUTINE_CONTROL || object->parentPlayer->forceRollOrSpindash == false)
@@ -300,8 +300,8 @@ void ObjSpindashDust(OBJECT *object)
 					break;
 				case 2: //Dropdash dust
 					//Load graphics
-					object->texture = gLevel->GetObjectTexture("data/Object/PlayerGeneric.bmp");
-					object->mapping.mappings = gLevel->GetObjectMappings("data/Object/DropdashDust.map");
+					object->texture = gLevel->GetObjectTexture(TEXTUREID_PLAYERGENERIC);
+					object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_DROPDASHDUST);
 					break;
 			}
 			
@@ -332,34 +332,17 @@ void ObjSpindashDust(OBJECT *object)
 	
 	//Draw and animate
 	object->Animate(animationListSpindashDust);
-	object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+	object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 }
 
 //Skid dust
-static const uint8_t animationSkidDustNull[] =	{0x1F,0x00,0xFF};
-static const uint8_t animationSkidDust[] =		{0x03,0x01,0x02,0x03,0x04,0xFC};
-
-static const uint8_t* animationListSkidDust[] = {
-	animationSkidDustNull,
-	animationSkidDustNull,
-	animationSkidDust,
-};
-
 void ObjSkidDust(OBJECT *object)
 {
 	switch (object->routine)
 	{
 		case 0:
-			//Initialize render properties
-			object->texture = gLevel->GetObjectTexture("data/Object/PlayerGeneric.bmp");
-			object->mapping.mappings = gLevel->GetObjectMappings("data/Object/SkidDust.map");
-			
-			object->priority = 1;
-			object->widthPixels = 4;
-			object->renderFlags.alignPlane = true;
-			
-			//Set our routine 
-			object->routine = (object->anim == 2) ? 2 : 1;
+			//Set our routine (the dust itself is spawned as particles)
+			object->routine = 1;
 			break;
 		case 1: //Dust controller
 			//Don't run if there's no parent
@@ -382,13 +365,10 @@ void ObjSkidDust(OBJECT *object)
 					//Reset timer
 					object->animFrameDuration = 3;
 					
-					//Create a new dust object at the player's feet
-					OBJECT *dust = new OBJECT(&ObjSkidDust);
-					dust->x.pos = object->parentPlayer->x.pos;
-					dust->y.pos = object->parentPlayer->y.pos + (object->parentPlayer->status.reverseGravity ? -16 : 16);
-					dust->highPriority = object->parentPlayer->highPriority;
-					dust->anim = 2;
-					gLevel->objectList.link_back(dust);
+					//Create a new dust particle at the player's feet
+					int dust = gLevel->particleSystem->Spawn(PARTICLETYPE_SKIDDUST, object->parentPlayer->x.pos, object->parentPlayer->y.pos + (object->parentPlayer->status.reverseGravity ? -16 : 16));
+					if (dust >= 0 && object->parentPlayer->highPriority)
+						gLevel->particleSystem->flags[dust] |= PARTICLEFLAG_HIGHPRIORITY;
 					
 					//Offset if our height is atypical (for a short character like Tails)
 					int heightDifference = 19 - object->parentPlayer->defaultYRadius;
@@ -400,13 +380,6 @@ void ObjSkidDust(OBJECT *object)
 				}
 			}
 			break;
-		case 2: //Dust instance
-			object->Animate(animationListSkidDust);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
-			break;
-		case 3: //Dust deleting
-			object->deleteFlag = true;
-			break;
 	}
 }
 
@@ -476,6 +449,8 @@ void ObjBarrier(OBJECT *object)
 	};
 	
 	SCRATCH *scratch = object->Scratch<SCRATCH>();
+	if (scratch == nullptr)
+		return;
 	
 	//Check if we have a parent player
 	if (object->parentPlayer == nullptr)
@@ -495,8 +470,8 @@ void ObjBarrier(OBJECT *object)
 		}
 		
 		//Load mappings and textures
-		object->texture = gLevel->GetObjectTexture("data/Object/PlayerGeneric.bmp");
-		object->mapping.mappings = gLevel->GetObjectMappings("data/Object/SuperStars.map");
+		object->texture = gLevel->GetObjectTexture(TEXTUREID_PLAYERGENERIC);
+		object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_SUPERSTARS);
 		
 		//Set our render properties
 		object->priority = 1;
@@ -529,7 +504,7 @@ void ObjBarrier(OBJECT *object)
 				object->y.pos = object->parentPlayer->y.pos;
 			}
 			
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 		}
 		else
 		{
@@ -550,7 +525,7 @@ void ObjBarrier(OBJECT *object)
 				#endif
 				object->x.pos = object->parentPlayer->x.pos;
 				object->y.pos = object->parentPlayer->y.pos;
-				object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+				object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 			}
 		}
 	}
@@ -576,14 +551,14 @@ void ObjBarrier(OBJECT *object)
 		object->y.pos = object->parentPlayer->y.pos;
 		
 		//Do barrier specific code (this includes getting our things)
-		const char *useMapping = nullptr;
+		MAPPINGSID useMapping = MAPPINGSID_MAX;
 		const uint8_t **useAniList = nullptr;
 		
 		switch (object->parentPlayer->barrier)
 		{
 			case BARRIER_BLUE:
 				//Use blue barrier mappings and animations
-				useMapping = "data/Object/BlueBarrier.map";
+				useMapping = MAPPINGSID_BLUEBARRIER;
 				useAniList = animationListBlueBarrier;
 				
 				//Set our render properties
@@ -594,7 +569,7 @@ void ObjBarrier(OBJECT *object)
 				break;
 			case BARRIER_FLAME:
 				//Use flame barrier mappings and animations
-				useMapping = "data/Object/FlameBarrier.map";
+				useMapping = MAPPINGSID_FLAMEBARRIER;
 				useAniList = animationListFlameBarrier;
 				
 				//Set our render properties
@@ -619,7 +594,7 @@ void ObjBarrier(OBJECT *object)
 				break;
 			case BARRIER_LIGHTNING:
 				//Use lightning barrier mappings and animations
-				useMapping = "data/Object/LightningBarrier.map";
+				useMapping = MAPPINGSID_LIGHTNINGBARRIER;
 				useAniList = animationListLightningBarrier;
 				
 				//Set our render properties
@@ -645,7 +620,7 @@ void ObjBarrier(OBJECT *object)
 				break;
 			case BARRIER_AQUA:
 				//Use aqua barrier mappings and animations
-				useMapping = "data/Object/AquaBarrier.map";
+				useMapping = MAPPINGSID_AQUABARRIER;
 				useAniList = animationListAquaBarrier;
 				
 				//Set our render properties
@@ -656,7 +631,7 @@ void ObjBarrier(OBJECT *object)
 				break;
 			default: //Double spin attack
 				//Use spin attack mappings and animations
-				useMapping = "data/Object/DoubleSpinAttack.map";
+				useMapping = MAPPINGSID_DOUBLESPINATTACK;
 				useAniList = animationListSpinAttack;
 				
 				//Set our render properties
@@ -681,8 +656,8 @@ void ObjBarrier(OBJECT *object)
 		}
 		
 		//Load the given mappings and textures
-		object->texture = gLevel->GetObjectTexture("data/Object/PlayerGeneric.bmp");
-		object->mapping.mappings = gLevel->GetObjectMappings(useMapping);
+		object->texture = gLevel->GetObjectTexture(TEXTUREID_PLAYERGENERIC);
+		object->Cold()->mapping.mappings = gLevel->GetObjectMappings(useMapping);
 		
 		//Animate
 		object->Animate(useAniList);
@@ -709,7 +684,7 @@ void ObjBarrier(OBJECT *object)
 		}
 		
 		//Draw to screen
-		object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
+		object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, object->mappingFrame, object->x.pos, object->y.pos);
 	}
 	else
 	{
@@ -757,6 +732,8 @@ void ObjInvincibilityStars(OBJECT *object)
 	};
 	
 	SCRATCH *scratch = object->Scratch<SCRATCH>();
+	if (scratch == nullptr)
+		return;
 	
 	//Get our parent player
 	if (object->parentPlayer == nullptr || object->routineSecondary == 0)
@@ -766,8 +743,8 @@ void ObjInvincibilityStars(OBJECT *object)
 	if (object->routine == 0)
 	{
 		//Load mappings and textures
-		object->texture = gLevel->GetObjectTexture("data/Object/PlayerGeneric.bmp");
-		object->mapping.mappings = gLevel->GetObjectMappings("data/Object/InvincibilityStars.map");
+		object->texture = gLevel->GetObjectTexture(TEXTUREID_PLAYERGENERIC);
+		object->Cold()->mapping.mappings = gLevel->GetObjectMappings(MAPPINGSID_INVINCIBILITYSTARS);
 		
 		//Set our render properties
 		object->priority = 1;
@@ -805,12 +782,12 @@ void ObjInvincibilityStars(OBJECT *object)
 			//Draw star 1
 			int16_t star1XPos, star1YPos;
 			ObjInvincibilityStars_GetPosition(invincibilityStarPosArray, scratch->angle, xPos, yPos, &star1XPos, &star1YPos);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, frame, star1XPos, star1YPos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, frame, star1XPos, star1YPos);
 			
 			//Draw star 2
 			int16_t star2XPos, star2YPos;
 			ObjInvincibilityStars_GetPosition(invincibilityStarPosArray, scratch->angle + 0x12, xPos, yPos, &star2XPos, &star2YPos);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, frame, star2XPos, star2YPos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, frame, star2XPos, star2YPos);
 			
 			//Spin around the player
 			if (object->parentPlayer->status.xFlip)
@@ -845,12 +822,12 @@ void ObjInvincibilityStars(OBJECT *object)
 			//Draw star 1
 			int16_t star1XPos, star1YPos;
 			ObjInvincibilityStars_GetPosition(invincibilityStarPosArray, scratch->angle, xPos, yPos, &star1XPos, &star1YPos);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, frame2, star1XPos, star1YPos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, frame2, star1XPos, star1YPos);
 			
 			//Draw star 2
 			int16_t star2XPos, star2YPos;
 			ObjInvincibilityStars_GetPosition(invincibilityStarPosArray, scratch->angle + 0x12, xPos, yPos, &star2XPos, &star2YPos);
-			object->DrawInstance(object->renderFlags, object->texture, object->mapping, object->highPriority, object->priority, frame1, star2XPos, star2YPos);
+			object->DrawInstance(object->renderFlags, object->texture, object->Cold()->mapping, object->highPriority, object->priority, frame1, star2XPos, star2YPos);
 			
 			//Spin around the player
 			if (object->parentPlayer->status.xFlip)
@@ -933,20 +910,40 @@ PLAYER::PLAYER(std::string specPath, PLAYER *myFollow, size_t myController) : co
 	
 	//Load our objects
 	spindashDust = new OBJECT(&ObjSpindashDust);
+	if (spindashDust == nullptr)
+	{
+		fail = "Failed to allocate player objects in memory";
+		return;
+	}
 	spindashDust->parentPlayer = this;
 	gLevel->coreObjectList.link_back(spindashDust);
 	
 	skidDust = new OBJECT(&ObjSkidDust);
+	if (skidDust == nullptr)
+	{
+		fail = "Failed to allocate player objects in memory";
+		return;
+	}
 	skidDust->parentPlayer = this;
 	gLevel->coreObjectList.link_back(skidDust);
 	
 	barrierObject = new OBJECT(&ObjBarrier);
+	if (barrierObject == nullptr)
+	{
+		fail = "Failed to allocate player objects in memory";
+		return;
+	}
 	barrierObject->parentPlayer = this;
 	gLevel->coreObjectList.link_back(barrierObject);
 	
 	for (int i = 0; i < INVINCIBILITYSTARS; i++)
 	{
 		invincibilityStarObject[i] = new OBJECT(&ObjInvincibilityStars);
+		if (invincibilityStarObject[i] == nullptr)
+		{
+			fail = "Failed to allocate player objects in memory";
+			return;
+		}
 		invincibilityStarObject[i]->parentPlayer = this;
 		invincibilityStarObject[i]->subtype = i;
 		gLevel->coreObjectList.link_back(invincibilityStarObject[i]);
@@ -989,12 +986,17 @@ uint8_t PLAYER::GetCloserFloor_General(uint8_t angleSide, int16_t *distance, int
 }
 
 //2-point collision checks
-void PLAYER::CheckCollisionDown_2Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, int16_t *distance, int16_t *distance2, uint8_t *outAngle)
+void PLAYER::CheckCollision_2Point(COLLISIONSENSOR *sensor, uint8_t angleSide, int16_t *distance, int16_t *distance2, uint8_t *outAngle)
 {
-	int16_t retDistance = GetCollisionV(xPos + xRadius, yPos, layer, false, &floorAngle1);
-	int16_t retDistance2 = GetCollisionV(xPos - xRadius, yPos, layer, false, &floorAngle2);
-
-	uint8_t retAngle = GetCloserFloor_General(0x00, &retDistance, &retDistance2);
+	//Check both sensors together
+	GetCollisionSensors(sensor, 2);
+	floorAngle1 = sensor[0].angle;
+	floorAngle2 = sensor[1].angle;
+	
+	int16_t retDistance = sensor[0].distance;
+	int16_t retDistance2 = sensor[1].distance;
+	
+	uint8_t retAngle = GetCloserFloor_General(angleSide, &retDistance, &retDistance2);
 	if (distance != nullptr)
 		*distance = retDistance;
 	if (distance2 != nullptr)
@@ -1003,79 +1005,61 @@ void PLAYER::CheckCollisionDown_2Point(COLLISIONLAYER layer, int16_t xPos, int16
 		*outAngle = retAngle;
 }
 
-void PLAYER::CheckCollisionUp_2Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, int16_t *distance, int16_t *distance2, uint8_t *outAngle)
+void PLAYER::CheckCollisionDown_2Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, int16_t *distance, int16_t *distance2, uint8_t *outAngle)
 {
-	int16_t retDistance = GetCollisionV(xPos + xRadius, yPos, layer, true, &floorAngle1);
-	int16_t retDistance2 = GetCollisionV(xPos - xRadius, yPos, layer, true, &floorAngle2);
+	COLLISIONSENSOR sensor[2] = {
+		{(int16_t)(xPos + xRadius), yPos, layer, COLLISIONDIRECTION_DOWN, 0, floorAngle1},
+		{(int16_t)(xPos - xRadius), yPos, layer, COLLISIONDIRECTION_DOWN, 0, floorAngle2},
+	};
+	CheckCollision_2Point(sensor, 0x00, distance, distance2, outAngle);
+}
 
-	uint8_t retAngle = GetCloserFloor_General(0x80, &retDistance, &retDistance2);
-	if (distance != nullptr)
-		*distance = retDistance;
-	if (distance2 != nullptr)
-		*distance2 = retDistance2;
-	if (outAngle != nullptr)
-		*outAngle = retAngle;
+void PLAYER::CheckCollisionUp_2Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, int16_t *distance, int16_t *distance2, uint8_t *outAngle)
+{
+	COLLISIONSENSOR sensor[2] = {
+		{(int16_t)(xPos + xRadius), yPos, layer, COLLISIONDIRECTION_UP, 0, floorAngle1},
+		{(int16_t)(xPos - xRadius), yPos, layer, COLLISIONDIRECTION_UP, 0, floorAngle2},
+	};
+	CheckCollision_2Point(sensor, 0x80, distance, distance2, outAngle);
 }
 
 void PLAYER::CheckCollisionLeft_2Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, int16_t *distance, int16_t *distance2, uint8_t *outAngle)
 {
-	int16_t retDistance = GetCollisionH(xPos, yPos - xRadius, layer, true, &floorAngle1);
-	int16_t retDistance2 = GetCollisionH(xPos, yPos + xRadius, layer, true, &floorAngle2);
-
-	uint8_t retAngle = GetCloserFloor_General(0x40, &retDistance, &retDistance2);
-	if (distance != nullptr)
-		*distance = retDistance;
-	if (distance2 != nullptr)
-		*distance2 = retDistance2;
-	if (outAngle != nullptr)
-		*outAngle = retAngle;
+	COLLISIONSENSOR sensor[2] = {
+		{xPos, (int16_t)(yPos - xRadius), layer, COLLISIONDIRECTION_LEFT, 0, floorAngle1},
+		{xPos, (int16_t)(yPos + xRadius), layer, COLLISIONDIRECTION_LEFT, 0, floorAngle2},
+	};
+	CheckCollision_2Point(sensor, 0x40, distance, distance2, outAngle);
 }
 
 void PLAYER::CheckCollisionRight_2Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, int16_t *distance, int16_t *distance2, uint8_t *outAngle)
 {
-	int16_t retDistance = GetCollisionH(xPos, yPos - xRadius, layer, false, &floorAngle1);
-	int16_t retDistance2 = GetCollisionH(xPos, yPos + xRadius, layer, false, &floorAngle2);
-
-	uint8_t retAngle = GetCloserFloor_General(0xC0, &retDistance, &retDistance2);
-	if (distance != nullptr)
-		*distance = retDistance;
-	if (distance2 != nullptr)
-		*distance2 = retDistance2;
-	if (outAngle != nullptr)
-		*outAngle = retAngle;
+	COLLISIONSENSOR sensor[2] = {
+		{xPos, (int16_t)(yPos - xRadius), layer, COLLISIONDIRECTION_RIGHT, 0, floorAngle1},
+		{xPos, (int16_t)(yPos + xRadius), layer, COLLISIONDIRECTION_RIGHT, 0, floorAngle2},
+	};
+	CheckCollision_2Point(sensor, 0xC0, distance, distance2, outAngle);
 }
 
 //Get distance functions
 int16_t PLAYER::CheckCollisionDown_1Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, uint8_t *outAngle)
 {
-	int16_t distance = GetCollisionV(xPos, yPos, layer, false, outAngle);
-	if (outAngle != nullptr)
-		*outAngle = ((*outAngle) & 1) ? 0x00 : (*outAngle);
-	return distance;
+	return GetCollisionSensor(xPos, yPos, layer, COLLISIONDIRECTION_DOWN, outAngle);
 }
 
 int16_t PLAYER::CheckCollisionUp_1Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, uint8_t *outAngle)
 {
-	int16_t distance = GetCollisionV(xPos, yPos, layer, true, outAngle);
-	if (outAngle != nullptr)
-		*outAngle = ((*outAngle) & 1) ? 0x80 : (*outAngle);
-	return distance;
+	return GetCollisionSensor(xPos, yPos, layer, COLLISIONDIRECTION_UP, outAngle);
 }
 
 int16_t PLAYER::CheckCollisionLeft_1Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, uint8_t *outAngle)
 {
-	int16_t distance = GetCollisionH(xPos, yPos, layer, true, outAngle);
-	if (outAngle != nullptr)
-		*outAngle = ((*outAngle) & 1) ? 0x40 : (*outAngle);
-	return distance;
+	return GetCollisionSensor(xPos, yPos, layer, COLLISIONDIRECTION_LEFT, outAngle);
 }
 
 int16_t PLAYER::CheckCollisionRight_1Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, uint8_t *outAngle)
 {
-	int16_t distance = GetCollisionH(xPos, yPos, layer, false, outAngle);
-	if (outAngle != nullptr)
-		*outAngle = ((*outAngle) & 1) ? 0xC0 : (*outAngle);
-	return distance;
+	return GetCollisionSensor(xPos, yPos, layer, COLLISIONDIRECTION_RIGHT, outAngle);
 }
 
 //Calculate room perpendicular to the given angle (90 degrees clockwise)
@@ -1179,6 +1163,15 @@ int16_t PLAYER::GetCloserFloor_Ground(int16_t distance, int16_t distance2)
 	return outDistance;
 }
 
+int16_t PLAYER::GetCloserFloor_Sensors(COLLISIONSENSOR *sensor)
+{
+	//Check both of our sensors along the surface we're on together, and get the closer one
+	GetCollisionSensors(sensor, 2);
+	floorAngle1 = sensor[0].angle;
+	floorAngle2 = sensor[1].angle;
+	return GetCloserFloor_Ground(sensor[0].distance, sensor[1].distance);
+}
+
 void PLAYER::GroundFloorCollision()
 {
 	//Invert angle if gravity is reversed
@@ -1218,9 +1211,11 @@ void PLAYER::GroundFloorCollision()
 		{
 			case 0x00: //Floor
 			{
-				int16_t distance = GetCollisionV(x.pos + xRadius, y.pos + yRadius, topSolidLayer, false, &floorAngle1);
-				int16_t distance2 = GetCollisionV(x.pos - xRadius, y.pos + yRadius, topSolidLayer, false, &floorAngle2);
-				int16_t nearestDifference = GetCloserFloor_Ground(distance, distance2);
+				COLLISIONSENSOR sensor[2] = {
+					{(int16_t)(x.pos + xRadius), (int16_t)(y.pos + yRadius), topSolidLayer, COLLISIONDIRECTION_DOWN, 0, floorAngle1},
+					{(int16_t)(x.pos - xRadius), (int16_t)(y.pos + yRadius), topSolidLayer, COLLISIONDIRECTION_DOWN, 0, floorAngle2},
+				};
+				int16_t nearestDifference = GetCloserFloor_Sensors(sensor);
 				
 				if (nearestDifference < 0)
 				{
@@ -1253,9 +1248,11 @@ void PLAYER::GroundFloorCollision()
 			
 			case 0x40: //Wall to the left of us
 			{
-				int16_t distance = GetCollisionH(x.pos - yRadius, y.pos - xRadius, topSolidLayer, true, &floorAngle1);
-				int16_t distance2 = GetCollisionH(x.pos - yRadius, y.pos + xRadius, topSolidLayer, true, &floorAngle2);
-				int16_t nearestDifference = GetCloserFloor_Ground(distance, distance2);
+				COLLISIONSENSOR sensor[2] = {
+					{(int16_t)(x.pos - yRadius), (int16_t)(y.pos - xRadius), topSolidLayer, COLLISIONDIRECTION_LEFT, 0, floorAngle1},
+					{(int16_t)(x.pos - yRadius), (int16_t)(y.pos + xRadius), topSolidLayer, COLLISIONDIRECTION_LEFT, 0, floorAngle2},
+				};
+				int16_t nearestDifference = GetCloserFloor_Sensors(sensor);
 				
 				if (nearestDifference < 0)
 				{
@@ -1288,9 +1285,11 @@ void PLAYER::GroundFloorCollision()
 			
 			case 0x80: //Ceiling
 			{
-				int16_t distance = GetCollisionV(x.pos + xRadius, y.pos - yRadius, topSolidLayer, true, &floorAngle1);
-				int16_t distance2 = GetCollisionV(x.pos - xRadius, y.pos - yRadius, topSolidLayer, true, &floorAngle2);
-				int16_t nearestDifference = GetCloserFloor_Ground(distance, distance2);
+				COLLISIONSENSOR sensor[2] = {
+					{(int16_t)(x.pos + xRadius), (int16_t)(y.pos - yRadius), topSolidLayer, COLLISIONDIRECTION_UP, 0, floorAngle1},
+					{(int16_t)(x.pos - xRadius), (int16_t)(y.pos - yRadius), topSolidLayer, COLLISIONDIRECTION_UP, 0, floorAngle2},
+				};
+				int16_t nearestDifference = GetCloserFloor_Sensors(sensor);
 				
 				if (nearestDifference < 0)
 				{
@@ -1323,9 +1322,11 @@ void PLAYER::GroundFloorCollision()
 			
 			case 0xC0: //Wall to the right of us
 			{
-				int16_t distance = GetCollisionH(x.pos + yRadius, y.pos - xRadius, topSolidLayer, false, &floorAngle1);
-				int16_t distance2 = GetCollisionH(x.pos + yRadius, y.pos + xRadius, topSolidLayer, false, &floorAngle2);
-				int16_t nearestDifference = GetCloserFloor_Ground(distance, distance2);
+				COLLISIONSENSOR sensor[2] = {
+					{(int16_t)(x.pos + yRadius), (int16_t)(y.pos - xRadius), topSolidLayer, COLLISIONDIRECTION_RIGHT, 0, floorAngle1},
+					{(int16_t)(x.pos + yRadius), (int16_t)(y.pos + xRadius), topSolidLayer, COLLISIONDIRECTION_RIGHT, 0, floorAngle2},
+				};
+				int16_t nearestDifference = GetCloserFloor_Sensors(sensor);
 				
 				if (nearestDifference < 0)
 				{
@@ -3528,11 +3529,9 @@ bool PLAYER::Hurt(OBJECT *hit)
 		else
 		{
 			//Lose rings
-			OBJECT *ringObject = new OBJECT(&ObjBouncingRing_Spawner);
-			ringObject->x.pos = x.pos;
-			ringObject->y.pos = y.pos;
-			ringObject->parentPlayer = this;
-			gLevel->objectList.link_back(ringObject);
+			gLevel->particleSystem->ScatterRings(this, *rings);
+			PlaySound(SOUNDID_RING_LOSS);
+			*rings = 0;
 		}
 	}
 	
@@ -3565,7 +3564,7 @@ bool PLAYER::HurtFromObject(OBJECT *hit)
 	if (barrier != BARRIER_NULL || item.isInvincible)
 	{
 		//If we're immune to the object, don't hurt us
-		if ((item.immuneFlame && hit->hurtType.flame) || (item.immuneLightning && hit->hurtType.lightning) || (item.immuneAqua && hit->hurtType.aqua))
+		if ((item.immuneFlame && hit->Cold()->hurtType.flame) || (item.immuneLightning && hit->Cold()->hurtType.lightning) || (item.immuneAqua && hit->Cold()->hurtType.aqua))
 			return true;
 	}
 	
@@ -3577,7 +3576,7 @@ bool PLAYER::HurtFromObject(OBJECT *hit)
 #endif
 	{
 		//If we should be reflected, reflect
-		if (hit->hurtType.reflect)
+		if (hit->Cold()->hurtType.reflect)
 		{
 			//Get the velocity to reflect at (bounce directly away from player using atan2)
 			uint8_t angle = GetAtan(x.pos - hit->x.pos, y.pos - hit->y.pos);
@@ -3672,7 +3671,7 @@ static const uint8_t sonicPalette[16][4][3] = {
 
 void PLAYER::SuperPaletteCycle()
 {
-	TEXTURE *plGenTexture = gLevel->GetObjectTexture("data/Object/PlayerGeneric.bmp");
+	TEXTURE *plGenTexture = gLevel->GetObjectTexture(TEXTUREID_PLAYERGENERIC);
 	
 	switch (paletteState)
 	{
@@ -4834,8 +4833,6 @@ void PLAYER::DebugMode()
 }
 
 //Ring attraction check
-#define RING_ATTRACT_RADIUS 64
-
 void PLAYER::RingAttractCheck(OBJECT *object)
 {
 	//Check object
@@ -4853,10 +4850,6 @@ void PLAYER::RingAttractCheck(OBJECT *object)
 			object->parent = (void*)this;
 		}
 	}
-	
-	//Iterate and check children
-	for (size_t i = 0; i < object->children.size(); i++)
-		RingAttractCheck(object->children[i]);
 }
 
 //Object interaction functions
@@ -4944,13 +4937,6 @@ bool PLAYER::ObjectTouch(OBJECT *object, int16_t playerLeft, int16_t playerTop,
 		}
 	}
 	
-	//Iterate through children, we haven't hit the parent
-	for (size_t i = 0; i < object->children.size(); i++)
-	{
-		if (ObjectTouch(object->children[i], playerLeft, playerTop, playerWidth, playerHeight))
-			return true;
-	}
-	
 	return false;
 }
 
@@ -4958,8 +4944,11 @@ void PLAYER::CheckObjectTouch()
 {
 	//Check for ring attraction
 	if (barrier == BARRIER_LIGHTNING)
+	{
+		gLevel->ringManager->Attract(this);
 		for (size_t i = 0; i < gLevel->objectList.size(); i++)
 			RingAttractCheck(gLevel->objectList[i]);
+	}
 	
 	//Get our collision hitbox
 	bool wasInvincible = item.isInvincible; //Remember if we were invincible, since this gets temporarily overwritten by the double spin attack
@@ -5001,6 +4990,10 @@ void PLAYER::CheckObjectTouch()
 		#endif
 	}
 	
+	//Check for collision with the level's rings and lost rings
+	gLevel->ringManager->Touch(this, playerLeft, playerTop, playerWidth, playerHeight);
+	gLevel->particleSystem->Touch(this, playerLeft, playerTop, playerWidth, playerHeight);
+	
 	//Iterate through every object
 	for (size_t i = 0; i < gLevel->objectList.size(); i++)
 	{
@@ -339,6 +339,7 @@ class PLAYER
 		void SetSpeedFromDefinition(SPEEDDEFINITION definition);
 		
 		uint8_t GetCloserFloor_General(uint8_t angleSide, int16_t *distance, int16_t *distance2);
+		void CheckCollision_2Point(COLLISIONSENSOR *sensor, uint8_t angleSide, int16_t *distance, int16_t *distance2, uint8_t *outAngle);
 		void CheckCollisionDown_2Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, int16_t *distance, int16_t *distance2, uint8_t *outAngle);
 		void CheckCollisionUp_2Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, int16_t *distance, int16_t *distance2, uint8_t *outAngle);
 		void CheckCollisionLeft_2Point(COLLISIONLAYER layer, int16_t xPos, int16_t yPos, int16_t *distance, int16_t *distance2, uint8_t *outAngle);
@@ -353,6 +354,7 @@ class PLAYER
 		int16_t GetWallDistance(uint8_t inAngle);
 		
 		int16_t GetCloserFloor_Ground(int16_t distance, int16_t distance2);
+		int16_t GetCloserFloor_Sensors(COLLISIONSENSOR *sensor);
 		void GroundFloorCollision();
 		void GroundWallCollision();
 		
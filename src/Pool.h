@@ -0,0 +1,282 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <new>
+
+#include "Array.h"
+#ifdef DEBUG
+	#include <thread>
+	#include "Error.h"
+#endif
+
+//Pools aren't thread-safe, so each is only ever used from one thread (debug builds check this, rather than racing silently)
+#ifdef DEBUG
+	struct POOLOWNER
+	{
+		//Thread we're used from (the first to allocate from us)
+		std::thread::id owner;
+		
+		inline void Check()
+		{
+			if (owner == std::thread::id())
+				owner = std::this_thread::get_id();
+			else if (owner != std::this_thread::get_id())
+			{
+				Error("Pool used from a thread other than its own");
+				abort();
+			}
+		}
+	};
+#endif
+
+//Cache line size (what records are padded to, where they're laid out for the cache)
+#define POOL_CACHE_LINE 64
+
+//Fixed-size block pool, blocks are handed out from large chunks in allocation order and recycled through a free-list (most recently freed first)
+template <size_t BLOCK_SIZE, size_t BLOCKS_PER_CHUNK> class POOL
+{
+	private:
+		//Block and chunk structures
+		union BLOCK
+		{
+			BLOCK *next;
+			alignas(alignof(max_align_t)) uint8_t data[BLOCK_SIZE];
+		};
+		
+		struct CHUNK
+		{
+			CHUNK *next;
+			BLOCK block[BLOCKS_PER_CHUNK];
+		};
+		
+		//Chunk list and free-list
+		CHUNK *chunkList = nullptr;
+		BLOCK *freeList = nullptr;
+		size_t chunkUsed = BLOCKS_PER_CHUNK;	//Blocks handed out from the head chunk that have never been freed
+		
+		#ifdef DEBUG
+			POOLOWNER owner;
+		#endif
+	
+	public:
+		//Constructor and destructor
+		POOL() { return; }
+		~POOL()
+		{
+			//Free all of our chunks
+			while (chunkList != nullptr)
+			{
+				CHUNK *next = chunkList->next;
+				free(chunkList);
+				chunkList = next;
+			}
+		}
+		
+		//Allocation functions
+		inline void *Alloc()
+		{
+			#ifdef DEBUG
+				owner.Check();
+			#endif
+			
+			//Reuse a freed block if we have one
+			if (freeList != nullptr)
+			{
+				BLOCK *block = freeList;
+				freeList = block->next;
+				return block->data;
+			}
+			
+			//Allocate a new chunk if our head chunk is full
+			if (chunkUsed >= BLOCKS_PER_CHUNK)
+			{
+				CHUNK *newChunk = (CHUNK*)malloc(sizeof(CHUNK));
+				if (newChunk == nullptr)
+					return nullptr;
+				newChunk->next = chunkList;
+				chunkList = newChunk;
+				chunkUsed = 0;
+			}
+			
+			//Hand out the next block in the head chunk
+			return chunkList->block[chunkUsed++].data;
+		}
+		
+		inline void Free(void *ptr)
+		{
+			//Link the block to the front of the free-list
+			if (ptr == nullptr)
+				return;
+			#ifdef DEBUG
+				owner.Check();
+			#endif
+			BLOCK *block = (BLOCK*)ptr;
+			block->next = freeList;
+			freeList = block;
+		}
+};
+
+//Fixed-size pool of records split into a hot part and a cold part, kept in separate arrays in each chunk
+//Chunks are aligned to their size, so a hot part's chunk (and so its cold part) is found from its address alone, and records are handed out
+//lowest address first, so the hot parts of live records stay packed together at the start of the pool however they're freed
+template <size_t HOT_SIZE, typename COLD, size_t BLOCKS_PER_CHUNK> class SPLITPOOL
+{
+	private:
+		//Block and chunk structures
+		union HOTBLOCK
+		{
+			alignas(alignof(max_align_t)) uint8_t data[HOT_SIZE];
+		};
+		
+		union COLDBLOCK
+		{
+			alignas(POOL_CACHE_LINE) uint8_t data[sizeof(COLD)];	//Padded to whole cache lines, so the first fields of a cold part share a line
+		};
+		
+		static constexpr size_t MASK_WORDS = (BLOCKS_PER_CHUNK + 63) / 64;
+		
+		struct CHUNK
+		{
+			void *allocation;		//Our allocation (which we're aligned within)
+			void *coldAllocation;	//Our cold parts' allocation (which they're aligned within)
+			COLDBLOCK *cold;
+			size_t index;			//Our index in the chunk list
+			size_t freeBlocks;
+			uint64_t freeMask[MASK_WORDS];	//Set bits are free blocks
+			alignas(POOL_CACHE_LINE) HOTBLOCK hot[BLOCKS_PER_CHUNK];	//Starting on a cache line, so records the size of whole lines don't straddle an extra one
+		};
+		
+		static constexpr size_t ChunkAlign()
+		{
+			size_t align = 1;
+			while (align < sizeof(CHUNK))
+				align <<= 1;
+			return align;
+		}
+		
+		static inline CHUNK *ChunkOf(const void *hot) { return (CHUNK*)((uintptr_t)hot & ~(uintptr_t)(ChunkAlign() - 1)); }
+		static inline size_t SlotOf(CHUNK *chunk, const void *hot) { return (const HOTBLOCK*)hot - chunk->hot; }
+		
+		static inline size_t LowestBit(uint64_t value)
+		{
+			#ifdef __GNUC__
+				return __builtin_ctzll(value);
+			#else
+				size_t bit = 0;
+				while (!(value & 1))
+				{
+					value >>= 1;
+					bit++;
+				}
+				return bit;
+			#endif
+		}
+		
+		//Chunks, and the first one that may have free blocks
+		ARRAY<CHUNK*> chunks;
+		size_t firstFree = 0;
+		
+		#ifdef DEBUG
+			POOLOWNER owner;
+		#endif
+		
+		//Chunk allocation
+		CHUNK *NewChunk()
+		{
+			//Allocate our chunk aligned to its size, and our cold parts aligned to theirs
+			void *allocation = malloc(sizeof(CHUNK) + ChunkAlign() - 1);
+			if (allocation == nullptr)
+				return nullptr;
+			void *coldAllocation = malloc(sizeof(COLDBLOCK) * BLOCKS_PER_CHUNK + alignof(COLDBLOCK) - 1);
+			if (coldAllocation == nullptr)
+			{
+				free(allocation);
+				return nullptr;
+			}
+			
+			CHUNK *chunk = (CHUNK*)(((uintptr_t)allocation + ChunkAlign() - 1) & ~(uintptr_t)(ChunkAlign() - 1));
+			chunk->allocation = allocation;
+			chunk->coldAllocation = coldAllocation;
+			chunk->cold = (COLDBLOCK*)(((uintptr_t)coldAllocation + alignof(COLDBLOCK) - 1) & ~(uintptr_t)(alignof(COLDBLOCK) - 1));
+			chunk->index = chunks.size();
+			chunk->freeBlocks = BLOCKS_PER_CHUNK;
+			for (size_t i = 0; i < MASK_WORDS; i++)
+				chunk->freeMask[i] = (i + 1) * 64 <= BLOCKS_PER_CHUNK ? ~(uint64_t)0 : (((uint64_t)1 << (BLOCKS_PER_CHUNK % 64)) - 1);
+			
+			if (chunks.link_back(chunk) == nullptr)
+			{
+				free(coldAllocation);
+				free(allocation);
+				return nullptr;
+			}
+			return chunk;
+		}
+	
+	public:
+		//Constructor and destructor
+		SPLITPOOL() { return; }
+		~SPLITPOOL()
+		{
+			//Free all of our chunks
+			for (CHUNK *chunk : chunks)
+			{
+				free(chunk->coldAllocation);
+				free(chunk->allocation);
+			}
+		}
+		
+		//Record access
+		inline COLD *Cold(const void *hot)
+		{
+			CHUNK *chunk = ChunkOf(hot);
+			return (COLD*)chunk->cold[SlotOf(chunk, hot)].data;
+		}
+		
+		//Allocation functions (records' cold parts are constructed and destroyed here, their hot parts by whoever uses them)
+		void *Alloc()
+		{
+			#ifdef DEBUG
+				owner.Check();
+			#endif
+			
+			//Find the first chunk with a free block (allocating a new chunk if they're all full)
+			while (firstFree < chunks.size() && chunks[firstFree]->freeBlocks == 0)
+				firstFree++;
+			
+			CHUNK *chunk;
+			if (firstFree < chunks.size())
+				chunk = chunks[firstFree];
+			else if ((chunk = NewChunk()) == nullptr)
+				return nullptr;
+			
+			//Take its lowest free block
+			size_t word = 0;
+			while (chunk->freeMask[word] == 0)
+				word++;
+			size_t slot = word * 64 + LowestBit(chunk->freeMask[word]);
+			chunk->freeMask[word] &= ~((uint64_t)1 << (slot % 64));
+			chunk->freeBlocks--;
+			
+			new(chunk->cold[slot].data) COLD();
+			return chunk->hot[slot].data;
+		}
+		
+		void Free(void *hot)
+		{
+			//Mark the block as free (our lowest free chunk may now be this one)
+			if (hot == nullptr)
+				return;
+			#ifdef DEBUG
+				owner.Check();
+			#endif
+			
+			CHUNK *chunk = ChunkOf(hot);
+			size_t slot = SlotOf(chunk, hot);
+			((COLD*)chunk->cold[slot].data)->~COLD();
+			chunk->freeMask[slot / 64] |= (uint64_t)1 << (slot % 64);
+			chunk->freeBlocks++;
+			if (chunk->index < firstFree)
+				firstFree = chunk->index;
+		}
+};
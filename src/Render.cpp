@@ -112,54 +112,80 @@ TEXTURE::TEXTURE(std::string path)
 	if (bitmapCompression == BMPCMP_RGB && bitmapColours > 0)
 	{
 		//Read our palette
+		const uint8_t *paletteData = fp.ReadSpan(bitmapColours * 4);
+		if (paletteData == nullptr)
+		{
+			Error(fail = "Palette is truncated");
+			return;
+		}
+		
 		loadedPalette = new PALETTE(bitmapColours);
 		for (uint32_t i = 0; i < bitmapColours; i++)
 		{
-			//Read our colours
-			uint8_t r, g, b;
-			b = fp.ReadU8();	//Colours are read as BGR
-			g = fp.ReadU8();
-			r = fp.ReadU8();
-				fp.ReadU8();	//RESERVED - ???
+			//Read our colours (colours are read as BGR, followed by a reserved byte)
+			uint8_t b = paletteData[i * 4 + 0];
+			uint8_t g = paletteData[i * 4 + 1];
+			uint8_t r = paletteData[i * 4 + 2];
 			
 			//Copy to the loaded palette
 			loadedPalette->colour[i].SetColour(true, true, true, r, g, b);
 		}
 		
+		//Get the size of each line of pixel data
+		if (bitmapBPP != 1 && bitmapBPP != 4 && bitmapBPP != 8)
+		{
+			Error(fail = "Invalid bit depth");
+			return;
+		}
+		size_t lineSize = (width * bitmapBPP + 7) / 8;
+		
 		//Allocate and read texture data
 		texture = new uint8_t[width * height];
 		uint8_t *txPnt = texture + (bitmapIsTopDown ? 0 : (height - 1) * width);
 		
 		for (int y = 0; y < height; y++)
 		{
-			for (int x = 0; x < width;)
+			const uint8_t *line = fp.ReadSpan(lineSize);
+			if (line == nullptr)
+			{
+				Error(fail = "Pixel data is truncated");
+				return;
+			}
+			
+			//8-bit lines (which cooked textures are stored as) are copied as-is
+			if (bitmapBPP == 8)
+			{
+				memcpy(txPnt, line, width);
+				txPnt += width;
+			}
+			else
 			{
-				uint8_t src = fp.ReadU8();
-				switch (bitmapBPP)
+				//Unpack lower bit depths
+				for (int x = 0; x < width;)
 				{
-					case 1:
-						*txPnt++ = (src & 0x80) >> 7;
-						*txPnt++ = (src & 0x40) >> 6;
-						*txPnt++ = (src & 0x20) >> 5;
-						*txPnt++ = (src & 0x10) >> 4;
-						*txPnt++ = (src & 0x08) >> 3;
-						*txPnt++ = (src & 0x04) >> 2;
-						*txPnt++ = (src & 0x02) >> 1;
-						*txPnt++ = (src & 0x01) >> 0;
-						x += 8;
-						break;
-					case 4:
-						*txPnt++ = (src & 0xF0) >> 4;
-						*txPnt++ = (src & 0x0F) >> 0;
-						x += 2;
-						break;
-					case 8:
-						*txPnt++ = src;
-						x++;
-						break;
-					default:
-						Error(fail = "Invalid bit depth");
-						return;
+					uint8_t src = *line++;
+					switch (bitmapBPP)
+					{
+						case 1:
+							*txPnt++ = (src & 0x80) >> 7;
+							*txPnt++ = (src & 0x40) >> 6;
+							*txPnt++ = (src & 0x20) >> 5;
+							*txPnt++ = (src & 0x10) >> 4;
+							*txPnt++ = (src & 0x08) >> 3;
+							*txPnt++ = (src & 0x04) >> 2;
+							*txPnt++ = (src & 0x02) >> 1;
+							*txPnt++ = (src & 0x01) >> 0;
+							x += 8;
+							break;
+						case 4:
+							*txPnt++ = (src & 0xF0) >> 4;
+							*txPnt++ = (src & 0x0F) >> 0;
+							x += 2;
+							break;
+						default:
+							Error(fail = "Invalid bit depth");
+							return;
+					}
 				}
 			}
 			
@@ -206,7 +232,7 @@ void SOFTWAREBUFFER::DrawPoint(const int layer, const POINT *point, const COLOUR
 	newEntry.solid.colour = colour;
 	
 	//Link to queue
-	queue[layer].link_front(newEntry);
+	queue[layer].link_back(newEntry);
 }
 
 void SOFTWAREBUFFER::DrawQuad(const int layer, const RECT *quad, const COLOUR *colour)
@@ -247,7 +273,7 @@ void SOFTWAREBUFFER::DrawQuad(const int layer, const RECT *quad, const COLOUR *c
 	//Finish setting up entry and link to queue
 	newEntry.type = RENDERQUEUE_SOLID;
 	newEntry.solid.colour = colour;
-	queue[layer].link_front(newEntry);
+	queue[layer].link_back(newEntry);
 }
 
 void SOFTWAREBUFFER::DrawTexture(TEXTURE *texture, PALETTE *palette, const RECT *src, int layer, int x, int y, bool xFlip, bool yFlip)
@@ -308,7 +334,7 @@ void SOFTWAREBUFFER::DrawTexture(TEXTURE *texture, PALETTE *palette, const RECT
 	newEntry.texture.yFlip = yFlip;
 	
 	//Link to queue
-	queue[layer].link_front(newEntry);
+	queue[layer].link_back(newEntry);
 }
 
 //Primary render function
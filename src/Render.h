@@ -1,7 +1,7 @@
 #pragma once
 #include <string>
 #include <stdint.h>
-#include "LinkedList.h"
+#include "Array.h"
 
 //Rect and point structures
 struct RECT { int x, y, w, h; };
@@ -187,7 +187,7 @@ class SOFTWAREBUFFER
 		const char *fail = nullptr;
 		
 		//Render queue
-		LINKEDLIST<RENDERQUEUE> queue[RENDERLAYERS];
+		ARRAY<RENDERQUEUE> queue[RENDERLAYERS];
 		
 		//Dimensions of buffer
 		int width;
@@ -216,8 +216,8 @@ class SOFTWAREBUFFER
 			//Iterate through each layer
 			for (int i = RENDERLAYERS - 1; i >= 0; i--)
 			{
-				//Iterate through each entry
-				for (size_t v = 0; v < queue[i].size(); v++)
+				//Iterate through each entry (most recently queued first)
+				for (size_t v = queue[i].size(); v-- > 0;)
 				{
 					RENDERQUEUE entry = queue[i][v];
 					
@@ -0,0 +1,389 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "Rewind.h"
+#include "Error.h"
+#include "Log.h"
+
+//Delta compression
+//Snapshots are XORed against a base (their keyframe, zero-extended, or nothing for keyframes themselves), leaving mostly zeroes,
+//then stored as runs of [zero bytes][literal bytes], with each run's length as a 7-bit varint
+#define REWIND_MIN_ZERO_RUN	4	//Zero bytes in a row that end a literal run
+
+static inline uint8_t *WriteVarint(uint8_t *out, size_t value)
+{
+	while (value >= 0x80)
+	{
+		*out++ = (uint8_t)(value | 0x80);
+		value >>= 7;
+	}
+	*out++ = (uint8_t)value;
+	return out;
+}
+
+static inline const uint8_t *ReadVarint(const uint8_t *in, const uint8_t *end, size_t *value)
+{
+	*value = 0;
+	for (int shift = 0; in < end && shift < 64; shift += 7)
+	{
+		uint8_t byte = *in++;
+		*value |= (size_t)(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+			return in;
+	}
+	return nullptr;
+}
+
+static size_t EncodeDelta(const uint8_t *data, size_t size, const uint8_t *base, size_t baseSize, uint8_t *out)
+{
+	//Encode the given data against its base (out must fit at least size * 2 + 64 bytes), returns the encoded size
+	uint8_t *outStart = out;
+	size_t baseEnd = (baseSize < size) ? baseSize : size;
+	#define DELTA_AT(i) ((uint8_t)(data[i] ^ (((i) < baseEnd) ? base[i] : 0)))
+	
+	size_t i = 0;
+	while (i < size)
+	{
+		//Skip our unchanged bytes (a word at a time where the word doesn't straddle the end of the base)
+		size_t zeroStart = i;
+		while (i < size)
+		{
+			if (i + 8 <= size && (i + 8 <= baseEnd || i >= baseEnd))
+			{
+				uint64_t word, baseWord = 0;
+				memcpy(&word, data + i, 8);
+				if (i < baseEnd)
+					memcpy(&baseWord, base + i, 8);
+				if (word == baseWord)
+				{
+					i += 8;
+					continue;
+				}
+			}
+			
+			if (DELTA_AT(i) != 0)
+				break;
+			i++;
+		}
+		size_t zeros = i - zeroStart;
+		
+		//Take our changed bytes until the next run of unchanged bytes
+		size_t literalStart = i;
+		size_t zeroRun = 0;
+		while (i < size)
+		{
+			if (DELTA_AT(i) != 0)
+			{
+				zeroRun = 0;
+			}
+			else if (++zeroRun == REWIND_MIN_ZERO_RUN)
+			{
+				i -= REWIND_MIN_ZERO_RUN - 1;
+				break;
+			}
+			i++;
+		}
+		size_t literals = i - literalStart;
+		
+		//Write our runs
+		out = WriteVarint(out, zeros);
+		out = WriteVarint(out, literals);
+		for (size_t v = literalStart; v < literalStart + literals; v++)
+			*out++ = DELTA_AT(v);
+	}
+	
+	#undef DELTA_AT
+	return out - outStart;
+}
+
+static bool DecodeDelta(const uint8_t *in, size_t inSize, uint8_t *out, size_t size)
+{
+	//XOR the given encoded delta into out (which should hold its base), returns true if it's corrupt
+	const uint8_t *end = in + inSize;
+	size_t i = 0;
+	
+	while (in < end)
+	{
+		size_t zeros, literals;
+		if ((in = ReadVarint(in, end, &zeros)) == nullptr || (in = ReadVarint(in, end, &literals)) == nullptr)
+			return true;
+		if (zeros > size - i || literals > size - i - zeros || literals > (size_t)(end - in))
+			return true;
+		
+		i += zeros;
+		for (size_t v = 0; v < literals; v++)
+			out[i + v] ^= in[v];
+		i += literals;
+		in += literals;
+	}
+	return i != size;
+}
+
+//Constructor and destructor
+REWIND::REWIND()
+{
+	//Allocate our ring buffer up front (our memory use is fixed)
+	if (state.fail != nullptr)
+	{
+		fail = state.fail;
+		return;
+	}
+	
+	buffer = (uint8_t*)malloc(REWIND_BUDGET);
+	if (buffer == nullptr)
+		Error(fail = "Failed to allocate rewind buffer");
+}
+
+REWIND::~REWIND()
+{
+	//Free our buffers
+	free(buffer);
+	free(keyframe);
+	free(encode);
+}
+
+//Internal functions
+REWIND_FRAME *REWIND::FindFrame(uint64_t serial)
+{
+	//Find the frame with the given serial (searching from the newest, as we're only looking for our newest keyframes)
+	for (size_t i = frames; i-- > 0;)
+		if (GetFrame(i)->serial == serial)
+			return GetFrame(i);
+	return nullptr;
+}
+
+bool REWIND::Grow(uint8_t **data, size_t *capacity, size_t bytes)
+{
+	//Grow the given buffer to fit the given size
+	if (bytes <= *capacity)
+		return false;
+	
+	uint8_t *newData = (uint8_t*)realloc(*data, bytes);
+	if (newData == nullptr)
+	{
+		fail = "Failed to allocate rewind buffer";
+		return true;
+	}
+	
+	*data = newData;
+	*capacity = bytes;
+	return false;
+}
+
+bool REWIND::DecodeKeyframe(uint64_t serial)
+{
+	//Decompress the given keyframe, if it isn't already
+	if (keyframeSerial == serial)
+		return false;
+	
+	REWIND_FRAME *keyframeFrame = FindFrame(serial);
+	if (keyframeFrame == nullptr)
+	{
+		fail = "Rewind frame's keyframe has been dropped";
+		return true;
+	}
+	if (Grow(&keyframe, &keyframeCapacity, keyframeFrame->rawSize))
+		return true;
+	
+	keyframeSerial = 0;
+	memset(keyframe, 0, keyframeFrame->rawSize);
+	if (DecodeDelta(buffer + keyframeFrame->offset, keyframeFrame->bytes, keyframe, keyframeFrame->rawSize))
+	{
+		fail = "Rewind keyframe is corrupt";
+		return true;
+	}
+	
+	keyframeSize = keyframeFrame->rawSize;
+	keyframeSerial = serial;
+	return false;
+}
+
+void REWIND::DropOldest()
+{
+	//Drop our oldest keyframe, and the deltas against it
+	do
+	{
+		first = (first + 1) % REWIND_FRAMES;
+		frames--;
+	} while (frames != 0 && GetFrame(0)->serial != GetFrame(0)->keyframe);
+	
+	if (frames == 0)
+		writePos = 0;
+}
+
+bool REWIND::Alloc(size_t bytes, size_t *offset)
+{
+	//Make room for a new frame, dropping our oldest frames until it fits
+	if (bytes > REWIND_BUDGET)
+	{
+		fail = "Rewind frame is larger than the rewind budget";
+		return true;
+	}
+	
+	if (frames == REWIND_FRAMES)
+		DropOldest();
+	
+	while (frames != 0)
+	{
+		//If we haven't wrapped around behind our oldest frame, use the end of the buffer, otherwise wrap to the start
+		REWIND_FRAME *oldest = GetFrame(0);
+		if (writePos > oldest->offset)
+		{
+			if (writePos + bytes <= REWIND_BUDGET)
+				break;
+			writePos = 0;
+			continue;
+		}
+		
+		//We're behind our oldest frame, so only the space up to it is free
+		if (writePos + bytes <= oldest->offset)
+			break;
+		DropOldest();
+	}
+	
+	*offset = writePos;
+	writePos += bytes;
+	return false;
+}
+
+//Capture function
+bool REWIND::Capture()
+{
+	if (fail != nullptr)
+		return true;
+	
+	//Save the level's state
+	if (state.Save())
+	{
+		Error(fail = state.fail);
+		return true;
+	}
+	
+	size_t size = state.size;
+	if (Grow(&encode, &encodeCapacity, size * 2 + 64))
+	{
+		Error(fail);
+		return true;
+	}
+	
+	//Compress as a delta against our newest frame's keyframe, unless it's time for a new keyframe, or the delta doesn't compress well
+	uint64_t keyframeOf = 0;
+	size_t groupIndex = 0;
+	bool isKeyframe = true;
+	size_t bytes = 0;
+	
+	if (frames != 0)
+	{
+		REWIND_FRAME *newest = GetFrame(frames - 1);
+		keyframeOf = newest->keyframe;
+		groupIndex = newest->groupIndex + 1;
+		isKeyframe = groupIndex >= REWIND_KEYFRAME_INTERVAL;
+	}
+	
+	if (!isKeyframe)
+	{
+		if (DecodeKeyframe(keyframeOf))
+		{
+			Error(fail);
+			return true;
+		}
+		bytes = EncodeDelta(state.data, size, keyframe, keyframeSize, encode);
+		isKeyframe = bytes > size / 2;
+	}
+	if (isKeyframe)
+		bytes = EncodeDelta(state.data, size, nullptr, 0, encode);
+	
+	//Store our frame (as a keyframe after all, if making room dropped our keyframe)
+	size_t offset;
+	if (Alloc(bytes, &offset))
+	{
+		Error(fail);
+		return true;
+	}
+	
+	if (!isKeyframe && (frames == 0 || GetFrame(0)->serial > keyframeOf))
+	{
+		writePos = offset;
+		isKeyframe = true;
+		bytes = EncodeDelta(state.data, size, nullptr, 0, encode);
+		if (Alloc(bytes, &offset))
+		{
+			Error(fail);
+			return true;
+		}
+	}
+	
+	memcpy(buffer + offset, encode, bytes);
+	
+	REWIND_FRAME *newFrame = GetFrame(frames++);
+	newFrame->offset = offset;
+	newFrame->bytes = bytes;
+	newFrame->rawSize = size;
+	newFrame->serial = nextSerial++;
+	newFrame->keyframe = isKeyframe ? newFrame->serial : keyframeOf;
+	newFrame->groupIndex = isKeyframe ? 0 : groupIndex;
+	
+	//Keep our new keyframe decompressed for the deltas against it
+	if (isKeyframe)
+	{
+		if (Grow(&keyframe, &keyframeCapacity, size))
+		{
+			Error(fail);
+			return true;
+		}
+		memcpy(keyframe, state.data, size);
+		keyframeSize = size;
+		keyframeSerial = newFrame->serial;
+	}
+	return false;
+}
+
+//Step back function
+bool REWIND::StepBack()
+{
+	if (!CanStepBack())
+		return false;
+	
+	//Drop our newest frame (reusing its space)
+	writePos = GetFrame(frames - 1)->offset;
+	frames--;
+	
+	//Decompress the frame before it, over its keyframe
+	REWIND_FRAME *restore = GetFrame(frames - 1);
+	if (state.SetSize(restore->rawSize))
+	{
+		Error(fail = state.fail);
+		return true;
+	}
+	
+	if (restore->serial == restore->keyframe)
+	{
+		memset(state.data, 0, restore->rawSize);
+	}
+	else
+	{
+		if (DecodeKeyframe(restore->keyframe))
+		{
+			Error(fail);
+			return true;
+		}
+		
+		size_t baseSize = (keyframeSize < restore->rawSize) ? keyframeSize : restore->rawSize;
+		memcpy(state.data, keyframe, baseSize);
+		memset(state.data + baseSize, 0, restore->rawSize - baseSize);
+	}
+	
+	if (DecodeDelta(buffer + restore->offset, restore->bytes, state.data, restore->rawSize))
+	{
+		Error(fail = "Rewind frame is corrupt");
+		return true;
+	}
+	
+	//Restore the level from it
+	if (state.Load())
+	{
+		Error(fail = state.fail);
+		return true;
+	}
+	return false;
+}
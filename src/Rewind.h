@@ -0,0 +1,75 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "SaveState.h"
+#include "Input.h"
+
+//Rewind constants
+#define REWIND_KEY					IBK_BACKSPACE	//Held to rewind
+#define REWIND_SECONDS				20				//Most history kept (at 60 frames a second)
+#define REWIND_FRAMES				(REWIND_SECONDS * 60)
+#define REWIND_BUDGET				0x800000		//Bytes of compressed history kept, the oldest is dropped past this
+#define REWIND_KEYFRAME_INTERVAL	60				//Frames between keyframes (deltas are against the last keyframe, so this bounds their size)
+
+//Rewind frame (a keyframe, or a delta against its keyframe, in the rewind buffer)
+struct REWIND_FRAME
+{
+	size_t offset;		//Position of our compressed data in the buffer
+	size_t bytes;		//Size of our compressed data
+	size_t rawSize;		//Size of the snapshot we decompress to
+	uint64_t serial;	//Capture number (unique, for identifying keyframes)
+	uint64_t keyframe;	//Serial of our keyframe (our own if we're one)
+	size_t groupIndex;	//Frames since our keyframe
+};
+
+//Rewind class (captures the level every frame into a fixed-size ring buffer of XOR/RLE-compressed snapshots, then walks them backwards)
+class REWIND
+{
+	public:
+		//Failure (capturing stops once we've failed)
+		const char *fail = nullptr;
+		
+		//Frames of history
+		size_t frames = 0;
+	
+	private:
+		//Snapshot of the level, and the decompressed keyframe our newest frame is a delta against
+		SAVESTATE state;
+		uint8_t *keyframe = nullptr;
+		size_t keyframeSize = 0;
+		size_t keyframeCapacity = 0;
+		uint64_t keyframeSerial = 0;	//0 if we don't have a keyframe decompressed
+		
+		//Ring buffer of compressed frames
+		uint8_t *buffer = nullptr;
+		size_t writePos = 0;
+		REWIND_FRAME frame[REWIND_FRAMES];
+		size_t first = 0;
+		uint64_t nextSerial = 1;
+		
+		//Compression buffer
+		uint8_t *encode = nullptr;
+		size_t encodeCapacity = 0;
+	
+	public:
+		REWIND();
+		~REWIND();
+		
+		//Capture the level's state after an update, returns true on failure
+		bool Capture();
+		
+		//Restore the level to the frame before our newest (dropping our newest), returns true on failure
+		inline bool CanStepBack() { return fail == nullptr && frames > 1; }
+		bool StepBack();
+	
+	private:
+		inline REWIND_FRAME *GetFrame(size_t i) { return &frame[(first + i) % REWIND_FRAMES]; }
+		REWIND_FRAME *FindFrame(uint64_t serial);
+		
+		bool Grow(uint8_t **data, size_t *capacity, size_t bytes);
+		bool DecodeKeyframe(uint64_t serial);
+		
+		void DropOldest();
+		bool Alloc(size_t bytes, size_t *offset);
+};
@@ -0,0 +1,283 @@
+#include <stdlib.h>
+#include <algorithm>
+
+#include "RingManager.h"
+#include "Level.h"
+#include "Game.h"
+#include "Objects.h"
+#include "MathUtil.h"
+#include "Error.h"
+
+//Ring constants
+#define RING_TOUCH_WIDTH	6
+#define RING_TOUCH_HEIGHT	6
+#define RING_SPARKLE_SPEED	6	//Frames each sparkle frame is displayed for
+#define RING_SPARKLE_FRAMES	4
+#define RING_WINDOW_MARGIN	0x20	//Leeway for the camera and players moving before our window is next updated
+
+//Constructor and destructor
+RINGMANAGER::RINGMANAGER()
+{
+	return;
+}
+
+RINGMANAGER::~RINGMANAGER()
+{
+	//Free our ring layout
+	free(ring);
+	free(collected);
+}
+
+//Graphics (got from the level's caches, once its assets are preloaded)
+bool RINGMANAGER::LoadGraphics()
+{
+	texture = gLevel->GetObjectTexture(TEXTUREID_GENERIC);
+	if (texture->fail != nullptr)
+	{
+		Error(fail = texture->fail);
+		return true;
+	}
+	
+	mappings = gLevel->GetObjectMappings(MAPPINGSID_RING);
+	if (mappings->fail != nullptr)
+	{
+		Error(fail = mappings->fail);
+		return true;
+	}
+	return false;
+}
+
+//Ring layout functions
+bool RINGMANAGER::Add(int16_t xPos, int16_t yPos)
+{
+	//Expand our ring layout if full
+	if (rings >= ringCapacity)
+	{
+		size_t newCapacity = (ringCapacity != 0) ? (ringCapacity * 2) : 0x100;
+		RING_POSITION *newRing = (RING_POSITION*)realloc(ring, newCapacity * sizeof(RING_POSITION));
+		if (newRing == nullptr)
+		{
+			Error(fail = "Failed to allocate ring layout in memory");
+			return true;
+		}
+		
+		ring = newRing;
+		ringCapacity = newCapacity;
+	}
+	
+	//Add ring to the end of the layout
+	ring[rings++] = {xPos, yPos};
+	return false;
+}
+
+//Ring spacing used by Sonic 1's ring objects (highest nibble of subtype)
+static const int8_t sonic1GroupSpacing[16][2] = {
+	{ 0x10, 0x00},
+	{ 0x18, 0x00},
+	{ 0x20, 0x00},
+	{ 0x00, 0x10},
+	{ 0x00, 0x18},
+	{ 0x00, 0x20},
+	{ 0x10, 0x10},
+	{ 0x18, 0x18},
+	{ 0x20, 0x20},
+	{-0x10, 0x10},
+	{-0x18, 0x18},
+	{-0x20, 0x20},
+	{ 0x10, 0x08},
+	{ 0x18, 0x10},
+	{-0x10, 0x08},
+	{-0x18, 0x10},
+};
+
+bool RINGMANAGER::AddSonic1Group(int16_t xPos, int16_t yPos, uint8_t subtype)
+{
+	//Get how many rings to make (lowest nibble of subtype)
+	int ringsToMake = (subtype & 0x7);
+	if (ringsToMake == 7)
+		ringsToMake = 6;
+	
+	for (int i = 0; i <= ringsToMake; i++)
+	{
+		//Add ring and get next position
+		if (Add(xPos, yPos))
+			return true;
+		xPos += sonic1GroupSpacing[subtype >> 4][0];
+		yPos += sonic1GroupSpacing[subtype >> 4][1];
+	}
+	
+	return false;
+}
+
+bool RINGMANAGER::AddSonic2Group(int16_t xPos, uint16_t word2)
+{
+	//Get our y-position and group type (highest bit is vertical, lower 3 bits are ring count - 1)
+	int16_t yPos = word2 & 0x0FFF;
+	int type = (word2 & 0xF000) >> 12;
+	
+	for (int i = 0; i <= (type & 0x7); i++)
+	{
+		//Add ring and get next position
+		if (Add(xPos, yPos))
+			return true;
+		if (type & 0x8)
+			yPos += 0x18;
+		else
+			xPos += 0x18;
+	}
+	
+	return false;
+}
+
+bool RINGMANAGER::Finalize()
+{
+	//Sort our rings from left to right, so only the range around the camera needs to be checked
+	std::sort(ring, ring + rings, [](const RING_POSITION &a, const RING_POSITION &b) { return a.x < b.x; });
+	
+	//Allocate our collected bitset
+	collected = (uint32_t*)calloc((rings + 0x1F) >> 5, sizeof(uint32_t));
+	if (collected == nullptr && rings != 0)
+	{
+		Error(fail = "Failed to allocate ring collected bitset in memory");
+		return true;
+	}
+	
+	windowLeft = 0;
+	windowRight = 0;
+	sparkles = 0;
+	return false;
+}
+
+//Interaction functions
+void RINGMANAGER::Touch(PLAYER *player, int16_t playerLeft, int16_t playerTop, int16_t playerWidth, int16_t playerHeight)
+{
+	//Don't collect rings if we were just hit
+	if (player->invulnerabilityTime >= 90)
+		return;
+	
+	//Check all rings within our window (which covers every player)
+	for (size_t i = windowLeft; i < windowRight; i++)
+	{
+		if (IsCollected(i))
+			continue;
+		
+		//Check if our hitboxes are colliding
+		int16_t horizontalCheck = playerLeft - (ring[i].x - RING_TOUCH_WIDTH);
+		int16_t verticalCheck = playerTop - (ring[i].y - RING_TOUCH_HEIGHT);
+		
+		if (horizontalCheck >= -playerWidth && horizontalCheck <= RING_TOUCH_WIDTH * 2 && verticalCheck >= -playerHeight && verticalCheck <= RING_TOUCH_HEIGHT * 2)
+		{
+			//Collect the ring and start sparkling
+			SetCollected(i);
+			if (sparkles < RINGMANAGER_SPARKLES)
+				sparkle[sparkles++] = {(uint32_t)i, 0};
+			AddToRings(1);
+		}
+	}
+}
+
+void RINGMANAGER::Attract(PLAYER *player)
+{
+	//Check all rings within our window (which covers every player's attraction radius)
+	for (size_t i = windowLeft; i < windowRight; i++)
+	{
+		if (IsCollected(i))
+			continue;
+		
+		//If we're within range, replace the ring with an attracted ring object
+		int xDiff = ring[i].x - player->x.pos + RING_ATTRACT_RADIUS;
+		int yDiff = ring[i].y - player->y.pos + RING_ATTRACT_RADIUS;
+		
+		if (xDiff >= 0 && xDiff <= RING_ATTRACT_RADIUS * 2 && yDiff >= 0 && yDiff <= RING_ATTRACT_RADIUS * 2)
+		{
+			OBJECT *newObject = new OBJECT(&ObjAttractRing);
+			if (newObject == nullptr)
+			{
+				fail = "Failed to allocate attracted ring in memory";
+				return;
+			}
+			SetCollected(i);
+			
+			newObject->x.pos = ring[i].x;
+			newObject->y.pos = ring[i].y;
+			newObject->parentPlayer = player;
+			gLevel->objectList.link_back(newObject);
+		}
+	}
+}
+
+//Update and draw functions
+void RINGMANAGER::UpdateWindow()
+{
+	//Get the range covering the camera (for drawing) and every player (for collecting and attracting, even off-screen)
+	int left = gLevel->camera->xPos - RING_WINDOW_MARGIN;
+	int right = gLevel->camera->xPos + gRenderSpec.width + RING_WINDOW_MARGIN;
+	
+	for (PLAYER *player : gLevel->playerList)
+	{
+		left = mmin(left, player->x.pos - RING_ATTRACT_RADIUS - RING_WINDOW_MARGIN);
+		right = mmax(right, player->x.pos + RING_ATTRACT_RADIUS + RING_WINDOW_MARGIN);
+	}
+	
+	//Move the left and right sides of our window to this range
+	while (windowLeft < rings && ring[windowLeft].x < left)
+		windowLeft++;
+	while (windowLeft > 0 && ring[windowLeft - 1].x >= left)
+		windowLeft--;
+	
+	if (windowRight < windowLeft)
+		windowRight = windowLeft;
+	while (windowRight < rings && ring[windowRight].x < right)
+		windowRight++;
+	while (windowRight > windowLeft && ring[windowRight - 1].x >= right)
+		windowRight--;
+}
+
+void RINGMANAGER::Update()
+{
+	//Animate rings
+	mappingFrame = (gLevel->frameCounter >> 3) & 0x3;
+	
+	//Update sparkles, and remove them once finished
+	for (size_t i = 0; i < sparkles;)
+	{
+		if (++sparkle[i].timer >= RING_SPARKLE_SPEED * RING_SPARKLE_FRAMES)
+			sparkle[i] = sparkle[--sparkles];
+		else
+			i++;
+	}
+}
+
+static void DrawRing(TEXTURE *texture, MAPPINGS *mappings, uint16_t mappingFrame, int priority, int16_t xPos, int16_t yPos)
+{
+	//Reject if out of bounds
+	if (mappingFrame >= mappings->size)
+		return;
+	
+	//Draw ring at the given position
+	const RECT *mapRect = &mappings->rect[mappingFrame];
+	const POINT *mapOrig = &mappings->origin[mappingFrame];
+	gSoftwareBuffer->DrawTexture(texture, texture->loadedPalette, mapRect, gLevel->GetObjectLayer(false, priority), xPos - mapOrig->x - gLevel->camera->xPos, yPos - mapOrig->y - gLevel->camera->yPos, false, false);
+}
+
+void RINGMANAGER::Draw()
+{
+	//Get our vertical range
+	int top = gLevel->camera->yPos - 0x10;
+	int bottom = gLevel->camera->yPos + gRenderSpec.height + 0x10;
+	
+	//Draw all uncollected rings within range
+	for (size_t i = windowLeft; i < windowRight; i++)
+	{
+		if (IsCollected(i) || ring[i].y < top || ring[i].y >= bottom)
+			continue;
+		DrawRing(texture, mappings, mappingFrame, 2, ring[i].x, ring[i].y);
+	}
+	
+	//Draw sparkles
+	for (size_t i = 0; i < sparkles; i++)
+	{
+		RING_POSITION *position = &ring[sparkle[i].ring];
+		DrawRing(texture, mappings, 4 + sparkle[i].timer / RING_SPARKLE_SPEED, 1, position->x, position->y);
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Render.h"
+#include "Mappings.h"
+
+class PLAYER;
+
+//Ring manager constants
+#define RINGMANAGER_SPARKLES	0x40	//Maximum rings sparkling at once
+#define RING_ATTRACT_RADIUS		64
+
+//Static ring position
+struct RING_POSITION
+{
+	int16_t x;
+	int16_t y;
+};
+
+//Collected ring sparkle
+struct RING_SPARKLE
+{
+	uint32_t ring;
+	uint8_t timer;
+};
+
+//Ring manager class (static level rings, handled without objects like in Sonic 2)
+class RINGMANAGER
+{
+	public:
+		//Failure
+		const char *fail = nullptr;
+		
+		//Ring layout (sorted by x-position) and collected bitset
+		RING_POSITION *ring = nullptr;
+		uint32_t *collected = nullptr;
+		size_t rings = 0;
+		size_t ringCapacity = 0;
+		
+		//Rings within range of the camera and every player (ring[windowLeft] to ring[windowRight - 1])
+		size_t windowLeft = 0;
+		size_t windowRight = 0;
+		
+		//Sparkling rings
+		RING_SPARKLE sparkle[RINGMANAGER_SPARKLES];
+		size_t sparkles = 0;
+		
+		//Animation
+		uint16_t mappingFrame = 0;
+		
+		//Texture and mappings
+		TEXTURE *texture = nullptr;
+		MAPPINGS *mappings = nullptr;
+	
+	public:
+		RINGMANAGER();
+		~RINGMANAGER();
+		
+		//Get our graphics from the level's caches (returns true on failure)
+		bool LoadGraphics();
+		
+		//Ring layout functions
+		bool Add(int16_t xPos, int16_t yPos);
+		bool AddSonic1Group(int16_t xPos, int16_t yPos, uint8_t subtype);
+		bool AddSonic2Group(int16_t xPos, uint16_t word2);
+		bool Finalize();
+		
+		inline bool IsCollected(size_t i) { return (collected[i >> 5] & (1u << (i & 0x1F))) != 0; }
+		inline void SetCollected(size_t i) { collected[i >> 5] |= (1u << (i & 0x1F)); }
+		
+		//Interaction functions
+		void Touch(PLAYER *player, int16_t playerLeft, int16_t playerTop, int16_t playerWidth, int16_t playerHeight);
+		void Attract(PLAYER *player);
+		
+		//Update and draw functions
+		void UpdateWindow();
+		void Update();
+		void Draw();
+};
@@ -0,0 +1,907 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "SaveState.h"
+#include "Level.h"
+#include "Game.h"
+#include "MathUtil.h"
+#include "Error.h"
+#include "Log.h"
+
+//References (0 is always null)
+#define SAVESTATE_REF_OBJECT	0x40000000
+#define SAVESTATE_REF_PLAYER	0x80000000
+#define SAVESTATE_REF_INDEX		0x3FFFFFFF
+
+#define SAVESTATE_NULL_FUNCTION	INT64_MIN
+
+static_assert(alignof(OBJECT) <= SAVESTATE_ALIGN && alignof(OBJECT_COLD) <= SAVESTATE_ALIGN && alignof(PLAYER) <= SAVESTATE_ALIGN && alignof(OBJECT_LOAD) <= SAVESTATE_ALIGN, "Savestate records aren't aligned enough");
+
+//Functions are saved as offsets from this one (which stay the same between runs of the same executable)
+static void FunctionBase()
+{
+	return;
+}
+
+template <typename T> static inline int64_t FunctionRef(T function)
+{
+	return (function == nullptr) ? SAVESTATE_NULL_FUNCTION : (int64_t)((intptr_t)function - (intptr_t)&FunctionBase);
+}
+
+template <typename T> static inline T RefFunction(int64_t ref)
+{
+	return (ref == SAVESTATE_NULL_FUNCTION) ? nullptr : (T)((intptr_t)&FunctionBase + (intptr_t)ref);
+}
+
+//Snapshot records
+struct SAVESTATE_HEADER
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t objectSize, playerSize, objectLoadSize;	//Layouts of the objects, players, and object loads copied in
+	uint32_t levelId;
+	uint32_t players;
+	uint32_t textures, mappings;
+	uint64_t size;
+};
+
+struct SAVESTATE_GLOBALS
+{
+	uint32_t score, nextScoreReward;
+	uint32_t time;
+	uint32_t rings, nextRingReward;
+	uint32_t lives;
+	uint32_t randomSeed;
+};
+
+struct SAVESTATE_LEVEL
+{
+	//Oscillatory values
+	bool oscillateDirection[OSCILLATORY_VALUES];
+	uint16_t oscillate[OSCILLATORY_VALUES][2];
+	
+	//Boundaries (current then target, left, right, top, bottom)
+	uint16_t boundary[8];
+	
+	//Other state
+	int32_t frameCounter;
+	bool updateTime, updateStage, fading, isFadingIn, specialFade;
+	LEVELSPECIFIC_STATE levelSpecific;
+	
+	//Camera
+	int16_t cameraX, cameraY;
+	int16_t xPan, yPan;
+	int16_t lookPan, lookTimer;
+	uint16_t shake;
+	
+	//Title card
+	bool titleCardActiveLock;
+	uint32_t titleCardFrame;
+	int32_t focusX, focusY;
+	TITLECARD::LINEPOS line[LINE_MAX];
+};
+
+struct SAVESTATE_RINGS
+{
+	uint64_t rings;
+	uint64_t windowLeft, windowRight;
+	uint64_t sparkles;
+	uint16_t mappingFrame;
+};
+
+struct SAVESTATE_COUNTS
+{
+	uint64_t particles;
+	uint64_t coreObjects, objects;
+	uint64_t objectLoads, spawnQueue;
+};
+
+//Objects are saved followed by their cold data up to their player contact status (which is saved for the players that exist)
+#define SAVESTATE_COLD_SIZE	offsetof(OBJECT_COLD, playerContact)
+
+struct SAVESTATE_OBJECTREFS
+{
+	int64_t function, prevFunction, scratchDestructor;
+	uint32_t texture, mappings;
+	uint32_t parent;
+	uint32_t hierarchyParent, firstChild, nextSibling;
+};
+
+struct SAVESTATE_PLAYERREFS
+{
+	uint32_t interact;
+	uint32_t spindashDust, skidDust, barrierObject;
+	uint32_t invincibilityStarObject[INVINCIBILITYSTARS];
+};
+
+struct SAVESTATE_OBJECTLOADREFS
+{
+	int64_t function;
+	uint32_t loaded;
+};
+
+//Constructor and destructor
+SAVESTATE::SAVESTATE(size_t setCapacity)
+{
+	//Preallocate our snapshot
+	if (Reserve(setCapacity))
+		Error(fail);
+}
+
+SAVESTATE::~SAVESTATE()
+{
+	//Free our snapshot
+	free(data);
+}
+
+//Data functions
+bool SAVESTATE::Reserve(size_t bytes)
+{
+	//Grow our snapshot to fit the given size
+	if (bytes <= capacity)
+		return false;
+	
+	size_t newCapacity = (capacity != 0) ? capacity : SAVESTATE_DEFAULT_CAPACITY;
+	while (newCapacity < bytes)
+		newCapacity *= 2;
+	
+	uint8_t *newData = (uint8_t*)realloc(data, newCapacity);
+	if (newData == nullptr)
+	{
+		fail = "Failed to allocate savestate";
+		return true;
+	}
+	
+	if (capacity != 0)
+	{
+		LOG(("Savestate grown to %d bytes\n", (int)newCapacity));
+	}
+	data = newData;
+	capacity = newCapacity;
+	return false;
+}
+
+void *SAVESTATE::Write(const void *from, size_t bytes)
+{
+	//Copy the given data (or zeroes, if nullptr) to the end of our snapshot, padded to keep our records aligned
+	size_t padded = upperRound(bytes, SAVESTATE_ALIGN);
+	if (Reserve(size + padded))
+		return nullptr;
+	
+	uint8_t *to = data + size;
+	if (from != nullptr)
+		memcpy(to, from, bytes);
+	else
+		memset(to, 0, bytes);
+	memset(to + bytes, 0, padded - bytes);
+	size += padded;
+	return to;
+}
+
+const void *SAVESTATE::Read(size_t bytes)
+{
+	//Get the next data in our snapshot
+	size_t padded = upperRound(bytes, SAVESTATE_ALIGN);
+	if (readPos + padded > size)
+	{
+		fail = "Savestate is truncated";
+		return nullptr;
+	}
+	
+	const uint8_t *from = data + readPos;
+	readPos += padded;
+	return from;
+}
+
+bool SAVESTATE::SetSize(size_t setSize)
+{
+	fail = nullptr;
+	if (Reserve(setSize))
+		return true;
+	size = setSize;
+	return false;
+}
+
+//Reference functions
+void SAVESTATE::BuildAssetTables()
+{
+	//Get every texture and mappings the level's state can reference (index 0 being null)
+	textureTable.clear();
+	textureTable.link_back(nullptr);
+	textureTable.link_back(gLevel->tileTexture);
+	textureTable.link_back((gLevel->background != nullptr) ? gLevel->background->texture : nullptr);
+	for (TEXTURE *texture : gLevel->objTextureCache)
+		textureTable.link_back(texture);
+	
+	mappingsTable.clear();
+	mappingsTable.link_back(nullptr);
+	for (MAPPINGS *mappings : gLevel->objMappingsCache)
+		mappingsTable.link_back(mappings);
+	
+	//Index them by pointer (keeping the first index of anything listed twice)
+	textureIndex.clear();
+	for (size_t i = 1; i < textureTable.size(); i++)
+		textureIndex.emplace(textureTable[i], (uint32_t)i);
+	mappingsIndex.clear();
+	for (size_t i = 1; i < mappingsTable.size(); i++)
+		mappingsIndex.emplace(mappingsTable[i], (uint32_t)i);
+}
+
+uint32_t SAVESTATE::TextureRef(TEXTURE *texture)
+{
+	if (texture == nullptr)
+		return 0;
+	auto index = textureIndex.find(texture);
+	return (index != textureIndex.end()) ? index->second : 0;
+}
+
+uint32_t SAVESTATE::MappingsRef(MAPPINGS *mappings)
+{
+	if (mappings == nullptr)
+		return 0;
+	auto index = mappingsIndex.find(mappings);
+	return (index != mappingsIndex.end()) ? index->second : 0;
+}
+
+uint32_t SAVESTATE::Ref(const void *pointer)
+{
+	//Get the reference of an object or player (anything else, such as an object that's since been deleted, is saved as null)
+	if (pointer == nullptr)
+		return 0;
+	auto ref = objectRef.find(pointer);
+	return (ref != objectRef.end()) ? ref->second : 0;
+}
+
+OBJECT *SAVESTATE::RefObject(uint32_t ref)
+{
+	if (!(ref & SAVESTATE_REF_OBJECT) || (ref & SAVESTATE_REF_INDEX) >= objectTable.size())
+		return nullptr;
+	return objectTable[ref & SAVESTATE_REF_INDEX];
+}
+
+void *SAVESTATE::RefPointer(uint32_t ref)
+{
+	if ((ref & SAVESTATE_REF_PLAYER) && (ref & SAVESTATE_REF_INDEX) < gLevel->playerList.size())
+		return gLevel->playerList[ref & SAVESTATE_REF_INDEX];
+	return RefObject(ref);
+}
+
+//Object functions
+bool SAVESTATE::SaveObject(OBJECT *object)
+{
+	//Copy our object and its cold data, then clear their pointers, which are saved as references after
+	OBJECT *saved = (OBJECT*)Write(object, sizeof(OBJECT));
+	if (saved == nullptr)
+		return true;
+	
+	saved->function = nullptr;
+	saved->texture = nullptr;
+	saved->parent = nullptr;
+	saved->scratch = nullptr;
+	saved->drawInstances = nullptr;
+	
+	OBJECT_COLD *cold = object->Cold();
+	OBJECT_COLD *savedCold = (OBJECT_COLD*)Write(cold, SAVESTATE_COLD_SIZE);
+	if (savedCold == nullptr)
+		return true;
+	
+	savedCold->prevFunction = nullptr;
+	savedCold->fail = nullptr;
+	savedCold->mapping.mappings = nullptr;
+	savedCold->hierarchyParent = nullptr;
+	savedCold->firstChild = nullptr;
+	savedCold->nextSibling = nullptr;
+	savedCold->scratchDestructor = nullptr;
+	
+	SAVESTATE_OBJECTREFS refs;
+	refs.function = FunctionRef(object->function);
+	refs.prevFunction = FunctionRef(cold->prevFunction);
+	refs.scratchDestructor = FunctionRef(cold->scratchDestructor);
+	refs.texture = TextureRef(object->texture);
+	refs.mappings = MappingsRef(cold->mapping.mappings);
+	refs.parent = Ref(object->parent);
+	refs.hierarchyParent = Ref(cold->hierarchyParent);
+	refs.firstChild = Ref(cold->firstChild);
+	refs.nextSibling = Ref(cold->nextSibling);
+	if (Write(refs))
+		return true;
+	
+	//Save our player contact status (for the players that exist) and scratch
+	size_t contacts = mmin(gLevel->playerList.size(), (size_t)OBJECT_PLAYER_REFERENCES);
+	if (Write(cold->playerContact, sizeof(OBJECT_PLAYERCONTACT) * contacts) == nullptr)
+		return true;
+	if (object->scratch != nullptr && Write(object->scratch, cold->scratchSize) == nullptr)
+		return true;
+	
+	//Save our draw instances from our last update (we keep drawing them until our next update), with their assets as references
+	if (object->drawInstanceCount != 0)
+	{
+		OBJECT_DRAWINSTANCE *savedInstance = (OBJECT_DRAWINSTANCE*)Write(object->drawInstances, sizeof(OBJECT_DRAWINSTANCE) * object->drawInstanceCount);
+		if (savedInstance == nullptr)
+			return true;
+		for (size_t i = 0; i < object->drawInstanceCount; i++)
+		{
+			savedInstance[i].texture = nullptr;
+			savedInstance[i].mapping.mappings = nullptr;
+		}
+		
+		uint32_t *assetRef = (uint32_t*)Write(nullptr, sizeof(uint32_t) * 2 * object->drawInstanceCount);
+		if (assetRef == nullptr)
+			return true;
+		for (size_t i = 0; i < object->drawInstanceCount; i++)
+		{
+			assetRef[i * 2 + 0] = TextureRef(object->drawInstances[i].texture);
+			assetRef[i * 2 + 1] = MappingsRef(object->drawInstances[i].mapping.mappings);
+		}
+	}
+	return false;
+}
+
+bool SAVESTATE::LoadObject(OBJECT *object, ARENA *drawArena)
+{
+	//Copy our object and its cold data over this one (keeping its place in the object pool, which its cold data is found by)
+	const void *record = Read(sizeof(OBJECT));
+	const void *coldRecord = Read(SAVESTATE_COLD_SIZE);
+	if (record == nullptr || coldRecord == nullptr)
+		return true;
+	
+	memcpy((void*)object, record, sizeof(OBJECT));
+	OBJECT_COLD *cold = object->Cold();
+	memcpy((void*)cold, coldRecord, SAVESTATE_COLD_SIZE);
+	
+	//Resolve our references
+	SAVESTATE_OBJECTREFS refs;
+	if (Read(refs))
+		return true;
+	
+	object->function = RefFunction<OBJECTFUNCTION>(refs.function);
+	cold->prevFunction = RefFunction<OBJECTFUNCTION>(refs.prevFunction);
+	object->texture = textureTable[(refs.texture < textureTable.size()) ? refs.texture : 0];
+	cold->mapping.mappings = mappingsTable[(refs.mappings < mappingsTable.size()) ? refs.mappings : 0];
+	object->parent = RefPointer(refs.parent);
+	cold->hierarchyParent = RefObject(refs.hierarchyParent);
+	cold->firstChild = RefObject(refs.firstChild);
+	cold->nextSibling = RefObject(refs.nextSibling);
+	
+	//Restore our player contact status and scratch
+	size_t contacts = mmin(gLevel->playerList.size(), (size_t)OBJECT_PLAYER_REFERENCES);
+	const void *contact = Read(sizeof(OBJECT_PLAYERCONTACT) * contacts);
+	if (contact == nullptr)
+		return true;
+	memcpy(cold->playerContact, contact, sizeof(OBJECT_PLAYERCONTACT) * contacts);
+	
+	if (cold->scratchSize != 0)
+	{
+		const void *scratch = Read(cold->scratchSize);
+		if (scratch == nullptr)
+		{
+			cold->scratchSize = 0;
+			return true;
+		}
+		
+		object->scratch = object->AllocScratch(cold->scratchSize);
+		cold->scratchDestructor = RefFunction<void (*)(void*)>(refs.scratchDestructor);
+		memcpy(object->scratch, scratch, cold->scratchSize);
+	}
+	
+	//Restore our draw instances into the given draw instance arena
+	if (object->drawInstanceCount != 0)
+	{
+		const void *instance = Read(sizeof(OBJECT_DRAWINSTANCE) * object->drawInstanceCount);
+		const uint32_t *assetRef = (const uint32_t*)Read(sizeof(uint32_t) * 2 * object->drawInstanceCount);
+		object->drawInstances = drawArena->Alloc<OBJECT_DRAWINSTANCE>(object->drawInstanceCount);
+		if (instance == nullptr || assetRef == nullptr || object->drawInstances == nullptr)
+		{
+			object->drawInstanceCount = 0;
+			return true;
+		}
+		
+		memcpy(object->drawInstances, instance, sizeof(OBJECT_DRAWINSTANCE) * object->drawInstanceCount);
+		for (size_t i = 0; i < object->drawInstanceCount; i++)
+		{
+			object->drawInstances[i].texture = textureTable[(assetRef[i * 2 + 0] < textureTable.size()) ? assetRef[i * 2 + 0] : 0];
+			object->drawInstances[i].mapping.mappings = mappingsTable[(assetRef[i * 2 + 1] < mappingsTable.size()) ? assetRef[i * 2 + 1] : 0];
+		}
+	}
+	return false;
+}
+
+void SAVESTATE::DiscardObjects()
+{
+	//Release every object load (they're reused for the loads we restore)
+	for (OBJECT_LOAD *objectLoad : gLevel->objectLoadList)
+		gLevel->objectLoadSpare.link_back(objectLoad);
+	gLevel->objectLoadList.clear();
+	gLevel->spawnQueue.clear();
+	
+	//Delete every object, unlinked first so they don't walk a hierarchy that's being deleted
+	for (ARRAY<OBJECT*> *list : {&gLevel->coreObjectList, &gLevel->objectList})
+	{
+		for (OBJECT *object : *list)
+		{
+			OBJECT_COLD *cold = object->Cold();
+			cold->hierarchyParent = nullptr;
+			cold->firstChild = nullptr;
+			cold->nextSibling = nullptr;
+		}
+		for (OBJECT *object : *list)
+			delete object;
+		list->clear();
+	}
+}
+
+//Save function
+bool SAVESTATE::Save()
+{
+	fail = nullptr;
+	size = 0;
+	
+	if (gLevel == nullptr || gLevel->camera == nullptr || gLevel->titleCard == nullptr || gLevel->ringManager == nullptr || gLevel->particleSystem == nullptr)
+	{
+		fail = "There's no level to save the state of";
+		return true;
+	}
+	
+	//Get our references (objects in list order, core objects first, then players)
+	BuildAssetTables();
+	
+	objectRef.clear();
+	uint32_t objectIndex = 0;
+	for (OBJECT *object : gLevel->coreObjectList)
+		objectRef[object] = SAVESTATE_REF_OBJECT | objectIndex++;
+	for (OBJECT *object : gLevel->objectList)
+		objectRef[object] = SAVESTATE_REF_OBJECT | objectIndex++;
+	for (size_t i = 0; i < gLevel->playerList.size(); i++)
+		objectRef[gLevel->playerList[i]] = SAVESTATE_REF_PLAYER | (uint32_t)i;
+	
+	//Write our header (its size is filled in once we're done)
+	SAVESTATE_HEADER header;
+	header.magic = SAVESTATE_MAGIC;
+	header.version = SAVESTATE_VERSION;
+	header.objectSize = sizeof(OBJECT) + SAVESTATE_COLD_SIZE;
+	header.playerSize = sizeof(PLAYER);
+	header.objectLoadSize = sizeof(OBJECT_LOAD);
+	header.levelId = gLevel->levelId;
+	header.players = gLevel->playerList.size();
+	header.textures = textureTable.size();
+	header.mappings = mappingsTable.size();
+	header.size = 0;
+	if (Write(header))
+		return true;
+	
+	//Write our globals
+	SAVESTATE_GLOBALS globals;
+	globals.score = gScore;
+	globals.nextScoreReward = gNextScoreReward;
+	globals.time = gTime;
+	globals.rings = gRings;
+	globals.nextRingReward = gNextRingReward;
+	globals.lives = gLives;
+	globals.randomSeed = GetRandomSeed();
+	if (Write(globals))
+		return true;
+	
+	//Write the level's state, camera, and title card
+	SAVESTATE_LEVEL level;
+	memcpy(level.oscillateDirection, gLevel->oscillateDirection, sizeof(level.oscillateDirection));
+	memcpy(level.oscillate, gLevel->oscillate, sizeof(level.oscillate));
+	level.boundary[0] = gLevel->leftBoundary;
+	level.boundary[1] = gLevel->rightBoundary;
+	level.boundary[2] = gLevel->topBoundary;
+	level.boundary[3] = gLevel->bottomBoundary;
+	level.boundary[4] = gLevel->leftBoundaryTarget;
+	level.boundary[5] = gLevel->rightBoundaryTarget;
+	level.boundary[6] = gLevel->topBoundaryTarget;
+	level.boundary[7] = gLevel->bottomBoundaryTarget;
+	level.frameCounter = gLevel->frameCounter;
+	level.updateTime = gLevel->updateTime;
+	level.updateStage = gLevel->updateStage;
+	level.fading = gLevel->fading;
+	level.isFadingIn = gLevel->isFadingIn;
+	level.specialFade = gLevel->specialFade;
+	level.levelSpecific = gLevel->levelSpecific;
+	
+	CAMERA *camera = gLevel->camera;
+	level.cameraX = camera->xPos;
+	level.cameraY = camera->yPos;
+	level.xPan = camera->xPan;
+	level.yPan = camera->yPan;
+	level.lookPan = camera->lookPan;
+	level.lookTimer = camera->lookTimer;
+	level.shake = camera->shake;
+	
+	TITLECARD *titleCard = gLevel->titleCard;
+	level.titleCardActiveLock = titleCard->activeLock;
+	level.titleCardFrame = titleCard->frame;
+	level.focusX = titleCard->focusX;
+	level.focusY = titleCard->focusY;
+	memcpy(level.line, titleCard->line, sizeof(level.line));
+	if (Write(level))
+		return true;
+	
+	//Write our rings
+	RINGMANAGER *ringManager = gLevel->ringManager;
+	SAVESTATE_RINGS rings;
+	rings.rings = ringManager->rings;
+	rings.windowLeft = ringManager->windowLeft;
+	rings.windowRight = ringManager->windowRight;
+	rings.sparkles = ringManager->sparkles;
+	rings.mappingFrame = ringManager->mappingFrame;
+	if (Write(rings))
+		return true;
+	if (ringManager->rings != 0 && Write(ringManager->collected, ((ringManager->rings + 0x1F) >> 5) * sizeof(uint32_t)) == nullptr)
+		return true;
+	if (ringManager->sparkles != 0 && Write(ringManager->sparkle, ringManager->sparkles * sizeof(RING_SPARKLE)) == nullptr)
+		return true;
+	
+	//Write our counts
+	SAVESTATE_COUNTS counts;
+	counts.particles = gLevel->particleSystem->particles;
+	counts.coreObjects = gLevel->coreObjectList.size();
+	counts.objects = gLevel->objectList.size();
+	counts.objectLoads = gLevel->objectLoadList.size();
+	counts.spawnQueue = gLevel->spawnQueue.size();
+	if (Write(counts))
+		return true;
+	
+	//Write our particles (only the ones in use of each array)
+	PARTICLESYSTEM *particleSystem = gLevel->particleSystem;
+	size_t particles = particleSystem->particles;
+	if (particles != 0)
+	{
+		if (Write(particleSystem->type, particles * sizeof(*particleSystem->type)) == nullptr
+		 || Write(particleSystem->flags, particles * sizeof(*particleSystem->flags)) == nullptr
+		 || Write(particleSystem->priority, particles * sizeof(*particleSystem->priority)) == nullptr
+		 || Write(particleSystem->xLong, particles * sizeof(*particleSystem->xLong)) == nullptr
+		 || Write(particleSystem->yLong, particles * sizeof(*particleSystem->yLong)) == nullptr
+		 || Write(particleSystem->xVel, particles * sizeof(*particleSystem->xVel)) == nullptr
+		 || Write(particleSystem->yVel, particles * sizeof(*particleSystem->yVel)) == nullptr
+		 || Write(particleSystem->delay, particles * sizeof(*particleSystem->delay)) == nullptr
+		 || Write(particleSystem->life, particles * sizeof(*particleSystem->life)) == nullptr
+		 || Write(particleSystem->spin, particles * sizeof(*particleSystem->spin)) == nullptr
+		 || Write(particleSystem->animFrame, particles * sizeof(*particleSystem->animFrame)) == nullptr
+		 || Write(particleSystem->animTimer, particles * sizeof(*particleSystem->animTimer)) == nullptr
+		 || Write(particleSystem->mappingFrame, particles * sizeof(*particleSystem->mappingFrame)) == nullptr
+		 || Write(particleSystem->rect, particles * sizeof(*particleSystem->rect)) == nullptr)
+			return true;
+		
+		uint32_t *textureRef = (uint32_t*)Write(nullptr, particles * sizeof(uint32_t));
+		if (textureRef == nullptr)
+			return true;
+		for (size_t i = 0; i < particles; i++)
+			textureRef[i] = TextureRef(particleSystem->texture[i]);
+	}
+	
+	//Write our palettes (cycled and faded in place)
+	for (size_t i = 1; i < textureTable.size(); i++)
+	{
+		PALETTE *palette = (textureTable[i] != nullptr) ? textureTable[i]->loadedPalette : nullptr;
+		uint32_t colours = (palette != nullptr) ? palette->colours : 0;
+		if (Write(colours))
+			return true;
+		if (colours != 0 && Write(palette->colour, colours * sizeof(COLOUR)) == nullptr)
+			return true;
+	}
+	
+	//Write our objects
+	for (OBJECT *object : gLevel->coreObjectList)
+		if (SaveObject(object))
+			return true;
+	for (OBJECT *object : gLevel->objectList)
+		if (SaveObject(object))
+			return true;
+	
+	//Write our players
+	for (PLAYER *player : gLevel->playerList)
+	{
+		PLAYER *saved = (PLAYER*)Write(player, sizeof(PLAYER));
+		if (saved == nullptr)
+			return true;
+		
+		saved->fail = nullptr;
+		saved->texture = nullptr;
+		saved->mappings = nullptr;
+		saved->interact = nullptr;
+		saved->spindashDust = nullptr;
+		saved->skidDust = nullptr;
+		saved->barrierObject = nullptr;
+		for (int i = 0; i < INVINCIBILITYSTARS; i++)
+			saved->invincibilityStarObject[i] = nullptr;
+		saved->follow = nullptr;
+		
+		SAVESTATE_PLAYERREFS refs;
+		refs.interact = Ref(player->interact);
+		refs.spindashDust = Ref(player->spindashDust);
+		refs.skidDust = Ref(player->skidDust);
+		refs.barrierObject = Ref(player->barrierObject);
+		for (int i = 0; i < INVINCIBILITYSTARS; i++)
+			refs.invincibilityStarObject[i] = Ref(player->invincibilityStarObject[i]);
+		if (Write(refs))
+			return true;
+	}
+	
+	//Write our object loads, and the spawn queue as indices into them
+	for (OBJECT_LOAD *objectLoad : gLevel->objectLoadList)
+	{
+		OBJECT_LOAD *saved = (OBJECT_LOAD*)Write(objectLoad, sizeof(OBJECT_LOAD));
+		if (saved == nullptr)
+			return true;
+		saved->function = nullptr;
+		saved->loaded = nullptr;
+		
+		SAVESTATE_OBJECTLOADREFS refs;
+		refs.function = FunctionRef(objectLoad->function);
+		refs.loaded = Ref(objectLoad->loaded);
+		if (Write(refs))
+			return true;
+	}
+	
+	for (OBJECT_LOAD *objectLoad : gLevel->spawnQueue)
+		if (Write((uint32_t)gLevel->objectLoadList.pos_of_val(objectLoad)))
+			return true;
+	
+	//Fill in our size
+	((SAVESTATE_HEADER*)data)->size = size;
+	return false;
+}
+
+//Load function
+bool SAVESTATE::Load()
+{
+	fail = nullptr;
+	readPos = 0;
+	
+	//Check that our snapshot is for this level, and was saved by this build
+	SAVESTATE_HEADER header;
+	if (gLevel == nullptr || gLevel->camera == nullptr || gLevel->titleCard == nullptr || gLevel->ringManager == nullptr || gLevel->particleSystem == nullptr)
+	{
+		fail = "There's no level to load the state into";
+		return true;
+	}
+	if (Read(header))
+		return true;
+	if (header.magic != SAVESTATE_MAGIC || header.version != SAVESTATE_VERSION || header.size != size)
+	{
+		fail = "Savestate is invalid or from a different version";
+		return true;
+	}
+	if (header.objectSize != sizeof(OBJECT) + SAVESTATE_COLD_SIZE || header.playerSize != sizeof(PLAYER) || header.objectLoadSize != sizeof(OBJECT_LOAD))
+	{
+		fail = "Savestate is from a different build";
+		return true;
+	}
+	
+	//Our asset tables are only ever appended to (as the level loads assets), so the snapshot's have to be a prefix of ours
+	BuildAssetTables();
+	if (header.levelId != (uint32_t)gLevel->levelId || header.players != gLevel->playerList.size() || header.textures > textureTable.size() || header.mappings > mappingsTable.size())
+	{
+		fail = "Savestate doesn't match the current level";
+		return true;
+	}
+	
+	//Read our globals
+	SAVESTATE_GLOBALS globals;
+	if (Read(globals))
+		return true;
+	gScore = globals.score;
+	gNextScoreReward = globals.nextScoreReward;
+	gTime = globals.time;
+	gRings = globals.rings;
+	gNextRingReward = globals.nextRingReward;
+	gLives = globals.lives;
+	SetRandomSeed(globals.randomSeed);
+	
+	//Read the level's state, camera, and title card
+	SAVESTATE_LEVEL level;
+	if (Read(level))
+		return true;
+	memcpy(gLevel->oscillateDirection, level.oscillateDirection, sizeof(level.oscillateDirection));
+	memcpy(gLevel->oscillate, level.oscillate, sizeof(level.oscillate));
+	gLevel->leftBoundary = level.boundary[0];
+	gLevel->rightBoundary = level.boundary[1];
+	gLevel->topBoundary = level.boundary[2];
+	gLevel->bottomBoundary = level.boundary[3];
+	gLevel->leftBoundaryTarget = level.boundary[4];
+	gLevel->rightBoundaryTarget = level.boundary[5];
+	gLevel->topBoundaryTarget = level.boundary[6];
+	gLevel->bottomBoundaryTarget = level.boundary[7];
+	gLevel->frameCounter = level.frameCounter;
+	gLevel->updateTime = level.updateTime;
+	gLevel->updateStage = level.updateStage;
+	gLevel->fading = level.fading;
+	gLevel->isFadingIn = level.isFadingIn;
+	gLevel->specialFade = level.specialFade;
+	gLevel->levelSpecific = level.levelSpecific;
+	
+	CAMERA *camera = gLevel->camera;
+	camera->xPos = level.cameraX;
+	camera->yPos = level.cameraY;
+	camera->xPan = level.xPan;
+	camera->yPan = level.yPan;
+	camera->lookPan = level.lookPan;
+	camera->lookTimer = level.lookTimer;
+	camera->shake = level.shake;
+	
+	TITLECARD *titleCard = gLevel->titleCard;
+	titleCard->activeLock = level.titleCardActiveLock;
+	titleCard->frame = level.titleCardFrame;
+	titleCard->focusX = level.focusX;
+	titleCard->focusY = level.focusY;
+	memcpy(titleCard->line, level.line, sizeof(level.line));
+	
+	//Read our rings
+	RINGMANAGER *ringManager = gLevel->ringManager;
+	SAVESTATE_RINGS rings;
+	if (Read(rings))
+		return true;
+	if (rings.rings != ringManager->rings || rings.sparkles > RINGMANAGER_SPARKLES)
+	{
+		fail = "Savestate doesn't match the current level";
+		return true;
+	}
+	
+	ringManager->windowLeft = rings.windowLeft;
+	ringManager->windowRight = rings.windowRight;
+	ringManager->sparkles = rings.sparkles;
+	ringManager->mappingFrame = rings.mappingFrame;
+	if (ringManager->rings != 0)
+	{
+		size_t collectedBytes = ((ringManager->rings + 0x1F) >> 5) * sizeof(uint32_t);
+		const void *collected = Read(collectedBytes);
+		if (collected == nullptr)
+			return true;
+		memcpy(ringManager->collected, collected, collectedBytes);
+	}
+	if (ringManager->sparkles != 0)
+	{
+		const void *sparkle = Read(ringManager->sparkles * sizeof(RING_SPARKLE));
+		if (sparkle == nullptr)
+			return true;
+		memcpy(ringManager->sparkle, sparkle, ringManager->sparkles * sizeof(RING_SPARKLE));
+	}
+	
+	//Read our counts
+	SAVESTATE_COUNTS counts;
+	if (Read(counts))
+		return true;
+	if (counts.particles > PARTICLES_MAX)
+	{
+		fail = "Savestate is corrupt";
+		return true;
+	}
+	
+	//Read our particles
+	PARTICLESYSTEM *particleSystem = gLevel->particleSystem;
+	size_t particles = particleSystem->particles = counts.particles;
+	if (particles != 0)
+	{
+		#define READ_PARTICLE_ARRAY(array)	{	\
+												const void *from = Read(particles * sizeof(*particleSystem->array));	\
+												if (from == nullptr)	\
+													return true;	\
+												memcpy(particleSystem->array, from, particles * sizeof(*particleSystem->array));	\
+											}
+		READ_PARTICLE_ARRAY(type)
+		READ_PARTICLE_ARRAY(flags)
+		READ_PARTICLE_ARRAY(priority)
+		READ_PARTICLE_ARRAY(xLong)
+		READ_PARTICLE_ARRAY(yLong)
+		READ_PARTICLE_ARRAY(xVel)
+		READ_PARTICLE_ARRAY(yVel)
+		READ_PARTICLE_ARRAY(delay)
+		READ_PARTICLE_ARRAY(life)
+		READ_PARTICLE_ARRAY(spin)
+		READ_PARTICLE_ARRAY(animFrame)
+		READ_PARTICLE_ARRAY(animTimer)
+		READ_PARTICLE_ARRAY(mappingFrame)
+		READ_PARTICLE_ARRAY(rect)
+		#undef READ_PARTICLE_ARRAY
+		
+		const uint32_t *textureRef = (const uint32_t*)Read(particles * sizeof(uint32_t));
+		if (textureRef == nullptr)
+			return true;
+		for (size_t i = 0; i < particles; i++)
+			particleSystem->texture[i] = textureTable[(textureRef[i] < textureTable.size()) ? textureRef[i] : 0];
+	}
+	
+	//Read our palettes (for the textures the snapshot knew of)
+	for (size_t i = 1; i < header.textures; i++)
+	{
+		PALETTE *palette = (textureTable[i] != nullptr) ? textureTable[i]->loadedPalette : nullptr;
+		uint32_t colours;
+		if (Read(colours))
+			return true;
+		if (colours != ((palette != nullptr) ? palette->colours : 0))
+		{
+			fail = "Savestate doesn't match the current level";
+			return true;
+		}
+		
+		if (colours != 0)
+		{
+			const void *colour = Read(colours * sizeof(COLOUR));
+			if (colour == nullptr)
+				return true;
+			memcpy(palette->colour, colour, colours * sizeof(COLOUR));
+		}
+	}
+	
+	//Replace our objects with the saved ones (all created first, so they can reference each other) and their draw instances
+	DiscardObjects();
+	
+	gLevel->objectDrawArena.Reset();
+	gLevel->coreDrawArena.Reset();
+	
+	objectTable.clear();
+	for (size_t i = 0; i < counts.coreObjects + counts.objects; i++)
+	{
+		OBJECT *object = new OBJECT(nullptr);
+		if (object == nullptr)
+		{
+			fail = "Failed to allocate object in memory";
+			return true;
+		}
+		objectTable.link_back(object);
+		if (i < counts.coreObjects)
+			gLevel->coreObjectList.link_back(object);
+		else
+			gLevel->objectList.link_back(object);
+	}
+	
+	for (size_t i = 0; i < objectTable.size(); i++)
+		if (LoadObject(objectTable[i], (i < counts.coreObjects) ? &gLevel->coreDrawArena : &gLevel->objectDrawArena))
+			return true;
+	
+	//Read our players (keeping what they've loaded and who they follow)
+	for (PLAYER *player : gLevel->playerList)
+	{
+		const void *record = Read(sizeof(PLAYER));
+		if (record == nullptr)
+			return true;
+		
+		const char *playerFail = player->fail;
+		TEXTURE *texture = player->texture;
+		MAPPINGS *mappings = player->mappings;
+		PLAYER *follow = player->follow;
+		memcpy((void*)player, record, sizeof(PLAYER));
+		player->fail = playerFail;
+		player->texture = texture;
+		player->mappings = mappings;
+		player->follow = follow;
+		
+		SAVESTATE_PLAYERREFS refs;
+		if (Read(refs))
+			return true;
+		player->interact = RefObject(refs.interact);
+		player->spindashDust = RefObject(refs.spindashDust);
+		player->skidDust = RefObject(refs.skidDust);
+		player->barrierObject = RefObject(refs.barrierObject);
+		for (int i = 0; i < INVINCIBILITYSTARS; i++)
+			player->invincibilityStarObject[i] = RefObject(refs.invincibilityStarObject[i]);
+	}
+	
+	//Read our object loads and spawn queue
+	for (size_t i = 0; i < counts.objectLoads; i++)
+	{
+		const void *record = Read(sizeof(OBJECT_LOAD));
+		SAVESTATE_OBJECTLOADREFS refs;
+		if (record == nullptr || Read(refs))
+			return true;
+		
+		OBJECT_LOAD *objectLoad = gLevel->NewObjectLoad();
+		memcpy(objectLoad, record, sizeof(OBJECT_LOAD));
+		objectLoad->function = RefFunction<OBJECTFUNCTION>(refs.function);
+		objectLoad->loaded = RefObject(refs.loaded);
+		gLevel->objectLoadList.link_back(objectLoad);
+	}
+	
+	for (size_t i = 0; i < counts.spawnQueue; i++)
+	{
+		uint32_t index;
+		if (Read(index))
+			return true;
+		if (index < gLevel->objectLoadList.size())
+			gLevel->spawnQueue.link_back(gLevel->objectLoadList[index]);
+	}
+	return false;
+}
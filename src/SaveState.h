@@ -0,0 +1,88 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <unordered_map>
+
+#include "Array.h"
+#include "Arena.h"
+#include "Render.h"
+#include "Mappings.h"
+
+class OBJECT;
+
+//Savestate constants
+#define SAVESTATE_VERSION			4		//Increment whenever what's saved changes
+#define SAVESTATE_MAGIC				0x54535343	//"CSST"
+#define SAVESTATE_ALIGN				8		//Every record in a snapshot starts at a multiple of this
+#define SAVESTATE_DEFAULT_CAPACITY	0x40000	//Bytes preallocated for a snapshot, grown if a level ever needs more
+
+//Savestate class (a pointer-free, versioned snapshot of the current level's mutable simulation state)
+//Objects, players, and object loads reference each other by index, assets by their index in the level's caches, and functions by their offset in the executable,
+//so a snapshot can only be loaded into the same level, with the same players, of the same build it was saved from
+class SAVESTATE
+{
+	public:
+		//Failure (of the last save or load)
+		const char *fail = nullptr;
+		
+		//Snapshot data
+		uint8_t *data = nullptr;
+		size_t size = 0;
+		size_t capacity = 0;
+	
+	private:
+		//Read position
+		size_t readPos = 0;
+		
+		//Reference tables (kept between saves, so they're only allocated once)
+		std::unordered_map<const void*, uint32_t> objectRef;
+		ARRAY<OBJECT*> objectTable;
+		ARRAY<TEXTURE*> textureTable;
+		ARRAY<MAPPINGS*> mappingsTable;
+		std::unordered_map<const TEXTURE*, uint32_t> textureIndex;
+		std::unordered_map<const MAPPINGS*, uint32_t> mappingsIndex;
+	
+	public:
+		SAVESTATE(size_t setCapacity = SAVESTATE_DEFAULT_CAPACITY);
+		~SAVESTATE();
+		
+		//Save the current level's state into our snapshot, returns true on failure
+		bool Save();
+		
+		//Restore the current level's state from our snapshot (before the level's next update), returns true on failure
+		//If the snapshot's contents are corrupt the level may be left partially restored, and should be treated as failed
+		bool Load();
+		
+		//Make room for a snapshot of the given size to be copied into our data (for loading snapshots kept elsewhere), returns true on failure
+		bool SetSize(size_t setSize);
+	
+	private:
+		//Data functions
+		bool Reserve(size_t bytes);
+		void *Write(const void *from, size_t bytes);
+		const void *Read(size_t bytes);
+		
+		template <typename T> inline bool Write(const T &value) { return Write(&value, sizeof(T)) == nullptr; }
+		template <typename T> inline bool Read(T &value)
+		{
+			const void *from = Read(sizeof(T));
+			if (from == nullptr)
+				return true;
+			memcpy((void*)&value, from, sizeof(T));
+			return false;
+		}
+		
+		//Reference functions
+		void BuildAssetTables();
+		uint32_t TextureRef(TEXTURE *texture);
+		uint32_t MappingsRef(MAPPINGS *mappings);
+		uint32_t Ref(const void *pointer);
+		OBJECT *RefObject(uint32_t ref);
+		void *RefPointer(uint32_t ref);
+		
+		//State functions
+		bool SaveObject(OBJECT *object);
+		bool LoadObject(OBJECT *object, ARENA *drawArena);
+		void DiscardObjects();
+};
@@ -14,10 +14,10 @@
 TITLECARD::TITLECARD(std::string levelName, std::string levelSubtitle) : name(levelName), subtitle(levelSubtitle)
 {
 	//Load title card sheet
-	texture = gLevel->GetObjectTexture("data/TitleCard.bmp");
+	texture = gLevel->GetObjectTexture(TEXTUREID_TITLECARD);
 	
 	//Load font texture and font mappings
-	TEXTURE *fontTexture = gLevel->GetObjectTexture("data/GenericFont.bmp");
+	TEXTURE *fontTexture = gLevel->GetObjectTexture(TEXTUREID_GENERICFONT);
 	nameFont = new BITMAPFONT(fontTexture, 0, 0, 16, 16, 0, 0, 0x20, 0x20);
 	subtitleFont = new BITMAPFONT(fontTexture, 0, 83, 8, 11, 0, 0, 0x20, 0x20);
 	